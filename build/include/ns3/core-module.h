@@ -4,7 +4,6 @@
 #ifndef NS3_MODULE_CORE
     // Module headers: 
     #include <ns3/int64x64-128.h>
-    #include <ns3/example-as-test.h>
     #include <ns3/csv-reader.h>
     #include <ns3/event-garbage-collector.h>
     #include <ns3/random-variable-stream-helper.h>
@@ -26,12 +25,14 @@
     #include <ns3/config.h>
     #include <ns3/default-deleter.h>
     #include <ns3/default-simulator-impl.h>
+    #include <ns3/multithreaded-simulator-impl.h>
     #include <ns3/deprecated.h>
     #include <ns3/des-metrics.h>
     #include <ns3/double.h>
     #include <ns3/enum.h>
     #include <ns3/event-id.h>
     #include <ns3/event-impl.h>
+    #include <ns3/event-profiler.h>
     #include <ns3/fatal-error.h>
     #include <ns3/fatal-impl.h>
     #include <ns3/fd-reader.h>
@@ -42,6 +43,7 @@
     #include <ns3/hash-murmur3.h>
     #include <ns3/hash.h>
     #include <ns3/heap-scheduler.h>
+    #include <ns3/quad-heap-scheduler.h>
     #include <ns3/int-to-type.h>
     #include <ns3/int64x64-double.h>
     #include <ns3/int64x64.h>
@@ -53,6 +55,7 @@
     #include <ns3/log.h>
     #include <ns3/make-event.h>
     #include <ns3/map-scheduler.h>
+    #include <ns3/mpsc-queue.h>
     #include <ns3/math.h>
     #include <ns3/names.h>
     #include <ns3/node-printer.h>
@@ -74,6 +77,7 @@
     #include <ns3/show-progress.h>
     #include <ns3/simple-ref-count.h>
     #include <ns3/simulation-singleton.h>
+    #include <ns3/simulator-context.h>
     #include <ns3/simulator-impl.h>
     #include <ns3/simulator.h>
     #include <ns3/singleton.h>
@@ -100,6 +104,7 @@
     #include <ns3/vector.h>
     #include <ns3/warnings.h>
     #include <ns3/watchdog.h>
+    #include <ns3/restartable-timer.h>
     #include <ns3/realtime-simulator-impl.h>
     #include <ns3/wall-clock-synchronizer.h>
     #include <ns3/val-array.h>
@@ -19,6 +19,7 @@
     #include <ns3/neighbor-cache-helper.h>
     #include <ns3/rip-helper.h>
     #include <ns3/ripng-helper.h>
+    #include <ns3/tcp-delayed-ack-stats-helper.h>
     #include <ns3/arp-cache.h>
     #include <ns3/arp-header.h>
     #include <ns3/arp-l3-protocol.h>
@@ -88,6 +89,7 @@
     #include <ns3/tcp-cerl.h>
     #include <ns3/tcp-congestion-ops.h>
     #include <ns3/tcp-cubic.h>
+    #include <ns3/tcp-delayed-ack-ops.h>
     #include <ns3/tcp-dctcp.h>
     #include <ns3/tcp-header.h>
     #include <ns3/tcp-highspeed.h>
@@ -98,6 +100,7 @@
     #include <ns3/tcp-ledbat.h>
     #include <ns3/tcp-linux-reno.h>
     #include <ns3/tcp-lp.h>
+    #include <ns3/tcp-option-cwnd-permitted.h>
     #include <ns3/tcp-option-cwnd.h>
     #include <ns3/tcp-option-rfc793.h>
     #include <ns3/tcp-option-sack-permitted.h>
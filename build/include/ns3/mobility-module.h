@@ -20,6 +20,7 @@
     #include <ns3/random-walk-2d-mobility-model.h>
     #include <ns3/random-waypoint-mobility-model.h>
     #include <ns3/rectangle.h>
+    #include <ns3/spatial-grid-index.h>
     #include <ns3/steady-state-random-waypoint-mobility-model.h>
     #include <ns3/waypoint-mobility-model.h>
     #include <ns3/waypoint.h>
@@ -3,6 +3,7 @@
 #endif 
 #ifndef NS3_MODULE_PROPAGATION
     // Module headers: 
+    #include <ns3/cached-propagation-loss-model.h>
     #include <ns3/channel-condition-model.h>
     #include <ns3/cost231-propagation-loss-model.h>
     #include <ns3/itu-r-1411-los-propagation-loss-model.h>
@@ -8,6 +8,7 @@
     #include <ns3/gnuplot-helper.h>
     #include <ns3/average.h>
     #include <ns3/basic-data-calculators.h>
+    #include <ns3/binary-trace-writer.h>
     #include <ns3/boolean-probe.h>
     #include <ns3/data-calculator.h>
     #include <ns3/data-collection-object.h>
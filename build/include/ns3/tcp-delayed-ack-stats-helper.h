@@ -0,0 +1 @@
+#include "/root/repo/src/internet/helper/tcp-delayed-ack-stats-helper.h"
@@ -11,6 +11,7 @@
     #include <ns3/yans-wifi-helper.h>
     #include <ns3/adhoc-wifi-mac.h>
     #include <ns3/ampdu-subframe-header.h>
+    #include <ns3/ampdu-membership-tag.h>
     #include <ns3/ampdu-tag.h>
     #include <ns3/amsdu-subframe-header.h>
     #include <ns3/ap-wifi-mac.h>
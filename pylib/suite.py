@@ -8,6 +8,7 @@ import pandas as pd
 import numpy as np
 
 from .configuration import Suite, SuiteConfig, Case, DetailedStats
+from .trace import read_trace
 
 
 def get_path_params(suite: Suite, seed: int):
@@ -24,23 +25,24 @@ def get_path_params(suite: Suite, seed: int):
 
 
 async def get_case_detailed_stats(suite: Suite, seed: int):
-    path = f'./results/topology.cwnd.{get_path_params(suite, seed)}'
+    path = f'./results/topology.cwnd.{get_path_params(suite, seed)}.bin'
 
-    if not (os.path.exists(path) and len(open(path).readlines()) > 1):
+    if not _has_records(path):
         async with sem:
             print(suite)
             proc = await asyncio.create_subprocess_shell(f'./ns3 run "scratch/real-example/topology {_params_to_command_args({**suite.dump_params(), "rngSeed": seed})}"')
             await proc.wait()
 
-    if not (os.path.exists(path) and len(open(path).readlines()) > 1):
+    if not _has_records(path):
         return None
-    
-    lines = open(path, 'r').readlines()
 
-    def model_from_args(model, args):
-        return model(**{field: arg for field, arg in zip(model.model_fields, args)})
+    records = read_trace(path)
 
-    return list(map(lambda line: model_from_args(DetailedStats, line.split()), lines))
+    return [DetailedStats(**{field: record[field].item() for field in DetailedStats.model_fields}) for record in records]
+
+
+def _has_records(path: str):
+    return os.path.exists(path) and len(read_trace(path, mmap=True)) > 0
 
 
 sem = asyncio.Semaphore(30)
@@ -96,3 +98,21 @@ async def collect_throughput_dack(suite_configs: list[SuiteConfig], cases: list[
 
 def _params_to_command_args(params: dict):
     return ' '.join([f'--{k}={v}' for k, v in params.items()])
+
+
+def _sweep_value(value) -> str:
+    return str(int(value)) if isinstance(value, bool) else str(value)
+
+
+async def run_sweep(params: dict, grid: dict[str, list], jobs: int, output: str = 'results/sweep.tsv') -> pd.DataFrame:
+    """Run a sweep grid (e.g. {'tcpNodes': [1, 2], 'rngSeed': [1, 2, 3]}) in one topology process with forked workers"""
+    sweep_args = {f'sweep{name[0].upper()}{name[1:]}': ','.join(map(_sweep_value, values)) for name, values in grid.items()}
+    args = _params_to_command_args({**params, **sweep_args, 'sweep': 1, 'jobs': jobs, 'sweepOutput': output})
+    proc = await asyncio.create_subprocess_shell(f'./ns3 run "scratch/real-example/topology {args}"')
+    await proc.wait()
+
+    return read_sweep(output)
+
+
+def read_sweep(path: str = 'results/sweep.tsv') -> pd.DataFrame:
+    return pd.read_csv(path, sep='\t')
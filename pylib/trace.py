@@ -0,0 +1,62 @@
+import os
+import struct
+
+import numpy as np
+import pandas as pd
+
+
+# Reader of the files written by ns3::BinaryTraceWriter (src/stats/model/binary-trace-writer.h)
+
+_MAGIC = b'NS3TRACE'
+_VERSION = 1
+_COLUMN_DESCRIPTOR_SIZE = 32
+_TYPES = {
+    0: '<u1',  # U8
+    1: '<u4',  # U32
+    2: '<u8',  # U64
+    3: '<i4',  # I32
+    4: '<i8',  # I64
+    5: '<f8',  # DOUBLE
+}
+
+
+def read_trace_header(path: str) -> tuple[np.dtype, int]:
+    """Return the dtype of the records and the offset of the first one"""
+    with open(path, 'rb') as f:
+        header = f.read(24)
+        if len(header) < 24 or header[:8] != _MAGIC:
+            raise ValueError(f'{path} is not a binary trace')
+
+        version, n_columns, record_size, header_size = struct.unpack('<4I', header[8:])
+        if version != _VERSION:
+            raise ValueError(f'{path}: unsupported trace version {version}')
+
+        descriptors = f.read(n_columns * _COLUMN_DESCRIPTOR_SIZE)
+
+    names, formats = [], []
+    for i in range(n_columns):
+        descriptor = descriptors[i * _COLUMN_DESCRIPTOR_SIZE:(i + 1) * _COLUMN_DESCRIPTOR_SIZE]
+        formats.append(_TYPES[descriptor[0]])
+        names.append(descriptor[1:].split(b'\0', 1)[0].decode())
+
+    dtype = np.dtype({'names': names, 'formats': formats})
+    assert dtype.itemsize == record_size
+
+    return dtype, header_size
+
+
+def read_trace(path: str, mmap: bool = False) -> np.ndarray:
+    """Read the records of a binary trace as a structured array, memory mapped if requested"""
+    dtype, header_size = read_trace_header(path)
+    n_records = (os.path.getsize(path) - header_size) // dtype.itemsize
+
+    if mmap:
+        if n_records == 0:
+            return np.empty(0, dtype=dtype)
+        return np.memmap(path, dtype=dtype, mode='r', offset=header_size, shape=(n_records,))
+
+    return np.fromfile(path, dtype=dtype, count=n_records, offset=header_size)
+
+
+def read_trace_dataframe(path: str) -> pd.DataFrame:
+    return pd.DataFrame(read_trace(path))
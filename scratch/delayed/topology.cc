@@ -26,6 +26,7 @@
 #include "ns3/tcp-l4-protocol.h"
 #include "ns3/tcp-option-ts.h"
 #include "ns3/tcp-option-cwnd.h"
+#include "ns3/tcp-delayed-ack-ops.h"
 #include "ns3/flow-monitor-helper.h"
 
 NS_LOG_COMPONENT_DEFINE("wifi-tcp");
@@ -69,8 +70,8 @@ RxOther(Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet>
     *stream->GetStream() << Simulator::Now().GetSeconds() 
         << ' ' << delay 
         << ' ' << lastDelay 
-        << ' ' << sock->m_iat * 1000
-        << ' ' << (header.GetOption(TcpOption::CWND)->GetObject<TcpOptionCwnd>())->GetCongestionWindow() / sock->GetSegSize() 
+        << ' ' << DynamicCast<TcpDelayedAckIatOps>(sock->GetDelayedAckAlgorithm())->GetIat() * 1000
+        << ' ' << (header.HasOption(TcpOption::CWND) ? (header.GetOption(TcpOption::CWND)->GetObject<TcpOptionCwnd>())->GetCongestionWindow() : -1) 
         << ' ' << std::endl;
 }
 
@@ -126,7 +127,8 @@ main(int argc, char* argv[])
 
     // Config::SetDefault("ns3::WifiRemoteStationManager::NonUnicastMode", StringValue(phyRate));
     Config::SetDefault("ns3::TcpSocketBase::CongestionWindowOption", BooleanValue(true));
-    Config::SetDefault("ns3::TcpSocketBase::DynamicDelayWindow", BooleanValue(true));
+    Config::SetDefault("ns3::TcpL4Protocol::DelayedAckType",
+                       TypeIdValue(TcpDelayedAckAdw::GetTypeId()));
     // Config::SetDefault("ns3::TcpSocket::DelAckCount", UintegerValue(0));
 
     /* Configure TCP Options */
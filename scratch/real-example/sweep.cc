@@ -0,0 +1,318 @@
+#include "sweep.h"
+
+#include "ns3/abort.h"
+#include "ns3/simulator-context.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <sys/wait.h>
+#include <thread>
+#include <type_traits>
+#include <unistd.h>
+#include <vector>
+
+using namespace ns3;
+
+namespace
+{
+
+/**
+ * Parse a comma separated list of values
+ *
+ * \param name the name of the option, for error messages
+ * \param list the list
+ * \param defaultValue the value returned if the list is empty
+ * \return the values
+ */
+template <typename T>
+std::vector<T>
+ParseList(const std::string& name, const std::string& list, T defaultValue)
+{
+    if (list.empty())
+    {
+        return {defaultValue};
+    }
+
+    std::vector<T> values;
+    std::istringstream items(list);
+    std::string item;
+    while (std::getline(items, item, ','))
+    {
+        if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>)
+        {
+            auto dash = item.find('-', 1);
+            if (dash != std::string::npos)
+            {
+                T first = std::stoull(item.substr(0, dash));
+                T last = std::stoull(item.substr(dash + 1));
+                for (T value = first; value <= last; value++)
+                {
+                    values.push_back(value);
+                }
+                continue;
+            }
+        }
+        std::istringstream is(item);
+        T value;
+        is >> value;
+        NS_ABORT_MSG_IF(is.fail(), "Invalid value \"" << item << "\" in " << name);
+        values.push_back(value);
+    }
+    return values;
+}
+
+/**
+ * Expand the grid into the list of points
+ *
+ * \param base the values of the parameters that are not swept
+ * \param sweep the grid
+ * \return the points
+ */
+std::vector<TopologyParams>
+GetPoints(const TopologyParams& base, const SweepParams& sweep)
+{
+    std::vector<TopologyParams> points;
+    for (auto tcpNodes : ParseList("tcpNodes", sweep.tcpNodes, base.tcpNodes))
+    {
+        for (auto dataRate : ParseList("dataRate", sweep.dataRate, base.dataRate))
+        {
+            for (auto beta : ParseList("beta", sweep.beta, base.beta))
+            {
+                for (auto mobility : ParseList("mobility", sweep.mobility, base.mobility))
+                {
+                    for (auto uplink : ParseList("uplink", sweep.uplink, base.uplink))
+                    {
+                        for (auto rngSeed : ParseList("rngSeed", sweep.rngSeed, base.rngSeed))
+                        {
+                            TopologyParams point = base;
+                            point.tcpNodes = tcpNodes;
+                            point.dataRate = dataRate;
+                            point.beta = beta;
+                            point.mobility = mobility;
+                            point.uplink = uplink;
+                            point.rngSeed = rngSeed;
+                            points.push_back(point);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return points;
+}
+
+/**
+ * Run one point of the grid
+ *
+ * \param index the index of the point
+ * \param point the parameters of the run
+ * \return the row of the output file
+ */
+std::string
+RunPoint(size_t index, const TopologyParams& point)
+{
+    auto throughputs = RunTopology(point);
+    double sum = std::accumulate(throughputs.begin(), throughputs.end(), 0.0);
+
+    std::ostringstream row;
+    row << index << '\t' << GetAlgorithmName(point) << '\t' << point.tcpNodes << '\t'
+        << point.dataRate << '\t' << point.beta << '\t' << point.mobility << '\t' << point.uplink
+        << '\t' << point.rngSeed << '\t' << sum / point.tcpNodes << '\t' << sum << '\n';
+    return row.str();
+}
+
+/**
+ * Read a pipe until the end of file
+ *
+ * \param fd the read end of the pipe
+ * \return the data read
+ */
+std::string
+ReadAll(int fd)
+{
+    std::string data;
+    char buffer[512];
+    ssize_t n;
+    while ((n = read(fd, buffer, sizeof(buffer))) != 0)
+    {
+        if (n < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+        data.append(buffer, n);
+    }
+    return data;
+}
+
+/**
+ * Run every point of the grid in a pool of threads of this process
+ *
+ * \param points the points
+ * \param threads the number of threads
+ * \param output the output file
+ * \return 0
+ */
+int
+RunThreads(const std::vector<TopologyParams>& points, uint32_t threads, std::ofstream& output)
+{
+    for (const auto& point : points)
+    {
+        NS_ABORT_MSG_IF(point.tcpNodes != points[0].tcpNodes ||
+                            point.dataRate != points[0].dataRate ||
+                            point.beta != points[0].beta || point.mobility != points[0].mobility ||
+                            point.uplink != points[0].uplink,
+                        "Only the rng seed can be swept with threads");
+    }
+    ConfigureTopologyDefaults(points[0]);
+
+    std::atomic<size_t> next{0};
+    std::mutex mutex;
+    size_t done = 0;
+
+    auto worker = [&]() {
+        size_t index;
+        while ((index = next++) < points.size())
+        {
+            std::string row = RunPoint(index, points[index]);
+            std::lock_guard<std::mutex> lock(mutex);
+            output << row;
+            output.flush();
+            std::cout << "[" << ++done << "/" << points.size() << "] point " << index << " done"
+                      << std::endl;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (uint32_t i = 0; i < threads && i < points.size(); i++)
+    {
+        pool.emplace_back(worker);
+    }
+    for (auto& thread : pool)
+    {
+        thread.join();
+    }
+    return 0;
+}
+
+} // namespace
+
+void
+AddSweepOptions(CommandLine& cmd, SweepParams& sweep)
+{
+    cmd.AddValue("sweep", "Run a parameter sweep instead of a single run", sweep.enabled);
+    cmd.AddValue("sweepTcpNodes", "Sweep: list of numbers of TCP nodes", sweep.tcpNodes);
+    cmd.AddValue("sweepDataRate", "Sweep: list of application data rates", sweep.dataRate);
+    cmd.AddValue("sweepBeta", "Sweep: list of beta parameters", sweep.beta);
+    cmd.AddValue("sweepMobility", "Sweep: list of mobility settings", sweep.mobility);
+    cmd.AddValue("sweepUplink", "Sweep: list of uplink settings", sweep.uplink);
+    cmd.AddValue("sweepRngSeed", "Sweep: list of rng seeds", sweep.rngSeed);
+    cmd.AddValue("jobs", "Sweep: number of worker processes", sweep.jobs);
+    cmd.AddValue("threads", "Sweep: number of worker threads, instead of processes", sweep.threads);
+    cmd.AddValue("sweepOutput", "Sweep: output file", sweep.output);
+}
+
+int
+RunSweep(const TopologyParams& base, const SweepParams& sweep)
+{
+    NS_ABORT_MSG_IF(sweep.jobs == 0, "At least one worker is needed");
+    if (sweep.threads > 0)
+    {
+        // before any simulator or packet is created by this process
+        SimulatorContext::EnableThreadLocal();
+    }
+
+    auto points = GetPoints(base, sweep);
+
+    std::ofstream output(sweep.output);
+    NS_ABORT_MSG_UNLESS(output, "Cannot open " << sweep.output);
+    output << "point\talgorithm\ttcpNodes\tdataRate\tbeta\tmobility\tuplink\trngSeed\tthroughput"
+              "\ttotalThroughput\n";
+    output.flush();
+
+    if (sweep.threads > 0)
+    {
+        return RunThreads(points, sweep.threads, output);
+    }
+
+    struct Worker
+    {
+        size_t point; //!< Index of the point run by the worker
+        int fd;       //!< Read end of the pipe the worker writes its row to
+    };
+
+    std::map<pid_t, Worker> workers;
+    size_t next = 0;
+    size_t done = 0;
+    size_t failed = 0;
+
+    while (next < points.size() || !workers.empty())
+    {
+        while (next < points.size() && workers.size() < sweep.jobs)
+        {
+            int fds[2];
+            NS_ABORT_MSG_IF(pipe(fds) != 0, "pipe() failed: " << std::strerror(errno));
+            // do not let the children inherit buffered output
+            std::cout.flush();
+
+            pid_t pid = fork();
+            NS_ABORT_MSG_IF(pid < 0, "fork() failed: " << std::strerror(errno));
+            if (pid == 0)
+            {
+                close(fds[0]);
+                ConfigureTopologyDefaults(points[next]);
+                std::string row = RunPoint(next, points[next]);
+                bool written = write(fds[1], row.data(), row.size()) ==
+                               static_cast<ssize_t>(row.size());
+                std::cout.flush();
+                _exit(written ? 0 : 1);
+            }
+            close(fds[1]);
+            workers[pid] = {next, fds[0]};
+            next++;
+        }
+
+        int status;
+        pid_t pid = waitpid(-1, &status, 0);
+        if (pid < 0)
+        {
+            NS_ABORT_MSG_IF(errno != EINTR, "waitpid() failed: " << std::strerror(errno));
+            continue;
+        }
+        auto it = workers.find(pid);
+        if (it == workers.end())
+        {
+            continue;
+        }
+
+        std::string row = ReadAll(it->second.fd);
+        close(it->second.fd);
+        done++;
+        if (WIFEXITED(status) && WEXITSTATUS(status) == 0 && !row.empty())
+        {
+            output << row;
+            output.flush();
+            std::cout << "[" << done << "/" << points.size() << "] point " << it->second.point
+                      << " done" << std::endl;
+        }
+        else
+        {
+            failed++;
+            std::cerr << "[" << done << "/" << points.size() << "] point " << it->second.point
+                      << " failed" << std::endl;
+        }
+        workers.erase(it);
+    }
+
+    return failed ? 1 : 0;
+}
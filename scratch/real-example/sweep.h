@@ -0,0 +1,55 @@
+#ifndef REAL_EXAMPLE_SWEEP_H
+#define REAL_EXAMPLE_SWEEP_H
+
+#include "topology.h"
+
+#include "ns3/command-line.h"
+
+#include <string>
+
+/**
+ * Grid of a parameter sweep of the topology experiment.
+ *
+ * Every list is comma separated, integer lists also accept ranges
+ * (e.g. "1-10"). An empty list keeps the value of the single-run option.
+ */
+struct SweepParams
+{
+    bool enabled = false;                        /* Run the sweep instead of a single run */
+    std::string tcpNodes;                        /* List of numbers of TCP nodes */
+    std::string dataRate;                        /* List of application data rates */
+    std::string beta;                            /* List of TCP-AAD beta parameters */
+    std::string mobility;                        /* List of mobility settings */
+    std::string uplink;                          /* List of uplink settings */
+    std::string rngSeed;                         /* List of rng seeds */
+    uint32_t jobs = 1;                           /* Number of worker processes */
+    uint32_t threads = 0;                        /* Number of worker threads, 0 to fork */
+    std::string output = "results/sweep.tsv";    /* Output file, one row per point */
+};
+
+/**
+ * Register the command line options of the sweep
+ *
+ * \param cmd the command line
+ * \param sweep the parameters set by the options
+ */
+void AddSweepOptions(ns3::CommandLine& cmd, SweepParams& sweep);
+
+/**
+ * Run every point of the grid in a pool of forked workers.
+ *
+ * The workers are forked from this process, after the ns-3 libraries have
+ * been loaded and the TypeIds registered, and each of them runs one point.
+ * The results are appended to the output file as soon as a point finishes.
+ *
+ * With threads, the points run in worker threads of this process instead,
+ * each with its own simulator (see ns3::SimulatorContext). Since the
+ * attribute defaults are shared, only the rng seed may be swept then.
+ *
+ * \param base the values of the parameters that are not swept
+ * \param sweep the grid
+ * \return 0 if all the points succeeded, 1 otherwise
+ */
+int RunSweep(const TopologyParams& base, const SweepParams& sweep);
+
+#endif /* REAL_EXAMPLE_SWEEP_H */
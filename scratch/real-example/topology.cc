@@ -18,6 +18,8 @@
 #include "ns3/tcp-option-ts.h"
 #include "ns3/tcp-option-cwnd.h"
 #include "ns3/tcp-socket-base.h"
+#include "ns3/tcp-delayed-ack-ops.h"
+#include "ns3/tcp-delayed-ack-stats-helper.h"
 #include "ns3/wifi-net-device.h"
 #include "ns3/wifi-mac.h"
 #include "ns3/amsdu-subframe-header.h"
@@ -27,7 +29,13 @@
 #include "ns3/yans-wifi-helper.h"
 #include "ns3/drop-tail-queue.h"
 #include "ns3/ptr.h"
-#include "ns3/mpdu-aggregator.h"
+#include "ns3/ampdu-membership-tag.h"
+#include "ns3/binary-trace-writer.h"
+
+#include "sweep.h"
+#include "topology.h"
+
+#include <fstream>
 
 NS_LOG_COMPONENT_DEFINE("real-example");
 
@@ -46,118 +54,115 @@ CalculateThroughput(Ptr<OutputStreamWrapper> stream, size_t index, Ptr<PacketSin
 }
 
 void
-RxOther(Ptr<OutputStreamWrapper> stream, std::string context, Ptr<const Packet> pckt, const TcpHeader& header, Ptr<const TcpSocketBase> sock)
+RxOther(Ptr<BinaryTraceWriter> trace, std::string context, Ptr<const Packet> pckt, const TcpHeader& header, Ptr<const TcpSocketBase> sock)
 {
-    static uint64_t lastAggr = 0;
-    static int aggrSeq = 0;
-    
     if (!header.HasOption(TcpOption::TS)) return;
-    if (!___aggregations.count(pckt->GetUid())) 
-    {
-        lastAggr = 0;
-    }
+
+    AmpduMembershipTag ampduTag; // left to zero if the packet was not aggregated
+    pckt->PeekPacketTag(ampduTag);
+
+    auto delAck = sock->GetDelayedAckAlgorithm();
+    auto iatOps = DynamicCast<TcpDelayedAckIatOps>(delAck);
+    auto adw = DynamicCast<TcpDelayedAckAdw>(delAck);
 
     auto delay = (Simulator::Now() - MilliSeconds((header.GetOption(TcpOption::TS)->GetObject<TcpOptionTS>())->GetTimestamp())).GetMilliSeconds();
-    *stream->GetStream() << Simulator::Now().GetSeconds() 
-        << ' ' << delay // Travel time of packet
-        << ' ' << sock->m_iat * 1000 // IAT (ms)
-        << ' ' << sock->m_baseIat * 1000 // Min Iat (ms)
-        << ' ' << sock->GetTimeRatio() // theta for delayed window algo
-        << ' ' << sock->GetDelayTimeout().GetSeconds() // timeout before firing ack (s)
-        << ' ' << lastAggr // ID of last aggregation packet head
-        << ' ' << aggrSeq // index of packet in aggregation
-        << ' ' << sock->m_delAckCount  // number of currently delayed acks
-        << ' ' << sock->DelayWindow()  // maximum delay window
-        << ' ' << (header.GetOption(TcpOption::CWND) ? (header.GetOption(TcpOption::CWND)->GetObject<TcpOptionCwnd>())->GetCongestionWindow() / sock->GetSegSize() : -1) // cwnd from sender
-        << ' ' << std::endl;
-
-    if (___aggregations[pckt->GetUid()] != lastAggr)
-    {
-        lastAggr = ___aggregations[pckt->GetUid()];
-        aggrSeq = 0;
-    } else
-    {
-        aggrSeq++;
-    }
-    
+    auto cwndOption = header.GetOption(TcpOption::CWND);
+
+    // columns declared in CreateRxTrace
+    trace->WriteDouble(Simulator::Now().GetSeconds());
+    trace->WriteI64(delay); // Travel time of packet
+    trace->WriteDouble(iatOps ? iatOps->GetIat() * 1000 : 0); // IAT (ms)
+    trace->WriteDouble(iatOps ? iatOps->GetBaseIat() * 1000 : 0); // Min Iat (ms)
+    trace->WriteDouble(adw ? adw->GetTimeRatio() : 0); // theta for delayed window algo
+    trace->WriteDouble(sock->GetDelayTimeout().GetSeconds()); // timeout before firing ack (s)
+    trace->WriteU64(ampduTag.GetAmpduId()); // ID of aggregation packet head
+    trace->WriteU32(ampduTag.GetPosition()); // index of packet in aggregation
+    trace->WriteU32(sock->m_delAckCount); // number of currently delayed acks
+    trace->WriteU32(sock->DelayWindow()); // maximum delay window
+    trace->WriteI64(cwndOption ? static_cast<int64_t>((cwndOption->GetObject<TcpOptionCwnd>())->GetCongestionWindow()) : -1); // cwnd from sender (scaled segments), only sent on changes
 }
 
-
-int
-main(int argc, char* argv[])
+/**
+ * Create the binary trace written by RxOther
+ */
+Ptr<BinaryTraceWriter>
+CreateRxTrace(const std::string& fileName)
 {
-    // LogComponentEnable("TcpCerl", LOG_ALL);
-    // LogComponentEnable("TcpCerl", LOG_PREFIX_ALL);
-    // LogComponentEnable("TcpSocketBase", LOG_ALL);
-    // LogComponentEnable("TcpSocketBase", LOG_PREFIX_ALL);
-    // LogComponentEnable("TcpRecoveryOps", LOG_ALL);
-    // LogComponentEnable("TcpRecoveryOps", LOG_PREFIX_ALL);
+    Ptr<BinaryTraceWriter> trace = CreateObject<BinaryTraceWriter>();
+    trace->AddColumn("ts", BinaryTraceWriter::DOUBLE);
+    trace->AddColumn("delay", BinaryTraceWriter::I64);
+    trace->AddColumn("iat", BinaryTraceWriter::DOUBLE);
+    trace->AddColumn("base_iat", BinaryTraceWriter::DOUBLE);
+    trace->AddColumn("theta", BinaryTraceWriter::DOUBLE);
+    trace->AddColumn("current_timeout", BinaryTraceWriter::DOUBLE);
+    trace->AddColumn("aggregation_id", BinaryTraceWriter::U64);
+    trace->AddColumn("aggregation_position", BinaryTraceWriter::U32);
+    trace->AddColumn("delayed_ack", BinaryTraceWriter::U32);
+    trace->AddColumn("delay_window", BinaryTraceWriter::U32);
+    trace->AddColumn("sender_cwnd", BinaryTraceWriter::I64);
+    trace->Open(fileName);
+    return trace;
+}
 
 
-    uint32_t payloadSize = 1472;                        /* Transport layer payload size in bytes. */
-    size_t dataRate = 26;                               /* Application layer datarate. */
-    size_t udpDataRate = 10;                            /* Data rate on the UDP nodes */
-    std::string tcpVariant{"TcpLinuxReno"};             /* TCP variant type. */
-    size_t tcpNodes = 1;                                /* Number of TCP nodes */
-    size_t udpNodes = 0;                                /* Number of udp nodes. */
-    std::string phyRate = "HtMcs7";                     /* Physical layer bitrate. */
-    double simulationTime = 10;                         /* Simulation time in seconds. */
-    double distanceToAP = 10.0;                         /* Distance to AP station from STA node. */
-    bool uplink = true;                                 /* Determine the location of server */
-    double errorRate = 0;                               /* Error rate on wired link */
-    bool tcpAdw = false;                                /* Use TCP-ADW */
-    bool tcpAad = false;                                /* Use TCP-AAD */
-    bool cwndEnabled = false;                           /* Send CWND as an option */
-    bool fortyHz = false;                               /* Set channel width to 40 mhz */
-    bool mobility = false;                              /* Whether station are static or moving */
-    size_t lLost = 0;                                   /* Amount of Mbps lost on link from G1 to G2 */
-    size_t ampdu = 65535;                               /* A-MPDU aggregation size */
-    size_t amsdu = 0;                                   /* A-MSDU aggregation size */
-    double alpha = 0.75;                                /* alpha parameter (TCP-ADW, TCP-AAD) */
-    double beta = 1.5;                                  /* beta parameter (TCP-AAD) */
-    double lambda = 1.5;                                /* lamda parameter (TCP-ADW) */
-    size_t rngSeed = 1;                                 /* rng seed to use in simulation */
-    size_t tx = 16;                                     /* transmission power of stations */
-    
-    /* Command line argument parser setup. */
-    CommandLine cmd(__FILE__);
-    cmd.AddValue("payloadSize", "Payload size in bytes", payloadSize);
-    cmd.AddValue("dataRate", "Application data rate", dataRate);
+void
+AddTopologyOptions(CommandLine& cmd, TopologyParams& params)
+{
+    cmd.AddValue("payloadSize", "Payload size in bytes", params.payloadSize);
+    cmd.AddValue("dataRate", "Application data rate", params.dataRate);
     cmd.AddValue("tcpVariant",
                  "Transport protocol to use: TcpNewReno, "
                  "TcpHybla, TcpHighSpeed, TcpHtcp, TcpVegas, TcpScalable, TcpVeno, "
                  "TcpBic, TcpYeah, TcpIllinois, TcpWestwood, TcpWestwoodPlus, TcpLedbat ",
-                tcpVariant);
-    cmd.AddValue("tcpNodes", "Number of nodes", tcpNodes);
-    cmd.AddValue("udpNodes", "Number of udp nodes", udpNodes);
-    cmd.AddValue("distance", "Distance to AP", distanceToAP);
-    cmd.AddValue("phyRate", "Physical layer bitrate", phyRate);
-    cmd.AddValue("simulationTime", "Simulation time in seconds", simulationTime);
-    cmd.AddValue("errorRate", "Error rate on wired link", errorRate);
-    cmd.AddValue("uplink", "Uplink", uplink);
-    cmd.AddValue("lLost", "Lost mbps on L", lLost);
-    cmd.AddValue("Ampdu", "Ampdu size", ampdu);
-    cmd.AddValue("Amsdu", "Amsdu size", amsdu);
-    cmd.AddValue("tcpAdw", "Use tcpAdw", tcpAdw);
-    cmd.AddValue("tcpAad", "Dynamic timeout", tcpAad);
-    cmd.AddValue("cwndEnabled", "Enable cwnd option", cwndEnabled);
-    cmd.AddValue("alpha", "Alpha from TCP-AAD and TCP-ADW", alpha);
-    cmd.AddValue("beta", "Beta from TCP-AAD", beta);
-    cmd.AddValue("lambda", "Lambda from TCP-ADW", lambda);
-    cmd.AddValue("rngSeed", "rng seed", rngSeed);
-    cmd.AddValue("fortyHz", "Whether to use 40Hz", fortyHz);
-    cmd.AddValue("udpDataRate", "udpDataRate", udpDataRate);
-    cmd.AddValue("mobility", "Whether to use mobility of just static positions", mobility);
-    cmd.AddValue("tx", "Tx on wireless nodes", tx);
-    
-    cmd.Parse(argc, argv);
-
-    RngSeedManager::SetSeed(rngSeed);
+                params.tcpVariant);
+    cmd.AddValue("tcpNodes", "Number of nodes", params.tcpNodes);
+    cmd.AddValue("udpNodes", "Number of udp nodes", params.udpNodes);
+    cmd.AddValue("distance", "Distance to AP", params.distanceToAP);
+    cmd.AddValue("phyRate", "Physical layer bitrate", params.phyRate);
+    cmd.AddValue("simulationTime", "Simulation time in seconds", params.simulationTime);
+    cmd.AddValue("errorRate", "Error rate on wired link", params.errorRate);
+    cmd.AddValue("uplink", "Uplink", params.uplink);
+    cmd.AddValue("lLost", "Lost mbps on L", params.lLost);
+    cmd.AddValue("Ampdu", "Ampdu size", params.ampdu);
+    cmd.AddValue("Amsdu", "Amsdu size", params.amsdu);
+    cmd.AddValue("tcpAdw", "Use tcpAdw", params.tcpAdw);
+    cmd.AddValue("tcpAad", "Dynamic timeout", params.tcpAad);
+    cmd.AddValue("tcpAggEnd", "ACK on the end of the A-MPDUs signalled by the MAC", params.tcpAggEnd);
+    cmd.AddValue("cwndEnabled", "Enable cwnd option", params.cwndEnabled);
+    cmd.AddValue("rxTrace", "Write the per-segment trace of the receiver", params.rxTrace);
+    cmd.AddValue("alpha", "Alpha from TCP-AAD and TCP-ADW", params.alpha);
+    cmd.AddValue("beta", "Beta from TCP-AAD", params.beta);
+    cmd.AddValue("lambda", "Lambda from TCP-ADW", params.lambda);
+    cmd.AddValue("rngSeed", "rng seed", params.rngSeed);
+    cmd.AddValue("fortyHz", "Whether to use 40Hz", params.fortyHz);
+    cmd.AddValue("udpDataRate", "udpDataRate", params.udpDataRate);
+    cmd.AddValue("mobility", "Whether to use mobility of just static positions", params.mobility);
+    cmd.AddValue("tx", "Tx on wireless nodes", params.tx);
+}
 
-    auto nodes = tcpNodes + udpNodes;
+std::string
+GetAlgorithmName(const TopologyParams& params)
+{
+    if (params.tcpAdw)
+    {
+        return "tcpAdw";
+    }
+    if (params.tcpAad)
+    {
+        return "tcpAad";
+    }
+    if (params.tcpAggEnd)
+    {
+        return "tcpAggEnd";
+    }
+    return "default";
+}
 
+void
+ConfigureTopologyDefaults(const TopologyParams& params)
+{
     /* Set up congestion control scheme */
-    tcpVariant = std::string("ns3::") + tcpVariant;
+    std::string tcpVariant = std::string("ns3::") + params.tcpVariant;
 
     TypeId tcpTid;
     NS_ABORT_MSG_UNLESS(TypeId::LookupByNameFailSafe(tcpVariant, &tcpTid),
@@ -167,25 +172,43 @@ main(int argc, char* argv[])
 
 
     /* Configure TCP Options */
-    if (cwndEnabled)
+    if (params.cwndEnabled)
     {
         Config::SetDefault("ns3::TcpSocketBase::CongestionWindowOption", BooleanValue(true));
     }
 
-    NS_ASSERT(!tcpAdw || !tcpAad);
-    if (tcpAdw)
+    NS_ASSERT(params.tcpAdw + params.tcpAad + params.tcpAggEnd <= 1);
+    if (params.tcpAdw)
+    {
+        NS_ASSERT(params.cwndEnabled);
+        Config::SetDefault("ns3::TcpL4Protocol::DelayedAckType",
+                           TypeIdValue(TcpDelayedAckAdw::GetTypeId()));
+    }
+    if (params.tcpAad)
     {
-        NS_ASSERT(cwndEnabled);
-        Config::SetDefault("ns3::TcpSocketBase::AdaptiveDelayWindow", BooleanValue(true));
+        Config::SetDefault("ns3::TcpL4Protocol::DelayedAckType",
+                           TypeIdValue(TcpDelayedAckAad::GetTypeId()));
     }
-    if (tcpAad)
+    if (params.tcpAggEnd)
     {
-        Config::SetDefault("ns3::TcpSocketBase::AggregationAwareDelay", BooleanValue(true));
+        Config::SetDefault("ns3::TcpL4Protocol::DelayedAckType",
+                           TypeIdValue(TcpDelayedAckAggregateEnd::GetTypeId()));
     }
-    Config::SetDefault("ns3::TcpSocketBase::Alpha", DoubleValue(alpha));
-    Config::SetDefault("ns3::TcpSocketBase::AadBeta", DoubleValue(beta));
-    Config::SetDefault("ns3::TcpSocketBase::AdwLambda", DoubleValue(lambda));
-    Config::SetDefault("ns3::TcpSocket::SegmentSize", UintegerValue(payloadSize));
+    Config::SetDefault("ns3::TcpDelayedAckIatOps::Alpha", DoubleValue(params.alpha));
+    Config::SetDefault("ns3::TcpDelayedAckAad::Beta", DoubleValue(params.beta));
+    Config::SetDefault("ns3::TcpDelayedAckAdw::Lambda", DoubleValue(params.lambda));
+    Config::SetDefault("ns3::TcpSocket::SegmentSize", UintegerValue(params.payloadSize));
+    Config::SetDefault("ns3::TcpSocket::SndBufSize", UintegerValue(1e9));
+    Config::SetDefault("ns3::TcpSocket::RcvBufSize", UintegerValue(1e9));
+}
+
+std::vector<double>
+RunTopology(const TopologyParams& params)
+{
+    RngSeedManager::SetSeed(params.rngSeed);
+
+    auto nodes = params.tcpNodes + params.udpNodes;
+    std::string tcpVariant = std::string("ns3::") + params.tcpVariant;
 
     WifiMacHelper wifiMac;
     WifiHelper wifiHelper;
@@ -200,18 +223,18 @@ main(int argc, char* argv[])
     YansWifiPhyHelper wifiPhy;
     wifiPhy.SetChannel(wifiChannel.Create());
     wifiPhy.SetErrorRateModel("ns3::YansErrorRateModel");
-    wifiPhy.Set("TxPowerStart", DoubleValue(tx));
-    wifiPhy.Set("TxPowerEnd", DoubleValue(tx));
-    if (fortyHz)
+    wifiPhy.Set("TxPowerStart", DoubleValue(params.tx));
+    wifiPhy.Set("TxPowerEnd", DoubleValue(params.tx));
+    if (params.fortyHz)
     {
         wifiPhy.Set("ChannelSettings", StringValue("{0, 40, BAND_5GHZ, 0}"));
     }
 
-    if (!mobility)
+    if (!params.mobility)
     {
         wifiHelper.SetRemoteStationManager("ns3::ConstantRateWifiManager",
                                         "DataMode",
-                                        StringValue(phyRate),
+                                        StringValue(params.phyRate),
                                         "ControlMode",
                                         StringValue("HtMcs0"));
     }
@@ -254,8 +277,6 @@ main(int argc, char* argv[])
 
     pointToPoint.SetDeviceAttribute("DataRate", StringValue("1Gbps"));
     pointToPoint.SetChannelAttribute("Delay", StringValue("1ms"));
-    Config::SetDefault("ns3::TcpSocket::SndBufSize", UintegerValue(1e9));
-    Config::SetDefault("ns3::TcpSocket::RcvBufSize", UintegerValue(1e9));
     // Config::SetDefault("ns3::DropTailQueue<Packet>::MaxSize", QueueSizeValue(QueueSize("30p")));
 
     {
@@ -265,7 +286,7 @@ main(int argc, char* argv[])
     
         NetDeviceContainer g1g2 = pointToPoint.Install(p2pNodesChannel);
         Ptr<RateErrorModel> em = CreateObject<RateErrorModel>();
-        em->SetAttribute("ErrorRate", DoubleValue(errorRate));
+        em->SetAttribute("ErrorRate", DoubleValue(params.errorRate));
         em->SetAttribute("ErrorUnit", StringValue("ERROR_UNIT_PACKET"));
         uselessDevices.Add(g1g2);
         g1g2.Get(1)->SetAttribute("ReceiveErrorModel", PointerValue(em));
@@ -281,8 +302,8 @@ main(int argc, char* argv[])
     /* Set Aggregations sizes */
     Ptr<WifiNetDevice> wifi_dev;
     wifi_dev = DynamicCast<WifiNetDevice>(apDevice.Get(0));
-    wifi_dev->GetMac()->SetAttribute("BE_MaxAmpduSize", UintegerValue(ampdu));
-    wifi_dev->GetMac()->SetAttribute("BE_MaxAmsduSize", UintegerValue(amsdu));
+    wifi_dev->GetMac()->SetAttribute("BE_MaxAmpduSize", UintegerValue(params.ampdu));
+    wifi_dev->GetMac()->SetAttribute("BE_MaxAmsduSize", UintegerValue(params.amsdu));
 
     /* Configure STA */
     wifiMac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid));
@@ -292,8 +313,8 @@ main(int argc, char* argv[])
     for (size_t i = 0; i < nodes; i++)
     {
         wifi_dev = DynamicCast<WifiNetDevice>(staDevices.Get(i));
-        wifi_dev->GetMac()->SetAttribute("BE_MaxAmpduSize", UintegerValue(ampdu));
-        wifi_dev->GetMac()->SetAttribute("BE_MaxAmsduSize", UintegerValue(amsdu));
+        wifi_dev->GetMac()->SetAttribute("BE_MaxAmpduSize", UintegerValue(params.ampdu));
+        wifi_dev->GetMac()->SetAttribute("BE_MaxAmsduSize", UintegerValue(params.amsdu));
     }
 
     /* Mobility model */
@@ -303,11 +324,11 @@ main(int argc, char* argv[])
     for (size_t i = 0; i < nodes; i++) 
     {
         double angle = (M_PI / nodes) * i;
-        positionAlloc->Add(Vector(sin(angle) * distanceToAP, cos(angle) * distanceToAP, 0.0));
+        positionAlloc->Add(Vector(sin(angle) * params.distanceToAP, cos(angle) * params.distanceToAP, 0.0));
     }
 
     mobilityHelper.SetPositionAllocator(positionAlloc);
-    if (mobility)
+    if (params.mobility)
     {
         mobilityHelper.SetMobilityModel("ns3::RandomWalk2dMobilityModel",
                               "Bounds",
@@ -347,33 +368,33 @@ main(int argc, char* argv[])
 
     AsciiTraceHelper asciiTraceHelper;
 
-    auto tcpType = (tcpAdw ? "tcpAdw" : (tcpAad ? "tcpAad" : "default"));
+    auto tcpType = GetAlgorithmName(params);
 
-    auto mainParam = (tcpAad ? beta : lambda);
+    auto mainParam = (params.tcpAad ? params.beta : params.lambda);
 
     std::string tcpAdwString 
         = tcpType + std::to_string((size_t)(mainParam * 100)) 
-        + ".dr-" + std::to_string(dataRate) 
-        + ".rng-" + std::to_string(rngSeed) 
-        + ".tcp-" + std::to_string(tcpNodes) 
-        + ".udp-" + std::to_string(udpNodes)
-        + ".fortyHz-" + std::to_string(fortyHz)
-        + ".mobile-" + std::to_string(mobility)
-        + ".distance-" + std::to_string((size_t) distanceToAP)
-        + ".tx-" + std::to_string(tx)
-        + (uplink ? "" : ".downlink")
+        + ".dr-" + std::to_string(params.dataRate) 
+        + ".rng-" + std::to_string(params.rngSeed) 
+        + ".tcp-" + std::to_string(params.tcpNodes) 
+        + ".udp-" + std::to_string(params.udpNodes)
+        + ".fortyHz-" + std::to_string(params.fortyHz)
+        + ".mobile-" + std::to_string(params.mobility)
+        + ".distance-" + std::to_string((size_t) params.distanceToAP)
+        + ".tx-" + std::to_string(params.tx)
+        + (params.uplink ? "" : ".downlink")
         + (tcpVariant == "ns3::TcpLinuxReno" ? "" : "." + tcpVariant)
         + ".delayed";
 
     Ptr<OutputStreamWrapper> stream = asciiTraceHelper.CreateFileStream("results/topology.throughput." + tcpAdwString);
-    Ptr<OutputStreamWrapper> streamCwnd = asciiTraceHelper.CreateFileStream("results/topology.cwnd." + tcpAdwString);
+    Ptr<BinaryTraceWriter> streamCwnd = CreateRxTrace("results/topology.cwnd." + tcpAdwString + ".bin");
     Ptr<OutputStreamWrapper> aggregatedStream = asciiTraceHelper.CreateFileStream("results/topology-aggregated.throughput." + tcpAdwString);
 
-    Ipv4InterfaceContainer& sinkInterfaces = uplink ? appInterfaces : staInterfaces;
-    NodeContainer& serverNodes = uplink ? staNodes : appNodes;
-    NodeContainer& sinkNodes = uplink ? appNodes : staNodes;
+    Ipv4InterfaceContainer& sinkInterfaces = params.uplink ? appInterfaces : staInterfaces;
+    NodeContainer& serverNodes = params.uplink ? staNodes : appNodes;
+    NodeContainer& sinkNodes = params.uplink ? appNodes : staNodes;
 
-    for (size_t i = 0; i < tcpNodes; i++) 
+    for (size_t i = 0; i < params.tcpNodes; i++) 
     {
         /* Install TCP Receiver on the access point */
         PacketSinkHelper sinkHelper("ns3::TcpSocketFactory",
@@ -382,10 +403,10 @@ main(int argc, char* argv[])
 
          /* Install TCP Transmitter on the station */
         OnOffHelper server("ns3::TcpSocketFactory", (InetSocketAddress(sinkInterfaces.GetAddress(i), 9)));
-        server.SetAttribute("PacketSize", UintegerValue(payloadSize));
+        server.SetAttribute("PacketSize", UintegerValue(params.payloadSize));
         server.SetAttribute("OnTime", StringValue("ns3::ConstantRandomVariable[Constant=1]"));
         server.SetAttribute("OffTime", StringValue("ns3::ConstantRandomVariable[Constant=0]"));
-        server.SetAttribute("DataRate", DataRateValue(DataRate(std::to_string(dataRate) + "Mbps")));
+        server.SetAttribute("DataRate", DataRateValue(DataRate(std::to_string(params.dataRate) + "Mbps")));
         serverApps.Add(server.Install(serverNodes.Get(i)));
         Simulator::Schedule(Seconds(1.1), MakeBoundCallback(&CalculateThroughput, stream, i, StaticCast<PacketSink>(sinkApps.Get(i)), 0));
     }
@@ -394,20 +415,20 @@ main(int argc, char* argv[])
 
 
     ApplicationContainer udpApps; 
-    for (size_t i = 0; i < udpNodes; i++) 
+    for (size_t i = 0; i < params.udpNodes; i++) 
     {
         /* Install TCP Receiver on the access point */
         PacketSinkHelper sinkHelper("ns3::UdpSocketFactory",
                                     InetSocketAddress(Ipv4Address::GetAny(), 9));
-        sinkApps.Add(sinkHelper.Install(sinkNodes.Get(i + tcpNodes)));
+        sinkApps.Add(sinkHelper.Install(sinkNodes.Get(i + params.tcpNodes)));
 
          /* Install TCP Transmitter on the station */
-        OnOffHelper server("ns3::UdpSocketFactory", (InetSocketAddress(sinkInterfaces.GetAddress(i + tcpNodes), 9)));
-        server.SetAttribute("PacketSize", UintegerValue(payloadSize));
+        OnOffHelper server("ns3::UdpSocketFactory", (InetSocketAddress(sinkInterfaces.GetAddress(i + params.tcpNodes), 9)));
+        server.SetAttribute("PacketSize", UintegerValue(params.payloadSize));
         server.SetAttribute("OnTime", StringValue("ns3::ConstantRandomVariable[Constant=1]"));
         server.SetAttribute("OffTime", StringValue("ns3::ConstantRandomVariable[Constant=0]"));
-        server.SetAttribute("DataRate", DataRateValue(DataRate(std::to_string(udpDataRate) + "Mbps")));
-        udpApps.Add(server.Install(serverNodes.Get(i + tcpNodes)));
+        server.SetAttribute("DataRate", DataRateValue(DataRate(std::to_string(params.udpDataRate) + "Mbps")));
+        udpApps.Add(server.Install(serverNodes.Get(i + params.tcpNodes)));
     }
     udpApps.Start(Seconds(0.0));
 
@@ -416,28 +437,69 @@ main(int argc, char* argv[])
     x->SetAttribute ("Max", DoubleValue (1.1));
     serverApps.StartWithJitter(Seconds(0), x);
 
-    auto connect = [nodes, tcpNodes, &staNodes, streamCwnd]() {
+    auto connect = [streamCwnd]() {
         auto recieve_path = "/NodeList/" + std::to_string(2) + "/$ns3::TcpL4Protocol/SocketList/*/Rx";
         Config::Connect(recieve_path, MakeBoundCallback(&RxOther, streamCwnd));
     };
 
 
-    Simulator::Schedule(Seconds(1.1), connect);
+    if (params.rxTrace)
+    {
+        Simulator::Schedule(Seconds(1.1), connect);
+    }
 
     /* Start Simulation */
-    Simulator::Stop(Seconds(simulationTime + 1));
+    Simulator::Stop(Seconds(params.simulationTime + 1));
     Simulator::Run();
+    streamCwnd->Close();
+
+    TcpDelayedAckStatsHelper delAckStats;
+    delAckStats.Add(NodeContainer::GetGlobal());
+    std::ofstream delAckStream("results/topology.delack." + tcpAdwString);
+    delAckStats.PrintSummary(delAckStream);
 
+    std::vector<double> throughputs;
     double sum = 0;
-    for (size_t i = 0; i < tcpNodes; i++) 
+    for (size_t i = 0; i < params.tcpNodes; i++) 
     {
-        double averageThroughput = ((StaticCast<PacketSink>(sinkApps.Get(i))->GetTotalRx() * 8) / (1e6 * simulationTime));
+        double averageThroughput = ((StaticCast<PacketSink>(sinkApps.Get(i))->GetTotalRx() * 8) / (1e6 * params.simulationTime));
+        throughputs.push_back(averageThroughput);
         sum += averageThroughput;
         *aggregatedStream->GetStream() << "average: " << i << '\t' << averageThroughput << '\n';
     }
 
-    *aggregatedStream->GetStream() << "average from all: " << sum / tcpNodes << '\n';
-    std::cout << "average from all: " << sum / tcpNodes << '\n';
+    *aggregatedStream->GetStream() << "average from all: " << sum / params.tcpNodes << '\n';
+    std::cout << "average from all: " << sum / params.tcpNodes << '\n';
     Simulator::Destroy();
+    return throughputs;
+}
+
+
+int
+main(int argc, char* argv[])
+{
+    // LogComponentEnable("TcpCerl", LOG_ALL);
+    // LogComponentEnable("TcpCerl", LOG_PREFIX_ALL);
+    // LogComponentEnable("TcpSocketBase", LOG_ALL);
+    // LogComponentEnable("TcpSocketBase", LOG_PREFIX_ALL);
+    // LogComponentEnable("TcpRecoveryOps", LOG_ALL);
+    // LogComponentEnable("TcpRecoveryOps", LOG_PREFIX_ALL);
+
+    TopologyParams params;
+    SweepParams sweep;
+
+    /* Command line argument parser setup. */
+    CommandLine cmd(__FILE__);
+    AddTopologyOptions(cmd, params);
+    AddSweepOptions(cmd, sweep);
+    cmd.Parse(argc, argv);
+
+    if (sweep.enabled)
+    {
+        return RunSweep(params, sweep);
+    }
+
+    ConfigureTopologyDefaults(params);
+    RunTopology(params);
     return 0;
 }
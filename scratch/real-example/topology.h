@@ -0,0 +1,72 @@
+#ifndef REAL_EXAMPLE_TOPOLOGY_H
+#define REAL_EXAMPLE_TOPOLOGY_H
+
+#include "ns3/command-line.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * Parameters of one run of the topology experiment
+ */
+struct TopologyParams
+{
+    uint32_t payloadSize = 1472;            /* Transport layer payload size in bytes. */
+    size_t dataRate = 26;                   /* Application layer datarate. */
+    size_t udpDataRate = 10;                /* Data rate on the UDP nodes */
+    std::string tcpVariant{"TcpLinuxReno"}; /* TCP variant type. */
+    size_t tcpNodes = 1;                    /* Number of TCP nodes */
+    size_t udpNodes = 0;                    /* Number of udp nodes. */
+    std::string phyRate = "HtMcs7";         /* Physical layer bitrate. */
+    double simulationTime = 10;             /* Simulation time in seconds. */
+    double distanceToAP = 10.0;             /* Distance to AP station from STA node. */
+    bool uplink = true;                     /* Determine the location of server */
+    double errorRate = 0;                   /* Error rate on wired link */
+    bool tcpAdw = false;                    /* Use TCP-ADW */
+    bool tcpAad = false;                    /* Use TCP-AAD */
+    bool tcpAggEnd = false;                 /* ACK on the end of the A-MPDUs (MAC hint) */
+    bool cwndEnabled = false;               /* Send CWND as an option */
+    bool rxTrace = true;                    /* Write the per-segment trace of the receiver */
+    bool fortyHz = false;                   /* Set channel width to 40 mhz */
+    bool mobility = false;                  /* Whether station are static or moving */
+    size_t lLost = 0;                       /* Amount of Mbps lost on link from G1 to G2 */
+    size_t ampdu = 65535;                   /* A-MPDU aggregation size */
+    size_t amsdu = 0;                       /* A-MSDU aggregation size */
+    double alpha = 0.75;                    /* alpha parameter (TCP-ADW, TCP-AAD) */
+    double beta = 1.5;                      /* beta parameter (TCP-AAD) */
+    double lambda = 1.5;                    /* lamda parameter (TCP-ADW) */
+    size_t rngSeed = 1;                     /* rng seed to use in simulation */
+    size_t tx = 16;                         /* transmission power of stations */
+};
+
+/**
+ * Register the command line options of the topology experiment
+ *
+ * \param cmd the command line
+ * \param params the parameters set by the options
+ */
+void AddTopologyOptions(ns3::CommandLine& cmd, TopologyParams& params);
+
+/**
+ * \param params the parameters of a run
+ * \return the name of the delayed ACK algorithm of the run
+ */
+std::string GetAlgorithmName(const TopologyParams& params);
+
+/**
+ * Set the attribute defaults of a run. The defaults are shared by the whole
+ * process, so they are set once before the runs that use them.
+ *
+ * \param params the parameters of the run
+ */
+void ConfigureTopologyDefaults(const TopologyParams& params);
+
+/**
+ * Run the topology experiment once. The traces are written to the results directory.
+ *
+ * \param params the parameters of the run
+ * \return the average throughput of every TCP flow, in Mbps
+ */
+std::vector<double> RunTopology(const TopologyParams& params);
+
+#endif /* REAL_EXAMPLE_TOPOLOGY_H */
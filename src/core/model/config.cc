@@ -24,9 +24,13 @@
 #include "object-ptr-container.h"
 #include "object.h"
 #include "pointer.h"
+#include "simulator-context.h"
 #include "singleton.h"
 
+#include <limits>
+#include <memory>
 #include <sstream>
+#include <unordered_map>
 
 /**
  * \file
@@ -197,6 +201,9 @@ MatchContainer::DisconnectWithoutContext(std::string name, const CallbackBase& c
 /**
  * \ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once, at construction, into the ranges of
+ * the indices it matches.
  */
 class ArrayMatcher
 {
@@ -214,8 +221,22 @@ class ArrayMatcher
      * \returns \c true if the index matches the Config Path.
      */
     bool Matches(std::size_t i) const;
+    /**
+     * Get the index matched by the Config path specification, if it
+     * matches a single one.
+     *
+     * \param [out] i The index.
+     * \returns \c true if the specification matches a single index.
+     */
+    bool GetSingleIndex(std::size_t* i) const;
 
   private:
+    /**
+     * Add the ranges of indices matched by a Config path specification.
+     *
+     * \param [in] element The Config path specification.
+     */
+    void Parse(std::string element);
     /**
      * Convert a string to an \c uint32_t.
      *
@@ -226,6 +247,8 @@ class ArrayMatcher
     bool StringToUint32(std::string str, uint32_t* value) const;
     /** The Config path element. */
     std::string m_element;
+    /** The ranges of the indices which match, bounds included. */
+    std::vector<std::pair<std::size_t, std::size_t>> m_ranges;
 
 }; // class ArrayMatcher
 
@@ -233,70 +256,77 @@ ArrayMatcher::ArrayMatcher(std::string element)
     : m_element(element)
 {
     NS_LOG_FUNCTION(this << element);
+    Parse(element);
 }
 
-bool
-ArrayMatcher::Matches(std::size_t i) const
+void
+ArrayMatcher::Parse(std::string element)
 {
-    NS_LOG_FUNCTION(this << i);
-    if (m_element == "*")
+    NS_LOG_FUNCTION(this << element);
+    if (element == "*")
     {
-        NS_LOG_DEBUG("Array " << i << " matches *");
-        return true;
+        m_ranges.emplace_back(0, std::numeric_limits<std::size_t>::max());
+        return;
     }
     std::string::size_type tmp;
-    tmp = m_element.find('|');
+    tmp = element.find('|');
     if (tmp != std::string::npos)
     {
-        std::string left = m_element.substr(0, tmp - 0);
-        std::string right = m_element.substr(tmp + 1, m_element.size() - (tmp + 1));
-        ArrayMatcher matcher = ArrayMatcher(left);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << left);
-            return true;
-        }
-        matcher = ArrayMatcher(right);
-        if (matcher.Matches(i))
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << right);
-            return true;
-        }
-        NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
-        return false;
+        Parse(element.substr(0, tmp - 0));
+        Parse(element.substr(tmp + 1, element.size() - (tmp + 1)));
+        return;
     }
-    std::string::size_type leftBracket = m_element.find('[');
-    std::string::size_type rightBracket = m_element.find(']');
-    std::string::size_type dash = m_element.find('-');
-    if (leftBracket == 0 && rightBracket == m_element.size() - 1 && dash > leftBracket &&
+    std::string::size_type leftBracket = element.find('[');
+    std::string::size_type rightBracket = element.find(']');
+    std::string::size_type dash = element.find('-');
+    if (leftBracket == 0 && rightBracket == element.size() - 1 && dash > leftBracket &&
         dash < rightBracket)
     {
-        std::string lowerBound = m_element.substr(leftBracket + 1, dash - (leftBracket + 1));
-        std::string upperBound = m_element.substr(dash + 1, rightBracket - (dash + 1));
+        std::string lowerBound = element.substr(leftBracket + 1, dash - (leftBracket + 1));
+        std::string upperBound = element.substr(dash + 1, rightBracket - (dash + 1));
         uint32_t min;
         uint32_t max;
-        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && i >= min &&
-            i <= max)
+        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && min <= max)
         {
-            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
-            return true;
-        }
-        else
-        {
-            NS_LOG_DEBUG("Array " << i << " does not " << m_element);
-            return false;
+            m_ranges.emplace_back(min, max);
         }
+        return;
     }
     uint32_t value;
-    if (StringToUint32(m_element, &value) && i == value)
+    if (StringToUint32(element, &value))
+    {
+        m_ranges.emplace_back(value, value);
+    }
+}
+
+bool
+ArrayMatcher::Matches(std::size_t i) const
+{
+    NS_LOG_FUNCTION(this << i);
+    for (const auto& [min, max] : m_ranges)
     {
-        NS_LOG_DEBUG("Array " << i << " matches " << m_element);
-        return true;
+        if (i >= min && i <= max)
+        {
+            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
+            return true;
+        }
     }
     NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
     return false;
 }
 
+bool
+ArrayMatcher::GetSingleIndex(std::size_t* i) const
+{
+    NS_LOG_FUNCTION(this << i);
+    if (m_ranges.size() != 1 || m_ranges.front().first != m_ranges.front().second)
+    {
+        return false;
+    }
+    *i = m_ranges.front().first;
+    return true;
+}
+
 bool
 ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
 {
@@ -307,6 +337,183 @@ ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
     return !iss.bad() && !iss.fail();
 }
 
+/**
+ * \ingroup config-impl
+ * A Config path split once into its elements.
+ *
+ * Each element keeps its array matcher and, for each TypeId it has been
+ * resolved on, the attributes it matches, so that resolving the path
+ * again does not parse strings nor compare attribute names.
+ */
+class CompiledPath
+{
+  public:
+    /** An attribute which leads to other objects. */
+    struct Attribute
+    {
+        TypeId::AttributeInformation info; //!< The attribute
+        bool container;                    //!< \c true for a container, \c false for a pointer
+    };
+
+    /**
+     * Construct from a Config path.
+     *
+     * \param [in] path The Config path.
+     */
+    CompiledPath(std::string path);
+
+    /** \returns The Config path. */
+    std::string GetPath() const;
+    /** \returns The number of elements of the path. */
+    std::size_t GetN() const;
+    /**
+     * \param [in] i The index of the element.
+     * \returns The element.
+     */
+    const std::string& GetElement(std::size_t i) const;
+    /**
+     * \param [in] i The index of the element.
+     * \returns The matcher of the element, when it follows a container.
+     */
+    const ArrayMatcher& GetMatcher(std::size_t i) const;
+    /**
+     * \param [in] i The index of a \c $TypeId element.
+     * \returns The TypeId of the element.
+     */
+    TypeId GetObjectTypeId(std::size_t i) const;
+    /**
+     * Get the attributes of a TypeId and of its parents which match an
+     * element and lead to other objects, in the order of the search.
+     *
+     * \param [in] i The index of the element.
+     * \param [in] tid The TypeId.
+     * \returns The attributes.
+     */
+    const std::vector<Attribute>& GetAttributes(std::size_t i, TypeId tid);
+
+  private:
+    /** An element of the path. */
+    struct Element
+    {
+        std::string name;     //!< The element
+        ArrayMatcher matcher; //!< The matcher of the element
+        TypeId tid;           //!< The TypeId of a \c $TypeId element, if registered
+        bool hasTid;          //!< \c true if tid is set
+        /** The attributes matching the element, by TypeId uid. */
+        std::unordered_map<uint16_t, std::vector<Attribute>> attributes;
+    };
+
+    /** The Config path. */
+    std::string m_path;
+    /** The elements of the path. */
+    std::vector<Element> m_elements;
+
+}; // class CompiledPath
+
+CompiledPath::CompiledPath(std::string path)
+    : m_path(path)
+{
+    NS_LOG_FUNCTION(this << path);
+
+    // ensure that we start and end with a '/'
+    if (path.find('/') != 0)
+    {
+        path = "/" + path;
+    }
+    if (path.find_last_of('/') != path.size() - 1)
+    {
+        path = path + "/";
+    }
+
+    std::string::size_type start = 1;
+    std::string::size_type next;
+    while ((next = path.find('/', start)) != std::string::npos)
+    {
+        std::string name = path.substr(start, next - start);
+        TypeId tid;
+        bool hasTid = name.find('$') == 0 &&
+                      TypeId::LookupByNameFailSafe(name.substr(1, name.size() - 1), &tid);
+        m_elements.push_back(Element{name, ArrayMatcher(name), tid, hasTid, {}});
+        start = next + 1;
+    }
+}
+
+std::string
+CompiledPath::GetPath() const
+{
+    return m_path;
+}
+
+std::size_t
+CompiledPath::GetN() const
+{
+    return m_elements.size();
+}
+
+const std::string&
+CompiledPath::GetElement(std::size_t i) const
+{
+    return m_elements[i].name;
+}
+
+const ArrayMatcher&
+CompiledPath::GetMatcher(std::size_t i) const
+{
+    return m_elements[i].matcher;
+}
+
+TypeId
+CompiledPath::GetObjectTypeId(std::size_t i) const
+{
+    const Element& element = m_elements[i];
+    if (element.hasTid)
+    {
+        return element.tid;
+    }
+    // not registered when the path was compiled
+    return TypeId::LookupByName(element.name.substr(1, element.name.size() - 1));
+}
+
+const std::vector<CompiledPath::Attribute>&
+CompiledPath::GetAttributes(std::size_t i, TypeId tid)
+{
+    NS_LOG_FUNCTION(this << i << tid);
+    Element& element = m_elements[i];
+    auto found = element.attributes.find(tid.GetUid());
+    if (found != element.attributes.end())
+    {
+        return found->second;
+    }
+
+    std::vector<Attribute>& attributes = element.attributes[tid.GetUid()];
+    TypeId nextTid = tid;
+    do
+    {
+        tid = nextTid;
+        for (uint32_t j = 0; j < tid.GetAttributeN(); j++)
+        {
+            TypeId::AttributeInformation info = tid.GetAttribute(j);
+            if (info.name != element.name && element.name != "*")
+            {
+                continue;
+            }
+            if (dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)) != nullptr)
+            {
+                attributes.push_back({info, false});
+            }
+            else if (dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker)) !=
+                     nullptr)
+            {
+                attributes.push_back({info, true});
+            }
+            // this could be anything else and we don't know what to do with it.
+            // So, we just ignore it.
+        }
+        nextTid = tid.GetParent();
+    } while (nextTid != tid);
+    return attributes;
+}
+
 /**
  * \ingroup config-impl
  * Abstract class to parse Config paths into object references.
@@ -315,11 +522,11 @@ class Resolver
 {
   public:
     /**
-     * Construct from a base Config path.
+     * Construct from a compiled Config path.
      *
      * \param [in] path The Config path.
      */
-    Resolver(std::string path);
+    Resolver(CompiledPath& path);
     /** Destructor. */
     virtual ~Resolver();
 
@@ -333,23 +540,25 @@ class Resolver
     void Resolve(Ptr<Object> root);
 
   private:
-    /** Ensure the Config path starts and ends with a '/'. */
-    void Canonicalize();
     /**
      * Parse the next element in the Config path.
      *
-     * \param [in] path The remaining portion of the Config path.
+     * \param [in] element The index of the next element of the Config path.
      * \param [in] root The object corresponding to the current position
      *                  in the Config path.
      */
-    void DoResolve(std::string path, Ptr<Object> root);
+    void DoResolve(std::size_t element, Ptr<Object> root);
     /**
      * Parse an index on the Config path.
      *
-     * \param [in] path The remaining Config path.
-     * \param [in,out] vector The resulting list of matching objects.
+     * \param [in] element The index of the element of the Config path
+     *                     which holds the index.
+     * \param [in] root The object which holds the container.
+     * \param [in] info The container attribute.
      */
-    void DoArrayResolve(std::string path, const ObjectPtrContainerValue& vector);
+    void DoArrayResolve(std::size_t element,
+                        Ptr<Object> root,
+                        const TypeId::AttributeInformation& info);
     /**
      * Handle one object found on the path.
      *
@@ -373,15 +582,14 @@ class Resolver
     /** Current list of path tokens. */
     std::vector<std::string> m_workStack;
     /** The Config path. */
-    std::string m_path;
+    CompiledPath& m_path;
 
 }; // class Resolver
 
-Resolver::Resolver(std::string path)
+Resolver::Resolver(CompiledPath& path)
     : m_path(path)
 {
-    NS_LOG_FUNCTION(this << path);
-    Canonicalize();
+    NS_LOG_FUNCTION(this << path.GetPath());
 }
 
 Resolver::~Resolver()
@@ -389,32 +597,12 @@ Resolver::~Resolver()
     NS_LOG_FUNCTION(this);
 }
 
-void
-Resolver::Canonicalize()
-{
-    NS_LOG_FUNCTION(this);
-
-    // ensure that we start and end with a '/'
-    std::string::size_type tmp = m_path.find('/');
-    if (tmp != 0)
-    {
-        // no slash at start
-        m_path = "/" + m_path;
-    }
-    tmp = m_path.find_last_of('/');
-    if (tmp != (m_path.size() - 1))
-    {
-        // no slash at end
-        m_path = m_path + "/";
-    }
-}
-
 void
 Resolver::Resolve(Ptr<Object> root)
 {
     NS_LOG_FUNCTION(this << root);
 
-    DoResolve(m_path, root);
+    DoResolve(0, root);
 }
 
 std::string
@@ -440,13 +628,11 @@ Resolver::DoResolveOne(Ptr<Object> object)
 }
 
 void
-Resolver::DoResolve(std::string path, Ptr<Object> root)
+Resolver::DoResolve(std::size_t element, Ptr<Object> root)
 {
-    NS_LOG_FUNCTION(this << path << root);
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
+    NS_LOG_FUNCTION(this << element << root);
 
-    if (next == std::string::npos)
+    if (element == m_path.GetN())
     {
         //
         // If root is zero, we're beginning to see if we can use the object name
@@ -462,8 +648,7 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
         }
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    const std::string& item = m_path.GetElement(element);
 
     //
     // If root is zero, we're beginning to see if we can use the object name
@@ -474,11 +659,10 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     //
     if (!root)
     {
-        std::string::size_type offset = path.find("/Names");
-        if (offset == 0)
+        if (item.compare(0, 5, "Names") == 0)
         {
             m_workStack.push_back(item);
-            DoResolve(pathLeft, root);
+            DoResolve(element + 1, root);
             m_workStack.pop_back();
             return;
         }
@@ -495,7 +679,7 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     {
         NS_LOG_DEBUG("Name system resolved item = " << item << " to " << namedObject);
         m_workStack.push_back(item);
-        DoResolve(pathLeft, namedObject);
+        DoResolve(element + 1, namedObject);
         m_workStack.pop_back();
         return;
     }
@@ -515,81 +699,56 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     if (dollarPos == 0)
     {
         // This is a call to GetObject
-        std::string tidString = item.substr(1, item.size() - 1);
-        NS_LOG_DEBUG("GetObject=" << tidString << " on path=" << GetResolvedPath());
-        TypeId tid = TypeId::LookupByName(tidString);
+        TypeId tid = m_path.GetObjectTypeId(element);
+        NS_LOG_DEBUG("GetObject=" << tid.GetName() << " on path=" << GetResolvedPath());
         Ptr<Object> object = root->GetObject<Object>(tid);
         if (!object)
         {
-            NS_LOG_DEBUG("GetObject (" << tidString << ") failed on path=" << GetResolvedPath());
+            NS_LOG_DEBUG("GetObject (" << tid.GetName()
+                                       << ") failed on path=" << GetResolvedPath());
             return;
         }
         m_workStack.push_back(item);
-        DoResolve(pathLeft, object);
+        DoResolve(element + 1, object);
         m_workStack.pop_back();
     }
     else
     {
         // this is a normal attribute.
-        TypeId tid;
-        TypeId nextTid = root->GetInstanceTypeId();
         bool foundMatch = false;
-
-        do
+        for (const auto& attribute : m_path.GetAttributes(element, root->GetInstanceTypeId()))
         {
-            tid = nextTid;
-
-            for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+            const TypeId::AttributeInformation& info = attribute.info;
+            if (!attribute.container)
             {
-                TypeId::AttributeInformation info;
-                info = tid.GetAttribute(i);
-                if (info.name != item && item != "*")
+                NS_LOG_DEBUG("GetAttribute(ptr)=" << info.name
+                                                  << " on path=" << GetResolvedPath());
+                PointerValue pValue;
+                root->GetAttribute(info.name, pValue);
+                Ptr<Object> object = pValue.Get<Object>();
+                if (!object)
                 {
+                    NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
+                                                            << GetResolvedPath()
+                                                            << "\""
+                                                               " but is null.");
                     continue;
                 }
-                // attempt to cast to a pointer checker.
-                const auto pChecker =
-                    dynamic_cast<const PointerChecker*>(PeekPointer(info.checker));
-                if (pChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(ptr)=" << info.name
-                                                      << " on path=" << GetResolvedPath());
-                    PointerValue pValue;
-                    root->GetAttribute(info.name, pValue);
-                    Ptr<Object> object = pValue.Get<Object>();
-                    if (!object)
-                    {
-                        NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
-                                                                << GetResolvedPath()
-                                                                << "\""
-                                                                   " but is null.");
-                        continue;
-                    }
-                    foundMatch = true;
-                    m_workStack.push_back(info.name);
-                    DoResolve(pathLeft, object);
-                    m_workStack.pop_back();
-                }
-                // attempt to cast to an object vector.
-                const auto vectorChecker =
-                    dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker));
-                if (vectorChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(vector)=" << info.name << " on path="
-                                                         << GetResolvedPath() << pathLeft);
-                    foundMatch = true;
-                    ObjectPtrContainerValue vector;
-                    root->GetAttribute(info.name, vector);
-                    m_workStack.push_back(info.name);
-                    DoArrayResolve(pathLeft, vector);
-                    m_workStack.pop_back();
-                }
-                // this could be anything else and we don't know what to do with it.
-                // So, we just ignore it.
+                foundMatch = true;
+                m_workStack.push_back(info.name);
+                DoResolve(element + 1, object);
+                m_workStack.pop_back();
             }
-
-            nextTid = tid.GetParent();
-        } while (nextTid != tid);
+            else
+            {
+                NS_LOG_DEBUG("GetAttribute(vector)=" << info.name
+                                                     << " on path=" << GetResolvedPath());
+                foundMatch = true;
+                m_workStack.push_back(info.name);
+                DoArrayResolve(element + 1, root, info);
+                m_workStack.pop_back();
+            }
+        }
 
         if (!foundMatch)
         {
@@ -601,29 +760,48 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
 }
 
 void
-Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& container)
+Resolver::DoArrayResolve(std::size_t element,
+                         Ptr<Object> root,
+                         const TypeId::AttributeInformation& info)
 {
-    NS_LOG_FUNCTION(this << path << &container);
-    NS_ASSERT(!path.empty());
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
-    if (next == std::string::npos)
+    NS_LOG_FUNCTION(this << element << root << info.name);
+    if (element == m_path.GetN())
     {
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    const ArrayMatcher& matcher = m_path.GetMatcher(element);
 
-    ArrayMatcher matcher = ArrayMatcher(item);
+    //
+    // A single index is usually the position of the object in the container:
+    // get this object only, instead of getting the whole container.
+    //
+    std::size_t i;
+    std::size_t n;
+    const auto accessor =
+        dynamic_cast<const ObjectPtrContainerAccessor*>(PeekPointer(info.accessor));
+    if (matcher.GetSingleIndex(&i) && accessor != nullptr &&
+        accessor->GetN(PeekPointer(root), &n) && i < n)
+    {
+        std::size_t index;
+        Ptr<Object> object = accessor->Get(PeekPointer(root), i, &index);
+        if (index == i)
+        {
+            m_workStack.push_back(std::to_string(i));
+            DoResolve(element + 1, object);
+            m_workStack.pop_back();
+            return;
+        }
+    }
+
+    ObjectPtrContainerValue container;
+    root->GetAttribute(info.name, container);
     ObjectPtrContainerValue::Iterator it;
     for (it = container.Begin(); it != container.End(); ++it)
     {
         if (matcher.Matches((*it).first))
         {
-            std::ostringstream oss;
-            oss << (*it).first;
-            m_workStack.push_back(oss.str());
-            DoResolve(pathLeft, (*it).second);
+            m_workStack.push_back(std::to_string((*it).first));
+            DoResolve(element + 1, (*it).second);
             m_workStack.pop_back();
         }
     }
@@ -652,6 +830,13 @@ class ConfigImpl : public Singleton<ConfigImpl>
     void Disconnect(std::string path, const CallbackBase& cb);
     /** \copydoc ns3::Config::LookupMatches() */
     MatchContainer LookupMatches(std::string path);
+    /**
+     * Lookup the objects which match a compiled Config path.
+     *
+     * \param [in] path The compiled Config path.
+     * \returns The matches.
+     */
+    MatchContainer LookupMatches(CompiledPath& path);
 
     /** \copydoc ns3::Config::RegisterRootNamespaceObject() */
     void RegisterRootNamespaceObject(Ptr<Object> obj);
@@ -676,9 +861,31 @@ class ConfigImpl : public Singleton<ConfigImpl>
     /** Container type to hold the root Config path tokens. */
     typedef std::vector<Ptr<Object>> Roots;
 
+    /**
+     * Get the Config path roots of the simulation, which are per thread in
+     * the thread-local mode of SimulatorContext.
+     * \return The list of Config path roots.
+     */
+    Roots& GetRoots();
+    /** \copydoc GetRoots() */
+    const Roots& GetRoots() const;
+
     /** The list of Config path roots. */
     Roots m_roots;
 
+    /**
+     * Get the compiled form of a Config path, compiling it once.
+     *
+     * \param [in] path The Config path.
+     * \returns The compiled path.
+     */
+    CompiledPath& GetCompiledPath(std::string path);
+
+    /** Maximum number of compiled paths kept in the cache. */
+    static constexpr std::size_t MAX_COMPILED_PATHS = 1024;
+    /** The paths compiled by the previous lookups. */
+    std::unordered_map<std::string, std::unique_ptr<CompiledPath>> m_compiledPaths;
+
 }; // class ConfigImpl
 
 void
@@ -777,15 +984,43 @@ ConfigImpl::Disconnect(std::string path, const CallbackBase& cb)
     container.Disconnect(leaf, cb);
 }
 
+CompiledPath&
+ConfigImpl::GetCompiledPath(std::string path)
+{
+    NS_LOG_FUNCTION(this << path);
+
+    auto found = m_compiledPaths.find(path);
+    if (found != m_compiledPaths.end())
+    {
+        return *found->second;
+    }
+    if (m_compiledPaths.size() >= MAX_COMPILED_PATHS)
+    {
+        // the paths are usually either reused or unique: start over
+        m_compiledPaths.clear();
+    }
+    auto compiled = std::make_unique<CompiledPath>(path);
+    CompiledPath& ref = *compiled;
+    m_compiledPaths.emplace(path, std::move(compiled));
+    return ref;
+}
+
 MatchContainer
 ConfigImpl::LookupMatches(std::string path)
 {
     NS_LOG_FUNCTION(this << path);
+    return LookupMatches(GetCompiledPath(path));
+}
+
+MatchContainer
+ConfigImpl::LookupMatches(CompiledPath& path)
+{
+    NS_LOG_FUNCTION(this << path.GetPath());
 
     class LookupMatchesResolver : public Resolver
     {
       public:
-        LookupMatchesResolver(std::string path)
+        LookupMatchesResolver(CompiledPath& path)
             : Resolver(path)
         {
         }
@@ -800,9 +1035,9 @@ ConfigImpl::LookupMatches(std::string path)
         std::vector<std::string> m_contexts;
     } resolver = LookupMatchesResolver(path);
 
-    for (auto i = m_roots.begin(); i != m_roots.end(); i++)
+    for (const auto& root : GetRoots())
     {
-        resolver.Resolve(*i);
+        resolver.Resolve(root);
     }
 
     //
@@ -812,14 +1047,14 @@ ConfigImpl::LookupMatches(std::string path)
     //
     resolver.Resolve(nullptr);
 
-    return MatchContainer(resolver.m_objects, resolver.m_contexts, path);
+    return MatchContainer(resolver.m_objects, resolver.m_contexts, path.GetPath());
 }
 
 void
 ConfigImpl::RegisterRootNamespaceObject(Ptr<Object> obj)
 {
     NS_LOG_FUNCTION(this << obj);
-    m_roots.push_back(obj);
+    GetRoots().push_back(obj);
 }
 
 void
@@ -827,11 +1062,12 @@ ConfigImpl::UnregisterRootNamespaceObject(Ptr<Object> obj)
 {
     NS_LOG_FUNCTION(this << obj);
 
-    for (auto i = m_roots.begin(); i != m_roots.end(); i++)
+    Roots& roots = GetRoots();
+    for (auto i = roots.begin(); i != roots.end(); i++)
     {
         if (*i == obj)
         {
-            m_roots.erase(i);
+            roots.erase(i);
             return;
         }
     }
@@ -841,14 +1077,27 @@ std::size_t
 ConfigImpl::GetRootNamespaceObjectN() const
 {
     NS_LOG_FUNCTION(this);
-    return m_roots.size();
+    return GetRoots().size();
 }
 
 Ptr<Object>
 ConfigImpl::GetRootNamespaceObject(std::size_t i) const
 {
     NS_LOG_FUNCTION(this << i);
-    return m_roots[i];
+    return GetRoots()[i];
+}
+
+ConfigImpl::Roots&
+ConfigImpl::GetRoots()
+{
+    static thread_local Roots localRoots;
+    return SimulatorContext::Select(m_roots, localRoots);
+}
+
+const ConfigImpl::Roots&
+ConfigImpl::GetRoots() const
+{
+    return const_cast<ConfigImpl*>(this)->GetRoots();
 }
 
 void
@@ -917,7 +1166,7 @@ SetDefaultFailSafe(std::string fullName, const AttributeValue& value)
     tid.LookupAttributeByName(paramName, &info);
     for (uint32_t j = 0; j < tid.GetAttributeN(); j++)
     {
-        TypeId::AttributeInformation tmp = tid.GetAttribute(j);
+        const TypeId::AttributeInformation& tmp = tid.PeekAttribute(j);
         if (tmp.name == paramName)
         {
             Ptr<AttributeValue> v = tmp.checker->CreateValidValue(value);
@@ -1029,6 +1278,80 @@ GetRootNamespaceObject(uint32_t i)
     return ConfigImpl::Get()->GetRootNamespaceObject(i);
 }
 
+PathHandle::PathHandle(std::string path)
+    : m_path(path)
+{
+    NS_LOG_FUNCTION(this << path);
+    std::string::size_type slash = path.find_last_of('/');
+    NS_ASSERT(slash != std::string::npos);
+    m_name = path.substr(slash + 1, path.size() - (slash + 1));
+    m_objects = std::make_shared<CompiledPath>(path.substr(0, slash));
+}
+
+std::string
+PathHandle::GetPath() const
+{
+    return m_path;
+}
+
+std::string
+PathHandle::GetName() const
+{
+    return m_name;
+}
+
+MatchContainer
+PathHandle::LookupMatches() const
+{
+    NS_LOG_FUNCTION(this);
+    return ConfigImpl::Get()->LookupMatches(*m_objects);
+}
+
+MatchContainer
+PathHandle::LookupNewMatches()
+{
+    NS_LOG_FUNCTION(this);
+    MatchContainer matches = LookupMatches();
+    std::vector<Ptr<Object>> objects;
+    std::vector<std::string> contexts;
+    for (std::size_t i = 0; i < matches.GetN(); i++)
+    {
+        if (m_seen.emplace(PeekPointer(matches.Get(i)), matches.GetMatchedPath(i)).second)
+        {
+            objects.push_back(matches.Get(i));
+            contexts.push_back(matches.GetMatchedPath(i));
+        }
+    }
+    return MatchContainer(objects, contexts, matches.GetPath());
+}
+
+void
+PathHandle::SetAll(const AttributeValue& value) const
+{
+    NS_LOG_FUNCTION(this << &value);
+    LookupMatches().Set(m_name, value);
+}
+
+void
+PathHandle::ConnectAll(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    if (!LookupMatches().ConnectFailSafe(m_name, cb))
+    {
+        NS_FATAL_ERROR("Could not connect callback to " << m_path);
+    }
+}
+
+void
+PathHandle::ConnectAllWithoutContext(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    if (!LookupMatches().ConnectWithoutContextFailSafe(m_name, cb))
+    {
+        NS_FATAL_ERROR("Could not connect callback to " << m_path);
+    }
+}
+
 } // namespace Config
 
 } // namespace ns3
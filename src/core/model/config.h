@@ -21,6 +21,8 @@
 
 #include "ptr.h"
 
+#include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -361,6 +363,92 @@ class MatchContainer
  */
 MatchContainer LookupMatches(std::string path);
 
+class CompiledPath;
+
+/**
+ * \ingroup config
+ * \brief A Config path compiled once, to configure or trace the matching
+ * objects many times.
+ *
+ * The path is split into its elements and the index specifications are
+ * parsed when the handle is created; the attributes which match each
+ * element are then looked up once per TypeId. Resolving the handle only
+ * walks the objects, which makes it cheap to resolve a path again after
+ * nodes, devices or sockets have been added, and to configure many
+ * objects at once.
+ *
+ * The path has the same form as for Config::Set and Config::Connect: its
+ * last element is the name of the attribute or of the trace source, and
+ * the other elements select the objects.
+ *
+ * To connect a sink to the objects which appear as the simulation is
+ * built, for instance to the sockets of a node, look up the new matches
+ * from time to time:
+ * \code
+ *   Config::PathHandle handle("/NodeList/2/$ns3::TcpL4Protocol/SocketList/[0-999]/Rx");
+ *   ...
+ *   handle.LookupNewMatches().Connect(handle.GetName(), MakeCallback(&Rx));
+ * \endcode
+ */
+class PathHandle
+{
+  public:
+    /**
+     * Compile a path.
+     *
+     * \param [in] path The path of an attribute or of a trace source.
+     */
+    PathHandle(std::string path);
+
+    /** \returns The path. */
+    std::string GetPath() const;
+    /** \returns The name of the attribute or of the trace source. */
+    std::string GetName() const;
+
+    /**
+     * \returns A container with the objects which match the path, without
+     *          the name of the attribute or of the trace source.
+     */
+    MatchContainer LookupMatches() const;
+    /**
+     * \returns A container with the objects which match the path and were
+     *          not returned by the previous calls of this method.
+     */
+    MatchContainer LookupNewMatches();
+
+    /**
+     * Set the attribute of all the matching objects.
+     *
+     * \param [in] value The value of the attribute.
+     * \sa ns3::Config::Set
+     */
+    void SetAll(const AttributeValue& value) const;
+    /**
+     * Connect a sink to the trace source of all the matching objects.
+     *
+     * \param [in] cb The sink, called with the context of each object.
+     * \sa ns3::Config::Connect
+     */
+    void ConnectAll(const CallbackBase& cb) const;
+    /**
+     * Connect a sink to the trace source of all the matching objects.
+     *
+     * \param [in] cb The sink, called without context.
+     * \sa ns3::Config::ConnectWithoutContext
+     */
+    void ConnectAllWithoutContext(const CallbackBase& cb) const;
+
+  private:
+    /** The path. */
+    std::string m_path;
+    /** The name of the attribute or of the trace source. */
+    std::string m_name;
+    /** The path of the objects, compiled. */
+    std::shared_ptr<CompiledPath> m_objects;
+    /** The objects returned by LookupNewMatches(), with their context. */
+    std::set<std::pair<const Object*, std::string>> m_seen;
+};
+
 /**
  * \ingroup config
  * \param [in] obj A new root object
@@ -19,10 +19,13 @@
 
 #include "default-simulator-impl.h"
 
+#include "abort.h"
 #include "assert.h"
+#include "global-value.h"
 #include "log.h"
 #include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
 
 #include <cmath>
 
@@ -42,6 +45,21 @@ NS_LOG_COMPONENT_DEFINE("DefaultSimulatorImpl");
 
 NS_OBJECT_ENSURE_REGISTERED(DefaultSimulatorImpl);
 
+/**
+ * \ingroup simulator
+ * \anchor GlobalValueEventProfile
+ * The prefix of the files of the profile of the events, or empty to not profile them.
+ */
+static GlobalValue g_eventProfile =
+    GlobalValue("EventProfile",
+                "The prefix of the files where DefaultSimulatorImpl writes the profile of the "
+                "events, or empty to not profile them",
+                StringValue(""),
+                MakeStringChecker());
+
+/** Number of events from a different context which can wait without lock. */
+static constexpr std::size_t EVENTS_WITH_CONTEXT_CAPACITY = 4096;
+
 TypeId
 DefaultSimulatorImpl::GetTypeId()
 {
@@ -53,6 +71,8 @@ DefaultSimulatorImpl::GetTypeId()
 }
 
 DefaultSimulatorImpl::DefaultSimulatorImpl()
+    : m_eventsWithContext(EVENTS_WITH_CONTEXT_CAPACITY),
+      m_eventsWithContextOverflowing(false)
 {
     NS_LOG_FUNCTION(this);
     m_stop = false;
@@ -62,7 +82,6 @@ DefaultSimulatorImpl::DefaultSimulatorImpl()
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
     m_eventCount = 0;
-    m_eventsWithContextEmpty = true;
     m_mainThreadId = std::this_thread::get_id();
 }
 
@@ -83,6 +102,12 @@ DefaultSimulatorImpl::DoDispose()
         next.impl->Unref();
     }
     m_events = nullptr;
+
+    if (m_profiler)
+    {
+        m_profiler->Write(m_profilePrefix);
+        m_profiler = nullptr;
+    }
     SimulatorImpl::DoDispose();
 }
 
@@ -141,7 +166,17 @@ DefaultSimulatorImpl::ProcessOneEvent()
     m_currentTs = next.key.m_ts;
     m_currentContext = next.key.m_context;
     m_currentUid = next.key.m_uid;
-    next.impl->Invoke();
+    if (EventProfiler::ENABLED && m_profiler)
+    {
+        uint32_t uid = m_uid;
+        EventProfiler::Clock::time_point start = EventProfiler::Clock::now();
+        next.impl->Invoke();
+        m_profiler->Record(*next.impl, EventProfiler::Clock::now() - start, m_uid - uid);
+    }
+    else
+    {
+        next.impl->Invoke();
+    }
     next.impl->Unref();
 
     ProcessEventsWithContext();
@@ -156,33 +191,42 @@ DefaultSimulatorImpl::IsFinished() const
 void
 DefaultSimulatorImpl::ProcessEventsWithContext()
 {
-    if (m_eventsWithContextEmpty)
+    EventWithContext event;
+    while (m_eventsWithContext.Pop(event))
+    {
+        InsertEventWithContext(event);
+    }
+    if (!m_eventsWithContextOverflowing.load(std::memory_order_acquire))
     {
         return;
     }
 
-    // swap queues
+    // swap queues, the next events go to the queue again
     EventsWithContext eventsWithContext;
     {
         std::unique_lock lock{m_eventsWithContextMutex};
-        m_eventsWithContext.swap(eventsWithContext);
-        m_eventsWithContextEmpty = true;
+        m_eventsWithContextOverflow.swap(eventsWithContext);
+        m_eventsWithContextOverflowing.store(false, std::memory_order_release);
     }
-    while (!eventsWithContext.empty())
+    for (const auto& overflowEvent : eventsWithContext)
     {
-        EventWithContext event = eventsWithContext.front();
-        eventsWithContext.pop_front();
-        Scheduler::Event ev;
-        ev.impl = event.event;
-        ev.key.m_ts = m_currentTs + event.timestamp;
-        ev.key.m_context = event.context;
-        ev.key.m_uid = m_uid;
-        m_uid++;
-        m_unscheduledEvents++;
-        m_events->Insert(ev);
+        InsertEventWithContext(overflowEvent);
     }
 }
 
+void
+DefaultSimulatorImpl::InsertEventWithContext(const EventWithContext& event)
+{
+    Scheduler::Event ev;
+    ev.impl = event.event;
+    ev.key.m_ts = m_currentTs + event.timestamp;
+    ev.key.m_context = event.context;
+    ev.key.m_uid = m_uid;
+    m_uid++;
+    m_unscheduledEvents++;
+    m_events->Insert(ev);
+}
+
 void
 DefaultSimulatorImpl::Run()
 {
@@ -192,6 +236,16 @@ DefaultSimulatorImpl::Run()
     ProcessEventsWithContext();
     m_stop = false;
 
+    StringValue profile;
+    g_eventProfile.GetValue(profile);
+    if (!profile.Get().empty() && !m_profiler)
+    {
+        NS_ABORT_MSG_IF(!EventProfiler::ENABLED,
+                        "EventProfile is not available in the optimized builds");
+        m_profiler = std::make_unique<EventProfiler>();
+        m_profilePrefix = profile.Get();
+    }
+
     while (!m_events->IsEmpty() && !m_stop)
     {
         ProcessOneEvent();
@@ -264,11 +318,15 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
         // Current time added in ProcessEventsWithContext()
         ev.timestamp = delay.GetTimeStep();
         ev.event = event;
+        // once an event overflowed, the next ones follow it to keep their order
+        if (!m_eventsWithContextOverflowing.load(std::memory_order_acquire) &&
+            m_eventsWithContext.Push(ev))
         {
-            std::unique_lock lock{m_eventsWithContextMutex};
-            m_eventsWithContext.push_back(ev);
-            m_eventsWithContextEmpty = false;
+            return;
         }
+        std::unique_lock lock{m_eventsWithContextMutex};
+        m_eventsWithContextOverflow.push_back(ev);
+        m_eventsWithContextOverflowing.store(true, std::memory_order_release);
     }
 }
 
@@ -349,10 +407,16 @@ DefaultSimulatorImpl::Remove(const EventId& id)
 void
 DefaultSimulatorImpl::Cancel(const EventId& id)
 {
-    if (!IsExpired(id))
+    if (IsExpired(id))
     {
-        id.PeekEventImpl()->Cancel();
+        return;
+    }
+    if (id.GetUid() != EventId::UID::DESTROY && m_events->IsRemoveCheap())
+    {
+        Remove(id);
+        return;
     }
+    id.PeekEventImpl()->Cancel();
 }
 
 bool
@@ -20,9 +20,13 @@
 #ifndef DEFAULT_SIMULATOR_IMPL_H
 #define DEFAULT_SIMULATOR_IMPL_H
 
+#include "event-profiler.h"
+#include "mpsc-queue.h"
 #include "simulator-impl.h"
 
+#include <atomic>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <thread>
 
@@ -97,16 +101,25 @@ class DefaultSimulatorImpl : public SimulatorImpl
         EventImpl* event;
     };
 
+    /**
+     * Insert an event from a different context in the main event queue.
+     *
+     * \param [in] event The event.
+     */
+    void InsertEventWithContext(const EventWithContext& event);
+
+    /** The events from a different context, pushed by other threads without lock. */
+    MpscQueue<EventWithContext> m_eventsWithContext;
     /** Container type for the events from a different context. */
     typedef std::list<EventWithContext> EventsWithContext;
-    /** The container of events from a different context. */
-    EventsWithContext m_eventsWithContext;
     /**
-     * Flag \c true if all events with context have been moved to the
-     * primary event queue.
+     * The events from a different context pushed while the queue was full,
+     * and the following ones until the queue has been emptied.
      */
-    bool m_eventsWithContextEmpty;
-    /** Mutex to control access to the list of events with context. */
+    EventsWithContext m_eventsWithContextOverflow;
+    /** Flag \c true if there are events in the overflow list. */
+    std::atomic<bool> m_eventsWithContextOverflowing;
+    /** Mutex to control access to the overflow list. */
     std::mutex m_eventsWithContextMutex;
 
     /** Container type for the events to run at Simulator::Destroy() */
@@ -136,6 +149,11 @@ class DefaultSimulatorImpl : public SimulatorImpl
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
+
+    /** The profile of the events, if the EventProfile global value is set. */
+    std::unique_ptr<EventProfiler> m_profiler;
+    /** The prefix of the files of the profile. */
+    std::string m_profilePrefix;
 };
 
 } // namespace ns3
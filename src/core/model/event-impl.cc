@@ -21,6 +21,8 @@
 
 #include "log.h"
 
+#include <new>
+
 /**
  * \file
  * \ingroup events
@@ -32,13 +34,71 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("EventImpl");
 
+namespace
+{
+
+/** Size of the size classes of the event free lists, in bytes. */
+constexpr std::size_t EVENT_POOL_GRANULARITY = 16;
+/** Number of size classes, the larger events are not pooled. */
+constexpr std::size_t EVENT_POOL_CLASSES = 16;
+
+/** A released event in a free list. */
+struct FreeEvent
+{
+    FreeEvent* next; //!< Next released event of the same size class
+};
+
+/**
+ * The free lists of the calling thread, by size class. The events released
+ * by a thread go to its lists, whichever thread allocated them.
+ */
+thread_local FreeEvent* g_freeEvents[EVENT_POOL_CLASSES] = {};
+
+/** Whether the free lists of the calling thread have been released. */
+thread_local bool g_freeEventsReleased = false;
+
+/** Release the free lists of a thread to the global allocator when it exits. */
+struct FreeEventsReleaser
+{
+    ~FreeEventsReleaser()
+    {
+        for (auto& head : g_freeEvents)
+        {
+            while (head != nullptr)
+            {
+                FreeEvent* next = head->next;
+                ::operator delete(head);
+                head = next;
+            }
+        }
+        // events destroyed later, e.g. by static destructors, are not pooled
+        g_freeEventsReleased = true;
+    }
+};
+
+/** The releaser of the calling thread, constructed when its lists are first used. */
+thread_local FreeEventsReleaser g_freeEventsReleaser;
+
+/**
+ * \param [in] size The size of an event.
+ * \return The size class of the event.
+ */
+inline std::size_t
+GetEventSizeClass(std::size_t size)
+{
+    return (size - 1) / EVENT_POOL_GRANULARITY;
+}
+
+} // namespace
+
 EventImpl::~EventImpl()
 {
     NS_LOG_FUNCTION(this);
 }
 
 EventImpl::EventImpl()
-    : m_cancel(false)
+    : m_cancel(false),
+      m_schedulerIndex(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -67,4 +127,41 @@ EventImpl::IsCancelled()
     return m_cancel;
 }
 
+void*
+EventImpl::operator new(std::size_t size)
+{
+    std::size_t sizeClass = GetEventSizeClass(size);
+    if (sizeClass >= EVENT_POOL_CLASSES)
+    {
+        return ::operator new(size);
+    }
+    FreeEvent* head = g_freeEvents[sizeClass];
+    if (head != nullptr)
+    {
+        g_freeEvents[sizeClass] = head->next;
+        return head;
+    }
+    // first event of this class: make sure the lists are released at exit
+    static_cast<void>(&g_freeEventsReleaser);
+    return ::operator new((sizeClass + 1) * EVENT_POOL_GRANULARITY);
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size)
+{
+    std::size_t sizeClass = GetEventSizeClass(size);
+    if (sizeClass >= EVENT_POOL_CLASSES || g_freeEventsReleased)
+    {
+        ::operator delete(p);
+        return;
+    }
+    auto event = static_cast<FreeEvent*>(p);
+    if (g_freeEvents[sizeClass] == nullptr)
+    {
+        static_cast<void>(&g_freeEventsReleaser);
+    }
+    event->next = g_freeEvents[sizeClass];
+    g_freeEvents[sizeClass] = event;
+}
+
 } // namespace ns3
@@ -21,6 +21,7 @@
 
 #include "simple-ref-count.h"
 
+#include <cstddef>
 #include <stdint.h>
 
 /**
@@ -67,6 +68,39 @@ class EventImpl : public SimpleRefCount<EventImpl>
      */
     bool IsCancelled();
 
+    /**
+     * \return The position of the event in the event list, for the
+     *          schedulers which keep track of it.
+     */
+    inline uint32_t GetSchedulerIndex() const;
+    /**
+     * Record the position of the event in the event list.
+     *
+     * \param [in] index The position of the event.
+     */
+    inline void SetSchedulerIndex(uint32_t index);
+
+    /**
+     * Allocate the memory of an event.
+     *
+     * Events are created and destroyed at a high rate, with a few sizes
+     * only: the memory of the destroyed events is kept in free lists, one
+     * per size class of 16 bytes and per thread, and reused by the next
+     * events of the same class. The events larger than the largest class
+     * use the global allocator.
+     *
+     * \param [in] size The size of the event.
+     * \return The memory of the event.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Release the memory of an event to the free list of its size class.
+     *
+     * \param [in] p The memory of the event.
+     * \param [in] size The size of the event.
+     */
+    static void operator delete(void* p, std::size_t size);
+
   protected:
     /**
      * Implementation for Invoke().
@@ -77,9 +111,22 @@ class EventImpl : public SimpleRefCount<EventImpl>
     virtual void Notify() = 0;
 
   private:
-    bool m_cancel; /**< Has this event been cancelled. */
+    bool m_cancel;             /**< Has this event been cancelled. */
+    uint32_t m_schedulerIndex; /**< Position of the event in the event list. */
 };
 
+uint32_t
+EventImpl::GetSchedulerIndex() const
+{
+    return m_schedulerIndex;
+}
+
+void
+EventImpl::SetSchedulerIndex(uint32_t index)
+{
+    m_schedulerIndex = index;
+}
+
 } // namespace ns3
 
 #endif /* EVENT_IMPL_H */
@@ -0,0 +1,235 @@
+#include "event-profiler.h"
+
+#include "abort.h"
+#include "event-impl.h"
+#include "log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <vector>
+
+#if (__GNUC__ >= 3)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("EventProfiler");
+
+namespace
+{
+
+/**
+ * \ingroup simulator
+ * Find the end of a template argument list.
+ *
+ * \param [in] name A type name.
+ * \param [in] start The position of the opening bracket.
+ * \return The position of the matching closing bracket, or std::string::npos.
+ */
+std::size_t
+FindClosingBracket(const std::string& name, std::size_t start)
+{
+    int depth = 0;
+    for (std::size_t i = start; i < name.size(); i++)
+    {
+        if (name[i] == '<' || name[i] == '(')
+        {
+            depth++;
+        }
+        else if ((name[i] == '>' || name[i] == ')') && --depth == 0)
+        {
+            return i;
+        }
+    }
+    return std::string::npos;
+}
+
+/**
+ * \ingroup simulator
+ * Get the frames of the collapsed stack of a type of events: the scopes of
+ * the class or function which owns the target, then the name of the type.
+ *
+ * \param [in] name The name of the type, from EventProfiler::GetName().
+ * \return The frames, separated by semicolons.
+ */
+std::string
+GetStack(const std::string& name)
+{
+    std::string owner;
+    std::size_t member = name.find("::*)");
+    std::size_t lambda = name.find("::{lambda");
+    if (member != std::string::npos)
+    {
+        // R (Class::*)(Args), the class is after the last opening parenthesis
+        owner = name.substr(0, member);
+        owner = owner.substr(owner.rfind('(') + 1);
+    }
+    else if (lambda != std::string::npos)
+    {
+        // MakeEvent<Function(Args)::{lambda()#1}>, the function is after the bracket
+        owner = name.substr(0, lambda);
+        owner = owner.substr(owner.find('<') + 1);
+    }
+
+    // split the owner at the scopes outside of the brackets
+    std::string stack;
+    int depth = 0;
+    for (std::size_t i = 0; i < owner.size(); i++)
+    {
+        char c = owner[i];
+        depth += (c == '<' || c == '(') ? 1 : (c == '>' || c == ')') ? -1 : 0;
+        if (depth == 0 && owner.compare(i, 2, "::") == 0)
+        {
+            stack += ';';
+            i++;
+        }
+        else
+        {
+            stack += (c == ';') ? ',' : c;
+        }
+    }
+    if (!stack.empty())
+    {
+        stack += ';';
+    }
+    return stack + name;
+}
+
+} // unnamed namespace
+
+void
+EventProfiler::Record(const EventImpl& event, Clock::duration duration, uint32_t fanout)
+{
+    uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    Profile& profile = m_profiles[typeid(event)];
+    profile.count++;
+    profile.total += ns;
+    profile.max = std::max(profile.max, ns);
+    profile.fanout += fanout;
+    profile.times[GetBucket(ns)]++;
+}
+
+std::size_t
+EventProfiler::GetBucket(uint64_t ns)
+{
+    if (ns < 4)
+    {
+        return ns;
+    }
+    // the power of two, then the next two bits
+    std::size_t exponent = 63 - __builtin_clzll(ns);
+    return (exponent - 1) * 4 + ((ns >> (exponent - 2)) & 3);
+}
+
+uint64_t
+EventProfiler::GetBucketEnd(std::size_t bucket)
+{
+    if (bucket < 4)
+    {
+        return bucket;
+    }
+    std::size_t exponent = bucket / 4 + 1;
+    uint64_t mantissa = bucket % 4 + 5;
+    return (mantissa << (exponent - 2)) - 1;
+}
+
+uint64_t
+EventProfiler::GetPercentile(const Profile& profile, double fraction)
+{
+    auto rank = static_cast<uint64_t>(std::ceil(fraction * profile.count));
+    uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < BUCKETS; bucket++)
+    {
+        seen += profile.times[bucket];
+        if (seen >= rank && seen > 0)
+        {
+            return std::min(GetBucketEnd(bucket), profile.max);
+        }
+    }
+    return profile.max;
+}
+
+std::string
+EventProfiler::GetName(const std::type_index& type)
+{
+    std::string name = type.name();
+#if (__GNUC__ >= 3)
+    int status;
+    char* demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+    if (status == 0)
+    {
+        name = demangled;
+    }
+    std::free(demangled);
+#endif
+
+    // ns3::EventImpl* ns3::MakeEvent<Args>(Params)::EventMemberImpl0
+    std::size_t start = name.find("MakeEvent<");
+    if (start != std::string::npos)
+    {
+        std::size_t end = FindClosingBracket(name, start + 9);
+        if (end != std::string::npos)
+        {
+            name = name.substr(start, end + 1 - start);
+        }
+    }
+    return name;
+}
+
+void
+EventProfiler::Write(const std::string& prefix) const
+{
+    NS_LOG_FUNCTION(this << prefix);
+
+    std::vector<std::pair<std::string, const Profile*>> profiles;
+    uint64_t count = 0;
+    uint64_t total = 0;
+    for (const auto& [type, profile] : m_profiles)
+    {
+        profiles.emplace_back(GetName(type), &profile);
+        count += profile.count;
+        total += profile.total;
+    }
+    std::sort(profiles.begin(), profiles.end(), [](const auto& a, const auto& b) {
+        return a.second->total > b.second->total;
+    });
+
+    std::ofstream flat(prefix + ".txt");
+    NS_ABORT_MSG_IF(!flat.is_open(), "Can not open " << prefix << ".txt");
+    flat << "# " << count << " events, " << total / 1e9 << " s in the events\n"
+         << std::left << std::setw(8) << "# %time" << std::right << std::setw(12) << "total(ms)"
+         << std::setw(12) << "count" << std::setw(12) << "mean(us)" << std::setw(12) << "p99(us)"
+         << std::setw(12) << "max(us)" << std::setw(8) << "fanout"
+         << "  event\n"
+         << std::fixed;
+    for (const auto& [name, profile] : profiles)
+    {
+        flat << std::setprecision(2) << std::setw(7) << 100.0 * profile->total / total << " "
+             << std::setprecision(3) << std::setw(12) << profile->total / 1e6 << std::setw(12)
+             << profile->count << std::setw(12) << profile->total / 1e3 / profile->count
+             << std::setw(12) << GetPercentile(*profile, 0.99) / 1e3 << std::setw(12)
+             << profile->max / 1e3 << std::setprecision(2) << std::setw(8)
+             << static_cast<double>(profile->fanout) / profile->count << "  " << name << "\n";
+    }
+
+    std::ofstream folded(prefix + ".folded");
+    NS_ABORT_MSG_IF(!folded.is_open(), "Can not open " << prefix << ".folded");
+    for (const auto& [name, profile] : profiles)
+    {
+        folded << "ns3::Simulator::Run;" << GetStack(name) << " " << profile->total / 1000
+               << "\n";
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,121 @@
+#ifndef EVENT_PROFILER_H
+#define EVENT_PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <stdint.h>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::EventProfiler declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * \ingroup simulator
+ * \brief Account the wall clock time of the simulation to the types of events.
+ *
+ * The events are grouped by the dynamic type of their EventImpl: MakeEvent
+ * defines one type per target, so each group is one kind of method, function
+ * or lambda invoked by the simulator. For each group, the profiler records
+ * the number of events, the wall clock time spent in them, a histogram of
+ * this time to estimate the 99th percentile, and the number of events they
+ * scheduled.
+ *
+ * The profile is written to two files:
+ * - \c <prefix>.txt, a flat profile sorted by total time;
+ * - \c <prefix>.folded, the total time of each group in microseconds as
+ *   collapsed stacks, the input format of the flame graph tools.
+ *
+ * The simulator creates a profiler when the \c EventProfile global value
+ * is set to the prefix of the files, for instance with
+ * \c --EventProfile=topology on the command line of a program, and writes
+ * the profile when it is destroyed. The profiling code is compiled out of
+ * the optimized builds.
+ */
+class EventProfiler
+{
+  public:
+    /** Whether the simulator can profile the events in this build. */
+#ifdef NS3_BUILD_PROFILE_OPTIMIZED
+    static constexpr bool ENABLED = false;
+#else
+    static constexpr bool ENABLED = true;
+#endif
+
+    /** Clock used to time the events. */
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * Account an event.
+     *
+     * \param [in] event The event.
+     * \param [in] duration The wall clock time spent in the event.
+     * \param [in] fanout The number of events it scheduled.
+     */
+    void Record(const EventImpl& event, Clock::duration duration, uint32_t fanout);
+
+    /**
+     * Write the profile.
+     *
+     * \param [in] prefix The prefix of the names of the files.
+     */
+    void Write(const std::string& prefix) const;
+
+    /**
+     * Get a readable name of a type of events.
+     *
+     * The name of the local classes of MakeEvent is reduced to the
+     * template arguments of MakeEvent, which identify the target.
+     *
+     * \param [in] type The type.
+     * \return The name.
+     */
+    static std::string GetName(const std::type_index& type);
+
+  private:
+    /** Number of buckets of the histograms: four per power of two of nanoseconds. */
+    static constexpr std::size_t BUCKETS = 252;
+
+    /** Profile of a type of events. */
+    struct Profile
+    {
+        uint64_t count{0};                     //!< Number of events
+        uint64_t total{0};                     //!< Total wall clock time, in ns
+        uint64_t max{0};                       //!< Longest event, in ns
+        uint64_t fanout{0};                    //!< Number of events scheduled
+        std::array<uint64_t, BUCKETS> times{}; //!< Histogram of the times
+    };
+
+    /**
+     * \param [in] ns A duration in nanoseconds.
+     * \return The bucket of the duration in the histograms.
+     */
+    static std::size_t GetBucket(uint64_t ns);
+    /**
+     * \param [in] bucket A bucket of the histograms.
+     * \return The longest duration of the bucket, in nanoseconds.
+     */
+    static uint64_t GetBucketEnd(std::size_t bucket);
+    /**
+     * \param [in] profile A profile.
+     * \param [in] fraction The fraction of the events, between 0 and 1.
+     * \return The duration of the events at this fraction, in nanoseconds.
+     */
+    static uint64_t GetPercentile(const Profile& profile, double fraction);
+
+    /** The profiles, by type of events. */
+    std::unordered_map<std::type_index, Profile> m_profiles;
+};
+
+} // namespace ns3
+
+#endif /* EVENT_PROFILER_H */
@@ -20,6 +20,7 @@
 #include "hash.h"
 
 #include "log.h"
+#include "simulator-context.h"
 
 /**
  * \file
@@ -36,8 +37,10 @@ Hasher&
 GetStaticHash()
 {
     static Hasher g_hasher = Hasher();
-    g_hasher.clear();
-    return g_hasher;
+    static thread_local Hasher g_localHasher = Hasher();
+    Hasher& hasher = SimulatorContext::Select(g_hasher, g_localHasher);
+    hasher.clear();
+    return hasher;
 }
 
 Hasher::Hasher()
@@ -0,0 +1,169 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <memory>
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::MpscQueue declaration and template implementation.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup core
+ * \brief A bounded lock-free queue with many producers and one consumer.
+ *
+ * The items are stored in a ring of cells allocated once, at
+ * construction. Each cell has a sequence number which tells whether it
+ * is free for the producer of a given position, or holds the item of a
+ * given position for the consumer: the producers claim a position with
+ * one compare-and-swap, and the consumer never writes to the positions
+ * shared with the producers.
+ *
+ * Push() may be called from any thread. Pop() must always be called
+ * from the same thread. Push() fails instead of waiting when the queue
+ * is full, the caller decides what to do with the item.
+ *
+ * \tparam T \explicit The type of the items, copyable.
+ */
+template <typename T>
+class MpscQueue
+{
+  public:
+    /**
+     * Constructor.
+     *
+     * \param [in] capacity The number of items of the queue, rounded up to
+     *             a power of two.
+     */
+    explicit MpscQueue(std::size_t capacity);
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    /**
+     * Add an item at the end of the queue, from any thread.
+     *
+     * \param [in] item The item.
+     * \return \c false if the queue is full.
+     */
+    bool Push(const T& item);
+
+    /**
+     * Remove the item at the front of the queue, from the consumer thread.
+     *
+     * \param [out] item The item.
+     * \return \c false if the queue is empty.
+     */
+    bool Pop(T& item);
+
+    /** \return The number of items the queue can hold. */
+    std::size_t GetCapacity() const;
+
+  private:
+    /** A cell of the ring. */
+    struct Cell
+    {
+        /**
+         * The position for which the cell is free, or the position plus one
+         * if it holds the item of this position.
+         */
+        std::atomic<std::size_t> sequence;
+        T item; //!< The item
+    };
+
+    std::unique_ptr<Cell[]> m_cells; //!< The ring
+    std::size_t m_mask;              //!< Capacity minus one
+
+    /** Next position to push to, shared by the producers. */
+    alignas(64) std::atomic<std::size_t> m_pushPosition;
+    /** Next position to pop from, only used by the consumer. */
+    alignas(64) std::size_t m_popPosition;
+};
+
+template <typename T>
+MpscQueue<T>::MpscQueue(std::size_t capacity)
+    : m_pushPosition(0),
+      m_popPosition(0)
+{
+    std::size_t size = 1;
+    while (size < capacity)
+    {
+        size *= 2;
+    }
+    m_mask = size - 1;
+    m_cells = std::make_unique<Cell[]>(size);
+    for (std::size_t i = 0; i < size; i++)
+    {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template <typename T>
+bool
+MpscQueue<T>::Push(const T& item)
+{
+    std::size_t position = m_pushPosition.load(std::memory_order_relaxed);
+    Cell* cell;
+    while (true)
+    {
+        cell = &m_cells[position & m_mask];
+        std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+        if (diff == 0)
+        {
+            if (m_pushPosition.compare_exchange_weak(position,
+                                                     position + 1,
+                                                     std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // the cell still holds the item of the previous round
+            return false;
+        }
+        else
+        {
+            position = m_pushPosition.load(std::memory_order_relaxed);
+        }
+    }
+    cell->item = item;
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool
+MpscQueue<T>::Pop(T& item)
+{
+    Cell* cell = &m_cells[m_popPosition & m_mask];
+    std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+    if (sequence != m_popPosition + 1)
+    {
+        return false;
+    }
+    item = cell->item;
+    // free the cell for the next round
+    cell->sequence.store(m_popPosition + m_mask + 1, std::memory_order_release);
+    m_popPosition++;
+    return true;
+}
+
+template <typename T>
+std::size_t
+MpscQueue<T>::GetCapacity() const
+{
+    return m_mask + 1;
+}
+
+} // namespace ns3
+
+#endif /* MPSC_QUEUE_H */
@@ -0,0 +1,758 @@
+#include "multithreaded-simulator-impl.h"
+
+#include "abort.h"
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+#include "simulator-context.h"
+#include "simulator.h"
+#include "uinteger.h"
+
+#include <algorithm>
+#include <limits>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+thread_local MultithreadedSimulatorImpl::Partition* MultithreadedSimulatorImpl::m_current = nullptr;
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultithreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<MultithreadedSimulatorImpl>()
+            .AddAttribute("Threads",
+                          "The number of partitions, each one run by its own thread, "
+                          "or 0 for the number of cores.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_threadsAttribute),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Lookahead",
+                          "The shortest delay of the events scheduled from a partition to "
+                          "another one. Required with more than one partition.",
+                          TimeValue(Time(0)),
+                          MakeTimeAccessor(&MultithreadedSimulatorImpl::m_lookahead),
+                          MakeTimeChecker());
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+    : m_threadCount(1),
+      m_threadsAttribute(0),
+      m_lookahead(0),
+      m_rank(1),
+      m_outsideRank(0),
+      m_outsideChildren(0),
+      m_uid(EventId::UID::VALID),
+      m_currentTs(0),
+      m_eventCount(0),
+      m_windowRank(0),
+      m_windowEnd(0),
+      m_endKey(),
+      m_window(0),
+      m_done(0),
+      m_exit(false),
+      m_stop(false),
+      m_running(false),
+      m_currentContext(Simulator::NO_CONTEXT)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_pending.empty())
+    {
+        m_pending.top().impl->Unref();
+        m_pending.pop();
+    }
+    m_destroyEvents.clear();
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    // run them in the order of the calls to Simulator::ScheduleDestroy()
+    std::stable_sort(m_destroyEvents.begin(),
+                     m_destroyEvents.end(),
+                     [](const DestroyEvent& a, const DestroyEvent& b) {
+                         return Compare(a.key, b.key) < 0;
+                     });
+    while (!m_destroyEvents.empty())
+    {
+        Ptr<EventImpl> ev = m_destroyEvents.front().id.PeekEventImpl();
+        m_destroyEvents.erase(m_destroyEvents.begin());
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    return 0;
+}
+
+void
+MultithreadedSimulatorImpl::SetPartition(uint32_t context, uint32_t partition)
+{
+    NS_LOG_FUNCTION(this << context << partition);
+    NS_ABORT_MSG_IF(m_running, "The partitions can not change while the simulation runs");
+    NS_ABORT_MSG_IF(context == Simulator::NO_CONTEXT,
+                    "The events without context do not belong to a partition");
+    m_partitions[context] = partition;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartition(uint32_t context) const
+{
+    if (context == Simulator::NO_CONTEXT)
+    {
+        return m_threadCount;
+    }
+    if (!m_partitions.empty())
+    {
+        auto it = m_partitions.find(context);
+        if (it != m_partitions.end())
+        {
+            return it->second % m_threadCount;
+        }
+    }
+    return context % m_threadCount;
+}
+
+MultithreadedSimulatorImpl::Key
+MultithreadedSimulatorImpl::MakeKey(uint64_t ts)
+{
+    Key key;
+    key.ts = ts;
+    if (m_current != nullptr)
+    {
+        key.rank = m_current->currentRank;
+        key.child = m_current->children++;
+        key.uid = m_current->uid++;
+        key.source = m_current->index;
+    }
+    else
+    {
+        // the events scheduled between two runs come after the events already run
+        if (m_outsideRank == 0)
+        {
+            m_outsideRank = m_rank++;
+            m_outsideChildren = 0;
+        }
+        key.rank = m_outsideRank;
+        key.child = m_outsideChildren++;
+        key.uid = m_uid++;
+        key.source = 0;
+    }
+    return key;
+}
+
+void
+MultithreadedSimulatorImpl::Insert(const Event& ev)
+{
+    if (!m_running)
+    {
+        m_pending.push(ev);
+        return;
+    }
+    NS_ABORT_MSG_IF(m_current == nullptr,
+                    "MultithreadedSimulatorImpl does not support the events scheduled from "
+                    "another thread while the simulation runs");
+    uint32_t partition = GetPartition(ev.context);
+    if (m_current->index == m_threadCount)
+    {
+        // an event without context, the partitions wait at the barrier
+        m_partitionList[partition]->events.push(ev);
+    }
+    else if (partition == m_current->index)
+    {
+        m_current->window.push(ev);
+    }
+    else
+    {
+        NS_ABORT_MSG_IF(ev.key.ts < m_windowEnd,
+                        "Event from context " << m_current->currentContext << " to context "
+                                              << ev.context << " at "
+                                              << TimeStep(ev.key.ts).As(Time::S)
+                                              << " before the end of the window at "
+                                              << TimeStep(m_windowEnd).As(Time::S)
+                                              << ": the delay is shorter than the Lookahead");
+        m_current->outbox.push_back(ev);
+    }
+}
+
+const MultithreadedSimulatorImpl::Event*
+MultithreadedSimulatorImpl::Peek(Queue& queue)
+{
+    while (!queue.empty())
+    {
+        const Event& top = queue.top();
+        if (!top.impl->IsCancelled())
+        {
+            return &top;
+        }
+        top.impl->Unref();
+        queue.pop();
+    }
+    return nullptr;
+}
+
+const MultithreadedSimulatorImpl::Event*
+MultithreadedSimulatorImpl::PeekNext(Partition& partition)
+{
+    const Event* events = Peek(partition.events);
+    const Event* window = Peek(partition.window);
+    if (events == nullptr || (window != nullptr && Compare(window->key, events->key) < 0))
+    {
+        return window;
+    }
+    return events;
+}
+
+void
+MultithreadedSimulatorImpl::Invoke(Partition& partition, const Event& ev, uint64_t rank)
+{
+    PreEventHook(EventId(ev.impl, ev.key.ts, ev.context, ev.key.uid));
+
+    partition.currentTs = ev.key.ts;
+    partition.currentContext = ev.context;
+    partition.currentRank = rank;
+    partition.children = 0;
+    partition.currentImpl = ev.impl;
+    ev.impl->Invoke();
+    // the identifiers of the event are expired from now on
+    ev.impl->Cancel();
+    partition.currentImpl = nullptr;
+    ev.impl->Unref();
+    partition.eventCount++;
+}
+
+void
+MultithreadedSimulatorImpl::RunWindow(Partition& partition)
+{
+    while (!m_stop.load(std::memory_order_relaxed))
+    {
+        const Event* next = PeekNext(partition);
+        if (next == nullptr || Compare(next->key, m_endKey) >= 0)
+        {
+            break;
+        }
+        Event ev = *next;
+        if (!partition.window.empty() && next == &partition.window.top())
+        {
+            partition.window.pop();
+        }
+        else
+        {
+            partition.events.pop();
+        }
+        NS_ASSERT(ev.key.ts >= partition.currentTs);
+
+        uint64_t rank = m_windowRank + partition.log.size();
+        partition.log.push_back({ev.key.ts, ev.key.rank, ev.key.child, ev.key.source, ev.context});
+        Invoke(partition, ev, rank);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::RunThread(Partition& partition, uint64_t window)
+{
+    SimulatorContext::SetPartition(partition.index);
+    m_current = &partition;
+    while (true)
+    {
+        uint64_t next;
+        while ((next = m_window.load(std::memory_order_acquire)) == window)
+        {
+            std::this_thread::yield();
+        }
+        window = next;
+        if (m_exit.load(std::memory_order_relaxed))
+        {
+            break;
+        }
+        RunWindow(partition);
+        m_done.fetch_add(1, std::memory_order_release);
+    }
+    m_current = nullptr;
+    SimulatorContext::SetPartition(SimulatorContext::NO_PARTITION);
+}
+
+void
+MultithreadedSimulatorImpl::Translate(Key& key) const
+{
+    if (key.rank >= m_windowRank)
+    {
+        key.rank = m_partitionList[key.source]->ranks[key.rank - m_windowRank];
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Merge()
+{
+    // rank the events of the window in the order of their keys: the partitions
+    // ran their own events in this order, so this is a merge of their logs
+    std::vector<std::size_t> next(m_threadCount, 0);
+    while (true)
+    {
+        Partition* first = nullptr;
+        Key firstKey{};
+        for (uint32_t i = 0; i < m_threadCount; i++)
+        {
+            Partition& partition = *m_partitionList[i];
+            if (next[i] == partition.log.size())
+            {
+                continue;
+            }
+            const Record& record = partition.log[next[i]];
+            Key key{record.ts, record.rank, record.child, 0, record.source};
+            Translate(key);
+            if (first == nullptr || Compare(key, firstKey) < 0)
+            {
+                first = &partition;
+                firstKey = key;
+            }
+        }
+        if (first == nullptr)
+        {
+            break;
+        }
+        const Record& record = first->log[next[first->index]++];
+        first->ranks.push_back(m_rank++);
+        m_currentTs = record.ts;
+        m_currentContext = record.context;
+    }
+
+    // replace the temporary ranks in the events scheduled during the window
+    for (uint32_t i = 0; i < m_threadCount; i++)
+    {
+        Partition& partition = *m_partitionList[i];
+        while (!partition.window.empty())
+        {
+            Event ev = partition.window.top();
+            partition.window.pop();
+            Translate(ev.key);
+            partition.events.push(ev);
+        }
+        for (Event& ev : partition.outbox)
+        {
+            Translate(ev.key);
+            m_partitionList[GetPartition(ev.context)]->events.push(ev);
+        }
+        for (DestroyEvent& ev : partition.destroy)
+        {
+            Translate(ev.key);
+            m_destroyEvents.push_back(ev);
+        }
+        m_eventCount += partition.eventCount;
+        partition.eventCount = 0;
+    }
+    for (uint32_t i = 0; i < m_threadCount; i++)
+    {
+        Partition& partition = *m_partitionList[i];
+        partition.outbox.clear();
+        partition.destroy.clear();
+        partition.log.clear();
+        partition.ranks.clear();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::RunGlobalEvents()
+{
+    Partition& global = *m_partitionList[m_threadCount];
+    while (!m_stop.load(std::memory_order_relaxed))
+    {
+        const Event* next = Peek(global.events);
+        if (next == nullptr)
+        {
+            return;
+        }
+        for (uint32_t i = 0; i < m_threadCount; i++)
+        {
+            const Event* head = PeekNext(*m_partitionList[i]);
+            if (head != nullptr && Compare(head->key, next->key) < 0)
+            {
+                return;
+            }
+        }
+        Event ev = *next;
+        global.events.pop();
+        Invoke(global, ev, m_rank++);
+        m_currentTs = ev.key.ts;
+        m_currentContext = ev.context;
+        m_eventCount += global.eventCount;
+        global.eventCount = 0;
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::StartWindow()
+{
+    const Event* global = Peek(m_partitionList[m_threadCount]->events);
+    uint64_t start = std::numeric_limits<uint64_t>::max();
+    for (uint32_t i = 0; i < m_threadCount; i++)
+    {
+        const Event* head = PeekNext(*m_partitionList[i]);
+        if (head != nullptr)
+        {
+            start = std::min(start, head->key.ts);
+        }
+    }
+    if (start == std::numeric_limits<uint64_t>::max())
+    {
+        return false;
+    }
+
+    if (global != nullptr)
+    {
+        m_endKey = global->key;
+    }
+    else
+    {
+        m_endKey = {std::numeric_limits<uint64_t>::max(),
+                    std::numeric_limits<uint64_t>::max(),
+                    std::numeric_limits<uint32_t>::max(),
+                    0,
+                    0};
+    }
+    if (m_threadCount > 1)
+    {
+        uint64_t lookahead = m_lookahead.GetTimeStep();
+        lookahead = std::min(lookahead, std::numeric_limits<uint64_t>::max() - start);
+        if (start + lookahead <= m_endKey.ts)
+        {
+            // the events of the other partitions can arrive from start + lookahead on,
+            // so the window ends before the first event of this time
+            m_endKey = {start + lookahead, 0, 0, 0, 0};
+        }
+    }
+    m_windowEnd = m_endKey.ts;
+    m_windowRank = m_rank;
+    return true;
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    if (m_stop.load(std::memory_order_relaxed))
+    {
+        return true;
+    }
+    if (!m_running)
+    {
+        return m_pending.empty();
+    }
+    for (const auto& partition : m_partitionList)
+    {
+        if (!partition->events.empty() || !partition->window.empty())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    m_threadCount = m_threadsAttribute;
+    if (m_threadCount == 0)
+    {
+        m_threadCount = std::clamp(std::thread::hardware_concurrency(),
+                                   1U,
+                                   SimulatorContext::MAX_PARTITIONS);
+    }
+    NS_ABORT_MSG_IF(m_threadCount > SimulatorContext::MAX_PARTITIONS,
+                    "MultithreadedSimulatorImpl supports up to "
+                        << SimulatorContext::MAX_PARTITIONS << " threads");
+    NS_ABORT_MSG_IF(m_threadCount > 1 && !m_lookahead.IsStrictlyPositive(),
+                    "MultithreadedSimulatorImpl needs a positive Lookahead with "
+                        << m_threadCount << " threads");
+    NS_ABORT_MSG_IF(m_threadCount > 1 && SimulatorContext::IsThreadLocal(),
+                    "MultithreadedSimulatorImpl can not run in several threads when each "
+                    "thread has its own simulation state");
+    NS_LOG_LOGIC("run " << m_threadCount << " partitions, lookahead " << m_lookahead);
+
+    m_stop = false;
+    m_running = true;
+    m_outsideRank = 0;
+    // the last partition holds the events without context
+    for (uint32_t i = 0; i <= m_threadCount; i++)
+    {
+        m_partitionList.push_back(std::make_unique<Partition>());
+        m_partitionList.back()->index = i;
+        m_partitionList.back()->currentTs = m_currentTs;
+    }
+    while (!m_pending.empty())
+    {
+        const Event& ev = m_pending.top();
+        m_partitionList[GetPartition(ev.context)]->events.push(ev);
+        m_pending.pop();
+    }
+
+    if (m_threadCount > 1)
+    {
+        SimulatorContext::SetParallel(true);
+        uint64_t window = m_window.load(std::memory_order_relaxed);
+        for (uint32_t i = 1; i < m_threadCount; i++)
+        {
+            m_threads.emplace_back(&MultithreadedSimulatorImpl::RunThread,
+                                   this,
+                                   std::ref(*m_partitionList[i]),
+                                   window);
+        }
+    }
+
+    Partition& global = *m_partitionList[m_threadCount];
+    Partition& first = *m_partitionList[0];
+    m_current = &global;
+    while (true)
+    {
+        RunGlobalEvents();
+        if (m_stop.load(std::memory_order_relaxed) || !StartWindow())
+        {
+            break;
+        }
+
+        m_current = &first;
+        SimulatorContext::SetPartition(first.index);
+        m_window.fetch_add(1, std::memory_order_release);
+        RunWindow(first);
+        while (m_done.load(std::memory_order_acquire) != m_threadCount - 1)
+        {
+            std::this_thread::yield();
+        }
+        m_done.store(0, std::memory_order_relaxed);
+        SimulatorContext::SetPartition(SimulatorContext::NO_PARTITION);
+        m_current = &global;
+
+        Merge();
+    }
+    m_current = nullptr;
+
+    if (m_threadCount > 1)
+    {
+        m_exit.store(true, std::memory_order_relaxed);
+        m_window.fetch_add(1, std::memory_order_release);
+        for (auto& thread : m_threads)
+        {
+            thread.join();
+        }
+        m_threads.clear();
+        m_exit.store(false, std::memory_order_relaxed);
+        SimulatorContext::SetParallel(false);
+    }
+
+    // keep the events left for the next run, which may have other partitions
+    for (const auto& partition : m_partitionList)
+    {
+        while (!partition->events.empty())
+        {
+            m_pending.push(partition->events.top());
+            partition->events.pop();
+        }
+    }
+    m_partitionList.clear();
+    m_running = false;
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    m_stop.store(true, std::memory_order_relaxed);
+}
+
+void
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    Simulator::Schedule(delay, &Simulator::Stop);
+}
+
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep() << event);
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+
+    Event ev;
+    ev.impl = event;
+    ev.key = MakeKey(Now().GetTimeStep() + delay.GetTimeStep());
+    ev.context = GetContext();
+    Insert(ev);
+    return EventId(event, ev.key.ts, ev.context, ev.key.uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << context << delay.GetTimeStep() << event);
+
+    Event ev;
+    ev.impl = event;
+    ev.key = MakeKey(Now().GetTimeStep() + delay.GetTimeStep());
+    ev.context = context;
+    Insert(ev);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    NS_ABORT_MSG_IF(m_running && m_current == nullptr,
+                    "MultithreadedSimulatorImpl does not support the events scheduled from "
+                    "another thread while the simulation runs");
+    EventId id(Ptr<EventImpl>(event, false), Now().GetTimeStep(), 0xffffffff, 2);
+    DestroyEvent ev{MakeKey(0), id};
+    if (m_current != nullptr && m_current->index != m_threadCount)
+    {
+        m_current->destroy.push_back(ev);
+    }
+    else
+    {
+        m_destroyEvents.push_back(ev);
+    }
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    return TimeStep(m_current != nullptr ? m_current->currentTs : m_currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    return TimeStep(id.GetTs()) - Now();
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        auto remove = [&id](std::vector<DestroyEvent>& events) {
+            auto it = std::find_if(events.begin(), events.end(), [&id](const DestroyEvent& ev) {
+                return ev.id == id;
+            });
+            if (it == events.end())
+            {
+                return false;
+            }
+            events.erase(it);
+            return true;
+        };
+        if (m_current == nullptr || !remove(m_current->destroy))
+        {
+            remove(m_destroyEvents);
+        }
+        return;
+    }
+    if (IsExpired(id))
+    {
+        return;
+    }
+    // the event stays in its queue until its turn, which can be in another partition
+    id.PeekEventImpl()->Cancel();
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+    {
+        return true;
+    }
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        auto found = [&id](const std::vector<DestroyEvent>& events) {
+            return std::any_of(events.begin(), events.end(), [&id](const DestroyEvent& ev) {
+                return ev.id == id;
+            });
+        };
+        return !found(m_destroyEvents) && (m_current == nullptr || !found(m_current->destroy));
+    }
+    // the events which ran are cancelled, except the current one
+    return m_current != nullptr && id.PeekEventImpl() == m_current->currentImpl;
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    return m_current != nullptr ? m_current->currentContext : m_currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    return m_eventCount;
+}
+
+} // namespace ns3
@@ -0,0 +1,341 @@
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "nstime.h"
+#include "simulator-impl.h"
+
+#include <atomic>
+#include <memory>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup simulator
+ * \brief Conservative parallel simulator implementation, on the threads of one process.
+ *
+ * The contexts of the events, that is the nodes, are split in partitions,
+ * and each partition runs its events in its own thread. The threads run in
+ * windows of simulation time: from the earliest pending event at \f$T\f$,
+ * every partition runs its events before \f$T + L\f$, where \f$L\f$ is the
+ * lookahead, then the threads meet at a barrier. An event of a partition
+ * can schedule an event in another partition only at \f$T + L\f$ or later,
+ * so the partitions of a window do not depend on each other. With a
+ * YansWifiChannel, \f$L\f$ is the shortest propagation delay between the
+ * nodes of two partitions, see YansWifiChannel::GetMinimumDelay().
+ *
+ * The simulation runs the events in exactly the order of
+ * DefaultSimulatorImpl, whatever the number of threads: the events of the
+ * same time run in the order they were scheduled. Each event is ranked by
+ * the position of its run in this order, and the events it schedules are
+ * ordered by this rank, then by their order of scheduling. The ranks of the
+ * events of a window are only known at the barrier, where the logs of the
+ * partitions are merged, so the events scheduled during a window get
+ * temporary ranks, which are replaced at the barrier.
+ *
+ * The events without context (Simulator::NO_CONTEXT), for instance the
+ * events scheduled with Simulator::Schedule before Simulator::Run, run at
+ * the barrier in the main thread, while the partitions wait: they can
+ * access the state of all the nodes.
+ *
+ * The model code run by the partitions must not share mutable state
+ * between nodes of different partitions, except through the events
+ * scheduled with Simulator::ScheduleWithContext. While more than one thread
+ * runs, the reference counts of SimpleRefCount are updated atomically and
+ * the packets copy their shared buffers before writing them, see
+ * SimulatorContext::IsParallel().
+ *
+ * Limitations:
+ * - the events scheduled from another thread than the simulation threads
+ *   while the simulation runs are not supported;
+ * - Simulator::Stop() called by an event of a partition stops the
+ *   simulation at the end of the window, the events without context stop it
+ *   immediately;
+ * - Simulator::GetEventCount() is updated at the end of each window;
+ * - an event is cancelled once it ran, so its EventImpl cannot be
+ *   scheduled again;
+ * - the uids of the packets created by the partitions differ from those of
+ *   a sequential simulation, see Packet::GetUid();
+ * - the scheduler is not configurable: SetScheduler() is ignored.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // Inherited
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    void Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * Assign a context to a partition.
+     *
+     * By default, the partition of a context is the context modulo the
+     * number of partitions. The assignment must be done before
+     * Simulator::Run(), and the partitions greater than the number of
+     * threads are taken modulo this number.
+     *
+     * \param [in] context The context, usually a node id.
+     * \param [in] partition The partition.
+     */
+    void SetPartition(uint32_t context, uint32_t partition);
+
+    /**
+     * \param [in] context A context.
+     * \return The partition of the context, or the number of partitions
+     *         for Simulator::NO_CONTEXT.
+     */
+    uint32_t GetPartition(uint32_t context) const;
+
+  private:
+    void DoDispose() override;
+
+    /** Order of the events. */
+    struct Key
+    {
+        uint64_t ts;     //!< Timestamp of the event
+        uint64_t rank;   //!< Rank of the event which scheduled it
+        uint32_t child;  //!< Order of the event among those scheduled by the same event
+        uint32_t uid;    //!< The uid in the EventId of the event
+        uint32_t source; //!< Partition of the event which scheduled it, to replace its rank
+    };
+
+    /** An event in a queue. */
+    struct Event
+    {
+        Key key;          //!< The order of the event
+        uint32_t context; //!< The context of the event
+        EventImpl* impl;  //!< The event, with a reference
+    };
+
+    /** Order the queues of events, the earliest on top. */
+    struct Later
+    {
+        /**
+         * \param [in] a An event.
+         * \param [in] b Another event.
+         * \return \c true if \pname{a} runs after \pname{b}.
+         */
+        bool operator()(const Event& a, const Event& b) const
+        {
+            return Compare(a.key, b.key) > 0;
+        }
+    };
+
+    /** A queue of events. */
+    typedef std::priority_queue<Event, std::vector<Event>, Later> Queue;
+
+    /** An event run during a window, to be ranked at the barrier. */
+    struct Record
+    {
+        uint64_t ts;      //!< Timestamp of the event
+        uint64_t rank;    //!< Rank of the event which scheduled it, maybe temporary
+        uint32_t child;   //!< Order of the event among those scheduled by the same event
+        uint32_t source;  //!< Partition of the event which scheduled it
+        uint32_t context; //!< Context of the event
+    };
+
+    /** An event to run at Simulator::Destroy(). */
+    struct DestroyEvent
+    {
+        Key key;    //!< The order of the event
+        EventId id; //!< The event
+    };
+
+    /** The state of a partition. */
+    struct alignas(64) Partition
+    {
+        uint32_t index;                      //!< Index of the partition
+        Queue events;                        //!< Events of the previous windows
+        Queue window;                        //!< Events scheduled during this window
+        std::vector<Event> outbox;           //!< Events for other partitions
+        std::vector<Record> log;             //!< Events run during this window
+        std::vector<uint64_t> ranks;         //!< Ranks of the events of the log
+        std::vector<DestroyEvent> destroy;   //!< Events to run at Simulator::Destroy()
+        uint64_t currentTs{0};               //!< Timestamp of the current event
+        uint64_t currentRank{0};             //!< Rank of the current event, maybe temporary
+        uint32_t currentContext{0xffffffff}; //!< Context of the current event
+        uint32_t children{0};                //!< Events scheduled by the current event
+        uint32_t uid{EventId::UID::VALID};   //!< Next uid of the EventIds
+        EventImpl* currentImpl{nullptr};     //!< The current event
+        uint64_t eventCount{0};              //!< Number of events run
+    };
+
+    /**
+     * Compare the order of two events.
+     * \param [in] a An event.
+     * \param [in] b Another event.
+     * \return A negative value if \pname{a} runs before \pname{b}, a positive
+     *         value if it runs after, zero if they are the same.
+     */
+    static int Compare(const Key& a, const Key& b)
+    {
+        if (a.ts != b.ts)
+        {
+            return a.ts < b.ts ? -1 : 1;
+        }
+        if (a.rank != b.rank)
+        {
+            return a.rank < b.rank ? -1 : 1;
+        }
+        return a.child < b.child ? -1 : (a.child > b.child ? 1 : 0);
+    }
+
+    /**
+     * Get the key of a new event, scheduled by the current event.
+     * \param [in] ts The timestamp of the new event.
+     * \return The key.
+     */
+    Key MakeKey(uint64_t ts);
+    /**
+     * Insert an event in its queue.
+     * \param [in] ev The event.
+     */
+    void Insert(const Event& ev);
+    /**
+     * Run an event.
+     * \param [in,out] partition The partition of the event.
+     * \param [in] ev The event.
+     * \param [in] rank The rank of the event, maybe temporary.
+     */
+    void Invoke(Partition& partition, const Event& ev, uint64_t rank);
+    /**
+     * Run the events of a partition in the current window.
+     * \param [in] partition The partition.
+     */
+    void RunWindow(Partition& partition);
+    /**
+     * Body of the thread of a partition.
+     * \param [in] partition The partition.
+     * \param [in] window The number of the window before the first one of the thread.
+     */
+    void RunThread(Partition& partition, uint64_t window);
+    /**
+     * Rank the events of the window, and replace the temporary ranks.
+     * Called at the barrier.
+     */
+    void Merge();
+    /**
+     * Replace a temporary rank.
+     * \param [in,out] key The key with the rank.
+     */
+    void Translate(Key& key) const;
+    /**
+     * Run the events without context which come before the events of the
+     * partitions. Called at the barrier.
+     */
+    void RunGlobalEvents();
+    /**
+     * Compute the next window.
+     * \return \c true if there are events to run.
+     */
+    bool StartWindow();
+    /**
+     * Remove the cancelled events at the top of a queue.
+     * \param [in,out] queue The queue.
+     * \return The top of the queue, or \c nullptr if it is empty.
+     */
+    static const Event* Peek(Queue& queue);
+    /**
+     * \param [in] partition A partition.
+     * \return The next event of the partition, or \c nullptr if there is none.
+     */
+    const Event* PeekNext(Partition& partition);
+
+    /** Partitions of the contexts assigned with SetPartition(). */
+    std::unordered_map<uint32_t, uint32_t> m_partitions;
+    /** The partitions of the current run, the last one for the events without context. */
+    std::vector<std::unique_ptr<Partition>> m_partitionList;
+    /** Threads of the partitions other than the first one. */
+    std::vector<std::thread> m_threads;
+    /** Number of partitions of the current run. */
+    uint32_t m_threadCount;
+    /** Number of threads, zero for the number of cores. */
+    uint32_t m_threadsAttribute;
+    /** The lookahead between the partitions. */
+    Time m_lookahead;
+
+    /** Events before the first call to Run(), or between two calls. */
+    Queue m_pending;
+    /** Events to run at Simulator::Destroy(), scheduled outside Run(). */
+    std::vector<DestroyEvent> m_destroyEvents;
+
+    /** Rank of the next event run. */
+    uint64_t m_rank;
+    /** Rank of the events scheduled outside Run(), or zero before the first one. */
+    uint64_t m_outsideRank;
+    /** Order of the next event scheduled outside Run(). */
+    uint32_t m_outsideChildren;
+    /** Next uid of the EventIds of the events scheduled outside Run(). */
+    uint32_t m_uid;
+    /** Timestamp of the last event run. */
+    uint64_t m_currentTs;
+    /** The event count, updated at the end of each window. */
+    uint64_t m_eventCount;
+
+    /** Rank of the first event of the window. */
+    uint64_t m_windowRank;
+    /** End of the window: the events of the partitions run before this time. */
+    uint64_t m_windowEnd;
+    /**
+     * The partitions run the events before this key: the next event without
+     * context, or the first event at the end of the lookahead.
+     */
+    Key m_endKey;
+    /** Number of the current window, the threads start when it changes. */
+    std::atomic<uint64_t> m_window;
+    /** Number of threads which finished the window. */
+    std::atomic<uint32_t> m_done;
+    /** Flag \c true when the threads exit. */
+    std::atomic<bool> m_exit;
+    /** Flag calling for the end of the simulation. */
+    std::atomic<bool> m_stop;
+    /** Flag \c true during Run(). */
+    bool m_running;
+
+    /** Context of the last event run. */
+    uint32_t m_currentContext;
+
+    /** The partition which runs on the calling thread, or \c nullptr outside Run(). */
+    static thread_local Partition* m_current;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
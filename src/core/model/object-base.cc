@@ -27,6 +27,10 @@
 
 #include "ns3/core-config.h"
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 /**
  * \file
  * \ingroup object
@@ -81,107 +85,162 @@ ObjectBase::NotifyConstructionCompleted()
     NS_LOG_FUNCTION(this);
 }
 
-void
-ObjectBase::ConstructSelf(const AttributeConstructionList& attributes)
+/**
+ * \ingroup object
+ * The attributes which ObjectBase::ConstructSelf() sets on the objects of a
+ * TypeId, resolved once for the TypeId.
+ */
+struct ConstructionPlan
 {
-    // loop over the inheritance tree back to the Object base class.
-    NS_LOG_FUNCTION(this << &attributes);
-    TypeId tid = GetInstanceTypeId();
+    /** An attribute of the TypeId or of one of its parents. */
+    struct Item
+    {
+        TypeId tid;                                 //!< The TypeId which registered the attribute
+        const TypeId::AttributeInformation* info;   //!< The attribute
+        Ptr<const AttributeValue> environmentValue; //!< Value from NS_ATTRIBUTE_DEFAULT, if any
+    };
+
+    /** The NS_ATTRIBUTE_DEFAULT dictionary used to resolve the environment values. */
+    std::shared_ptr<EnvironmentVariable::Dictionary> environment;
+    /** The attributes, from the TypeId to its oldest parent. */
+    std::vector<Item> items;
+};
+
+/**
+ * \ingroup object
+ * Get the construction plan of a TypeId, and build it on first use.
+ *
+ * The plans are cached per thread, and rebuilt if the NS_ATTRIBUTE_DEFAULT
+ * dictionary changes. The items point to the attribute information in the
+ * TypeId database, so the initial values changed with Config::SetDefault()
+ * after the plan is built are still honored.
+ *
+ * \param [in] tid The TypeId of the object to construct.
+ * \returns The plan.
+ */
+static std::shared_ptr<const ConstructionPlan>
+GetConstructionPlan(TypeId tid)
+{
+    thread_local std::unordered_map<uint16_t, std::shared_ptr<const ConstructionPlan>> plans;
+
+    auto environment = EnvironmentVariable::GetDictionary("NS_ATTRIBUTE_DEFAULT");
+    uint16_t uid = tid.GetUid();
+    auto it = plans.find(uid);
+    if (it != plans.end() && it->second->environment == environment)
+    {
+        return it->second;
+    }
+
+    auto plan = std::make_shared<ConstructionPlan>();
+    plan->environment = environment;
     do // Do this tid and all parents
     {
-        // loop over all attributes in object type
-        NS_LOG_DEBUG("construct tid=" << tid.GetName() << ", params=" << tid.GetAttributeN());
-        for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+        for (std::size_t i = 0; i < tid.GetAttributeN(); i++)
         {
-            TypeId::AttributeInformation info = tid.GetAttribute(i);
-            NS_LOG_DEBUG("try to construct \"" << tid.GetName() << "::" << info.name << "\"");
-            // is this attribute stored in this AttributeConstructionList instance ?
-            Ptr<const AttributeValue> value = attributes.Find(info.checker);
-            std::string where = "argument";
-
-            // See if this attribute should not be set here in the
-            // constructor.
-            if (!(info.flags & TypeId::ATTR_CONSTRUCT))
+            const TypeId::AttributeInformation& info = tid.PeekAttribute(i);
+            Ptr<const AttributeValue> environmentValue;
+            auto [found, value] = environment->Get(tid.GetAttributeFullName(i));
+            if (found)
             {
-                // Handle this attribute if it should not be
-                // set here.
-                if (!value)
-                {
-                    // Skip this attribute if it's not in the
-                    // AttributeConstructionList.
-                    NS_LOG_DEBUG("skipping, not settable at construction");
-                    continue;
-                }
-                else
-                {
-                    // This is an error because this attribute is not
-                    // settable in its constructor but is present in
-                    // the AttributeConstructionList.
-                    NS_FATAL_ERROR("Attribute name="
-                                   << info.name << " tid=" << tid.GetName()
-                                   << ": initial value cannot be set using attributes");
-                }
+                environmentValue = Create<StringValue>(value);
             }
+            plan->items.push_back({tid, &info, environmentValue});
+        }
+        tid = tid.GetParent();
+    } while (tid != ObjectBase::GetTypeId());
 
-            if (!value)
-            {
-                NS_LOG_DEBUG("trying to set from environment variable NS_ATTRIBUTE_DEFAULT");
-                auto [found, val] =
-                    EnvironmentVariable::Get("NS_ATTRIBUTE_DEFAULT", tid.GetAttributeFullName(i));
-                if (found)
-                {
-                    NS_LOG_DEBUG("found in environment: " << val);
-                    value = Create<StringValue>(val);
-                    where = "env var";
-                }
-            }
+    plans[uid] = plan;
+    return plan;
+}
 
-            bool initial{false};
-            if (!value)
-            {
-                // This is guaranteed to exist
-                NS_LOG_DEBUG("falling back to initial value from tid");
-                value = info.initialValue;
-                where = "initial value";
-                initial = true;
-            }
+void
+ObjectBase::ConstructSelf(const AttributeConstructionList& attributes)
+{
+    // loop over the attributes of the inheritance tree back to the Object base class.
+    NS_LOG_FUNCTION(this << &attributes);
+    std::shared_ptr<const ConstructionPlan> plan = GetConstructionPlan(GetInstanceTypeId());
+    for (const auto& [tid, info, environmentValue] : plan->items)
+    {
+        NS_LOG_DEBUG("try to construct \"" << tid.GetName() << "::" << info->name << "\"");
+        // is this attribute stored in this AttributeConstructionList instance ?
+        Ptr<const AttributeValue> value = attributes.Find(info->checker);
+        const char* where = "argument";
 
-            // We have a matching attribute value, if only from the initialValue
-            if (DoSet(info.accessor, info.checker, *value) || initial)
+        // See if this attribute should not be set here in the
+        // constructor.
+        if (!(info->flags & TypeId::ATTR_CONSTRUCT))
+        {
+            // Handle this attribute if it should not be
+            // set here.
+            if (!value)
             {
-                // Setting from initial value may fail, e.g. setting
-                // ObjectVectorValue from ""
-                // That's ok, so we still report success since construction is complete
-                NS_LOG_DEBUG("construct \"" << tid.GetName() << "::" << info.name << "\" from "
-                                            << where);
+                // Skip this attribute if it's not in the
+                // AttributeConstructionList.
+                NS_LOG_DEBUG("skipping, not settable at construction");
+                continue;
             }
             else
             {
-                /*
-                  One would think this is an error...
-
-                  but there are cases where `attributes.Find(info.checker)`
-                  returns a non-null value which still fails the `DoSet()` call.
-                  For example, `value` is sometimes a real `PointerValue`
-                  containing 0 as the pointed-to address.  Since value
-                  is not null (it just contains null) the initial
-                  value is not used, the DoSet fails, and we end up
-                  here.
-
-                  If we were adventurous we might try to fix this deep
-                  below DoSet, but there be dragons.
-                */
-                /*
-                NS_ASSERT_MSG(false,
-                              "Failed to set attribute '" << info.name << "' from '"
-                                                          << value->SerializeToString(info.checker)
-                                                          << "'");
-                */
+                // This is an error because this attribute is not
+                // settable in its constructor but is present in
+                // the AttributeConstructionList.
+                NS_FATAL_ERROR("Attribute name="
+                               << info->name << " tid=" << tid.GetName()
+                               << ": initial value cannot be set using attributes");
             }
+        }
 
-        } // for i attributes
-        tid = tid.GetParent();
-    } while (tid != ObjectBase::GetTypeId());
+        if (!value && environmentValue)
+        {
+            NS_LOG_DEBUG("found in environment variable NS_ATTRIBUTE_DEFAULT");
+            value = environmentValue;
+            where = "env var";
+        }
+
+        bool initial{false};
+        if (!value)
+        {
+            // This is guaranteed to exist
+            NS_LOG_DEBUG("falling back to initial value from tid");
+            value = info->initialValue;
+            where = "initial value";
+            initial = true;
+        }
+
+        // We have a matching attribute value, if only from the initialValue
+        if (DoSet(info->accessor, info->checker, *value) || initial)
+        {
+            // Setting from initial value may fail, e.g. setting
+            // ObjectVectorValue from ""
+            // That's ok, so we still report success since construction is complete
+            NS_LOG_DEBUG("construct \"" << tid.GetName() << "::" << info->name << "\" from "
+                                        << where);
+        }
+        else
+        {
+            /*
+              One would think this is an error...
+
+              but there are cases where `attributes.Find(info.checker)`
+              returns a non-null value which still fails the `DoSet()` call.
+              For example, `value` is sometimes a real `PointerValue`
+              containing 0 as the pointed-to address.  Since value
+              is not null (it just contains null) the initial
+              value is not used, the DoSet fails, and we end up
+              here.
+
+              If we were adventurous we might try to fix this deep
+              below DoSet, but there be dragons.
+            */
+            /*
+            NS_ASSERT_MSG(false,
+                          "Failed to set attribute '" << info.name << "' from '"
+                                                      << value->SerializeToString(info.checker)
+                                                      << "'");
+            */
+        }
+
+    }
     NotifyConstructionCompleted();
 }
 
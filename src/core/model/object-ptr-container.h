@@ -233,6 +233,24 @@ class ObjectPtrContainerAccessor : public AttributeAccessor
     bool HasGetter() const override;
     bool HasSetter() const override;
 
+    /**
+     * Get the number of instances in the container.
+     *
+     * \param [in] object The container object.
+     * \param [out] n The number of instances in the container.
+     * \returns true if the value could be obtained successfully.
+     */
+    bool GetN(const ObjectBase* object, std::size_t* n) const;
+    /**
+     * Get one instance from the container, without getting the others.
+     *
+     * \param [in] object The container object.
+     * \param [in] i The position of the instance, less than the number of instances.
+     * \param [out] index The index of the instance.
+     * \returns The instance.
+     */
+    Ptr<Object> Get(const ObjectBase* object, std::size_t i, std::size_t* index) const;
+
   private:
     /**
      * Get the number of instances in the container.
@@ -0,0 +1,192 @@
+#include "quad-heap-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::QuadHeapScheduler class.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("QuadHeapScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(QuadHeapScheduler);
+
+TypeId
+QuadHeapScheduler::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::QuadHeapScheduler")
+                            .SetParent<Scheduler>()
+                            .SetGroupName("Core")
+                            .AddConstructor<QuadHeapScheduler>();
+    return tid;
+}
+
+QuadHeapScheduler::QuadHeapScheduler()
+{
+    NS_LOG_FUNCTION(this);
+    static_assert(sizeof(KeyLine) == 64, "The keys of the children should fill a cache line");
+    m_events.resize(ROOT, nullptr);
+    m_keys.resize(1);
+}
+
+QuadHeapScheduler::~QuadHeapScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+Scheduler::EventKey&
+QuadHeapScheduler::Key(std::size_t slot)
+{
+    return m_keys[slot / FANOUT].keys[slot % FANOUT];
+}
+
+std::size_t
+QuadHeapScheduler::Parent(std::size_t slot) const
+{
+    return slot / FANOUT + ROOT - 1;
+}
+
+std::size_t
+QuadHeapScheduler::FirstChild(std::size_t slot) const
+{
+    return (slot - ROOT + 1) * FANOUT;
+}
+
+void
+QuadHeapScheduler::Store(std::size_t slot, const Scheduler::EventKey& key, EventImpl* impl)
+{
+    Key(slot) = key;
+    m_events[slot] = impl;
+    impl->SetSchedulerIndex(slot);
+}
+
+void
+QuadHeapScheduler::SiftUp(std::size_t slot, Scheduler::EventKey key, EventImpl* impl)
+{
+    while (slot != ROOT)
+    {
+        std::size_t parent = Parent(slot);
+        if (!(key < Key(parent)))
+        {
+            break;
+        }
+        Store(slot, Key(parent), m_events[parent]);
+        slot = parent;
+    }
+    Store(slot, key, impl);
+}
+
+void
+QuadHeapScheduler::SiftDown(std::size_t slot, Scheduler::EventKey key, EventImpl* impl)
+{
+    std::size_t end = m_events.size();
+    while (true)
+    {
+        std::size_t first = FirstChild(slot);
+        if (first >= end)
+        {
+            break;
+        }
+        std::size_t last = std::min(first + FANOUT, end);
+        std::size_t smallest = first;
+        for (std::size_t child = first + 1; child < last; child++)
+        {
+            if (Key(child) < Key(smallest))
+            {
+                smallest = child;
+            }
+        }
+        if (!(Key(smallest) < key))
+        {
+            break;
+        }
+        Store(slot, Key(smallest), m_events[smallest]);
+        slot = smallest;
+    }
+    Store(slot, key, impl);
+}
+
+void
+QuadHeapScheduler::Insert(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << &ev);
+    std::size_t slot = m_events.size();
+    m_events.push_back(nullptr);
+    if (slot / FANOUT >= m_keys.size())
+    {
+        m_keys.emplace_back();
+    }
+    SiftUp(slot, ev.key, ev.impl);
+}
+
+bool
+QuadHeapScheduler::IsEmpty() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_events.size() == ROOT;
+}
+
+Scheduler::Event
+QuadHeapScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    return Event{m_events[ROOT], m_keys[ROOT / FANOUT].keys[ROOT % FANOUT]};
+}
+
+Scheduler::Event
+QuadHeapScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    Event next{m_events[ROOT], Key(ROOT)};
+    std::size_t last = m_events.size() - 1;
+    EventImpl* impl = m_events[last];
+    m_events.pop_back();
+    if (last != ROOT)
+    {
+        SiftDown(ROOT, Key(last), impl);
+    }
+    return next;
+}
+
+void
+QuadHeapScheduler::Remove(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << &ev);
+    std::size_t slot = ev.impl->GetSchedulerIndex();
+    NS_ASSERT_MSG(slot < m_events.size() && m_events[slot] == ev.impl,
+                  "Event " << ev.key.m_uid << " not in the heap");
+    std::size_t last = m_events.size() - 1;
+    EventImpl* impl = m_events[last];
+    m_events.pop_back();
+    if (slot != last)
+    {
+        // move the last event to the free slot, up or down
+        Scheduler::EventKey key = Key(last);
+        if (slot != ROOT && key < Key(Parent(slot)))
+        {
+            SiftUp(slot, key, impl);
+        }
+        else
+        {
+            SiftDown(slot, key, impl);
+        }
+    }
+}
+
+bool
+QuadHeapScheduler::IsRemoveCheap() const
+{
+    return true;
+}
+
+} // namespace ns3
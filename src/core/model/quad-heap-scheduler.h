@@ -0,0 +1,137 @@
+#ifndef QUAD_HEAP_SCHEDULER_H
+#define QUAD_HEAP_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * ns3::QuadHeapScheduler declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup scheduler
+ * \brief a 4-ary heap event scheduler with an index of the events
+ *
+ * The events are kept in a 4-ary heap, in contiguous storage. The keys
+ * and the events are stored in two separate arrays, and the array of the
+ * keys is laid out so that the four children of a node share one cache
+ * line: finding the smallest child costs a single cache miss, and the heap
+ * is half as deep as a binary heap.
+ *
+ * The slot of each event in the heap is stored back in its EventImpl,
+ * so that Remove() does not search the heap. Since removing an event is
+ * cheap, the simulator removes the cancelled events right away instead of
+ * leaving them in the heap until they expire, which keeps the heap small
+ * in workloads which cancel and reschedule most of their events, such as
+ * timers.
+ *
+ * \par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | Logarithmic     | Heapify
+ * IsEmpty()    | Constant        | Explicit queue size
+ * PeekNext()   | Constant        | Heap kept sorted
+ * Remove()     | Logarithmic     | Index, heapify
+ * RemoveNext() | Logarithmic     | Heapify
+ *
+ * \par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | 6 x `sizeof (*)`<br/>(48 bytes)  | two `std::vector`
+ * Per Event | 0                                | Events stored in `std::vector` directly
+ */
+class QuadHeapScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  \return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    QuadHeapScheduler();
+    /** Destructor. */
+    ~QuadHeapScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+    bool IsRemoveCheap() const override;
+
+  private:
+    /** Number of children of a node. */
+    static constexpr std::size_t FANOUT = 4;
+    /**
+     * Slot of the root. The slots before it are not used, so that the
+     * children of a node start on a cache line.
+     */
+    static constexpr std::size_t ROOT = 3;
+
+    /** The keys of the children of a node, in one cache line. */
+    struct alignas(64) KeyLine
+    {
+        Scheduler::EventKey keys[FANOUT]; //!< Keys of the slots of the line
+    };
+
+    /**
+     * \param [in] slot A slot of the heap.
+     * \return The key of the event in the slot.
+     */
+    inline Scheduler::EventKey& Key(std::size_t slot);
+    /**
+     * \param [in] slot A slot of the heap, other than the root.
+     * \return The slot of its parent.
+     */
+    inline std::size_t Parent(std::size_t slot) const;
+    /**
+     * \param [in] slot A slot of the heap.
+     * \return The slot of its first child.
+     */
+    inline std::size_t FirstChild(std::size_t slot) const;
+    /**
+     * Store an event in a slot, and record the slot in the event.
+     *
+     * \param [in] slot The slot.
+     * \param [in] key The key of the event.
+     * \param [in] impl The event.
+     */
+    inline void Store(std::size_t slot, const Scheduler::EventKey& key, EventImpl* impl);
+    /**
+     * Move an event up from an empty slot to its position.
+     *
+     * \param [in] slot The empty slot.
+     * \param [in] key The key of the event.
+     * \param [in] impl The event.
+     */
+    void SiftUp(std::size_t slot, Scheduler::EventKey key, EventImpl* impl);
+    /**
+     * Move an event down from an empty slot to its position.
+     *
+     * \param [in] slot The empty slot.
+     * \param [in] key The key of the event.
+     * \param [in] impl The event.
+     */
+    void SiftDown(std::size_t slot, Scheduler::EventKey key, EventImpl* impl);
+
+    /** The keys, by slot. */
+    std::vector<KeyLine> m_keys;
+    /** The events, by slot: the first unused slot is the size of this array. */
+    std::vector<EventImpl*> m_events;
+};
+
+} // namespace ns3
+
+#endif /* QUAD_HEAP_SCHEDULER_H */
@@ -0,0 +1,109 @@
+#include "restartable-timer.h"
+
+#include "log.h"
+#include "simulator.h"
+
+/**
+ * \file
+ * \ingroup timer
+ * ns3::RestartableTimer timer class implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("RestartableTimer");
+
+RestartableTimer::RestartableTimer()
+    : m_impl(nullptr),
+      m_event(),
+      m_end(),
+      m_running(false),
+      m_nScheduled(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+RestartableTimer::~RestartableTimer()
+{
+    NS_LOG_FUNCTION(this);
+    m_event.Cancel();
+    delete m_impl;
+}
+
+void
+RestartableTimer::Schedule(Time delay)
+{
+    NS_LOG_FUNCTION(this << delay);
+    NS_ASSERT_MSG(m_impl != nullptr, "You cannot schedule a RestartableTimer without function.");
+    m_end = Simulator::Now() + delay;
+    m_running = true;
+    if (m_event.IsRunning())
+    {
+        if (Simulator::GetDelayLeft(m_event) <= delay)
+        {
+            // the pending event fires first and moves to the new deadline
+            return;
+        }
+        m_event.Cancel();
+    }
+    m_event = Simulator::Schedule(delay, &RestartableTimer::Expire, this);
+    m_nScheduled++;
+}
+
+void
+RestartableTimer::Cancel()
+{
+    NS_LOG_FUNCTION(this);
+    // the pending event is left in the simulator, it may be reused by the next Schedule
+    m_running = false;
+}
+
+bool
+RestartableTimer::IsRunning() const
+{
+    return m_running;
+}
+
+bool
+RestartableTimer::IsExpired() const
+{
+    return !m_running;
+}
+
+Time
+RestartableTimer::GetDelayLeft() const
+{
+    if (!m_running)
+    {
+        return Seconds(0);
+    }
+    return m_end - Simulator::Now();
+}
+
+uint64_t
+RestartableTimer::GetNScheduled() const
+{
+    return m_nScheduled;
+}
+
+void
+RestartableTimer::Expire()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_running)
+    {
+        return;
+    }
+    Time now = Simulator::Now();
+    if (m_end > now)
+    {
+        m_event = Simulator::Schedule(m_end - now, &RestartableTimer::Expire, this);
+        m_nScheduled++;
+        return;
+    }
+    m_running = false;
+    m_impl->Invoke();
+}
+
+} // namespace ns3
@@ -0,0 +1,173 @@
+#ifndef RESTARTABLE_TIMER_H
+#define RESTARTABLE_TIMER_H
+
+#include "event-id.h"
+#include "fatal-error.h"
+#include "nstime.h"
+
+/**
+ * \file
+ * \ingroup timer
+ * ns3::RestartableTimer timer class declaration.
+ */
+
+namespace ns3
+{
+
+class TimerImpl;
+
+/**
+ * \ingroup timer
+ * \brief A timer which can be restarted and cancelled without scheduling
+ * a new event each time.
+ *
+ * Like a Watchdog, the timer keeps a deadline and at most one event in the
+ * simulator. Moving the deadline later, or cancelling the timer, only updates
+ * the deadline: the pending event checks it lazily when it fires, and is
+ * scheduled again for the remaining time if the deadline has moved. A new
+ * event is only scheduled when there is no pending event, or when the
+ * deadline moves before the pending event.
+ *
+ * This is meant for timers which are restarted much more often than they
+ * expire, such as the TCP delayed ACK and retransmission timers: with a
+ * Timer, each restart costs a new event and leaves a cancelled one in the
+ * scheduler.
+ *
+ * The function is set once, and the pending event is cancelled when the
+ * timer is destroyed. A RestartableTimer cannot be copied.
+ *
+ * \see Timer
+ * \see Watchdog
+ */
+class RestartableTimer
+{
+  public:
+    /** Constructor. */
+    RestartableTimer();
+    /** Destructor. */
+    ~RestartableTimer();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    RestartableTimer(const RestartableTimer&) = delete;
+    RestartableTimer& operator=(const RestartableTimer&) = delete;
+
+    /**
+     * Set the function to execute when the timer expires.
+     *
+     * \tparam FN \deduced The type of the function.
+     * \param [in] fn The function
+     */
+    template <typename FN>
+    void SetFunction(FN fn);
+
+    /**
+     * Set the function to execute when the timer expires.
+     *
+     * \tparam MEM_PTR \deduced Class method function type.
+     * \tparam OBJ_PTR \deduced Class type containing the function.
+     * \param [in] memPtr The member function pointer
+     * \param [in] objPtr The pointer to object
+     */
+    template <typename MEM_PTR, typename OBJ_PTR>
+    void SetFunction(MEM_PTR memPtr, OBJ_PTR objPtr);
+
+    /**
+     * Set the arguments to be used when invoking the expire function.
+     */
+    /**@{*/
+    /**
+     * \tparam Ts \deduced Argument types.
+     * \param [in] args arguments
+     */
+    template <typename... Ts>
+    void SetArguments(Ts&&... args);
+    /**@}*/
+
+    /**
+     * Start the timer, or restart it if it is running.
+     *
+     * \param [in] delay The delay after which the function is invoked,
+     *             from now
+     */
+    void Schedule(Time delay);
+
+    /**
+     * Stop the timer. The function is not invoked until the timer is
+     * scheduled again.
+     */
+    void Cancel();
+
+    /** \return \c true if the timer is running. */
+    bool IsRunning() const;
+
+    /** \return \c true if the timer is not running. */
+    bool IsExpired() const;
+
+    /** \return The time left before the timer expires, zero if it is not running. */
+    Time GetDelayLeft() const;
+
+    /** \return The number of events scheduled in the simulator by this timer. */
+    uint64_t GetNScheduled() const;
+
+  private:
+    /** Internal callback invoked when the pending event fires. */
+    void Expire();
+
+    /**
+     * The timer implementation, which contains the bound callback
+     * function and arguments.
+     */
+    TimerImpl* m_impl;
+    /** The pending event, possibly earlier than the deadline. */
+    EventId m_event;
+    /** The absolute time when the timer expires. */
+    Time m_end;
+    /** Whether the timer is running. */
+    bool m_running;
+    /** The number of events scheduled so far. */
+    uint64_t m_nScheduled;
+};
+
+} // namespace ns3
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+#include "timer-impl.h"
+
+namespace ns3
+{
+
+template <typename FN>
+void
+RestartableTimer::SetFunction(FN fn)
+{
+    delete m_impl;
+    m_impl = MakeTimerImpl(fn);
+}
+
+template <typename MEM_PTR, typename OBJ_PTR>
+void
+RestartableTimer::SetFunction(MEM_PTR memPtr, OBJ_PTR objPtr)
+{
+    delete m_impl;
+    m_impl = MakeTimerImpl(memPtr, objPtr);
+}
+
+template <typename... Ts>
+void
+RestartableTimer::SetArguments(Ts&&... args)
+{
+    if (m_impl == nullptr)
+    {
+        NS_FATAL_ERROR(
+            "You cannot set the arguments of a RestartableTimer before setting its function.");
+        return;
+    }
+    m_impl->SetArgs(std::forward<Ts>(args)...);
+}
+
+} // namespace ns3
+
+#endif /* RESTARTABLE_TIMER_H */
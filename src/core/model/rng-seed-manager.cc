@@ -22,8 +22,11 @@
 #include "config.h"
 #include "global-value.h"
 #include "log.h"
+#include "simulator-context.h"
 #include "uinteger.h"
 
+#include <optional>
+
 /**
  * \file
  * \ingroup randomvariable
@@ -41,6 +44,24 @@ NS_LOG_COMPONENT_DEFINE("RngSeedManager");
  * for automatic assignment.
  */
 static uint64_t g_nextStreamIndex = 0;
+/**
+ * \relates RngSeedManager
+ * The next stream number of the calling thread, in the thread-local mode
+ * of SimulatorContext.
+ */
+static thread_local uint64_t g_localNextStreamIndex = 0;
+/**
+ * \relates RngSeedManager
+ * The seed set by the calling thread, in the thread-local mode of
+ * SimulatorContext. The RngSeed global value is used until it is set.
+ */
+static thread_local std::optional<uint32_t> g_localRngSeed;
+/**
+ * \relates RngSeedManager
+ * The run number set by the calling thread, in the thread-local mode of
+ * SimulatorContext. The RngRun global value is used until it is set.
+ */
+static thread_local std::optional<uint64_t> g_localRngRun;
 /**
  * \relates RngSeedManager
  * \anchor GlobalValueRngSeed
@@ -74,6 +95,10 @@ uint32_t
 RngSeedManager::GetSeed()
 {
     NS_LOG_FUNCTION_NOARGS();
+    if (SimulatorContext::IsThreadLocal() && g_localRngSeed)
+    {
+        return *g_localRngSeed;
+    }
     UintegerValue seedValue;
     g_rngSeed.GetValue(seedValue);
     return static_cast<uint32_t>(seedValue.Get());
@@ -83,6 +108,11 @@ void
 RngSeedManager::SetSeed(uint32_t seed)
 {
     NS_LOG_FUNCTION(seed);
+    if (SimulatorContext::IsThreadLocal())
+    {
+        g_localRngSeed = seed;
+        return;
+    }
     Config::SetGlobal("RngSeed", UintegerValue(seed));
 }
 
@@ -90,6 +120,11 @@ void
 RngSeedManager::SetRun(uint64_t run)
 {
     NS_LOG_FUNCTION(run);
+    if (SimulatorContext::IsThreadLocal())
+    {
+        g_localRngRun = run;
+        return;
+    }
     Config::SetGlobal("RngRun", UintegerValue(run));
 }
 
@@ -97,6 +132,10 @@ uint64_t
 RngSeedManager::GetRun()
 {
     NS_LOG_FUNCTION_NOARGS();
+    if (SimulatorContext::IsThreadLocal() && g_localRngRun)
+    {
+        return *g_localRngRun;
+    }
     UintegerValue value;
     g_rngRun.GetValue(value);
     uint64_t run = value.Get();
@@ -107,8 +146,10 @@ uint64_t
 RngSeedManager::GetNextStreamIndex()
 {
     NS_LOG_FUNCTION_NOARGS();
-    uint64_t next = g_nextStreamIndex;
-    g_nextStreamIndex++;
+    uint64_t& nextStreamIndex =
+        SimulatorContext::Select(g_nextStreamIndex, g_localNextStreamIndex);
+    uint64_t next = nextStreamIndex;
+    nextStreamIndex++;
     return next;
 }
 
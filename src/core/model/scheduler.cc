@@ -47,4 +47,10 @@ Scheduler::GetTypeId()
     return tid;
 }
 
+bool
+Scheduler::IsRemoveCheap() const
+{
+    return false;
+}
+
 } // namespace ns3
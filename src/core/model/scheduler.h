@@ -226,6 +226,16 @@ class Scheduler : public Object
      * \param [in] ev The event to remove
      */
     virtual void Remove(const Event& ev) = 0;
+    /**
+     * Test if Remove() is cheap enough to remove the cancelled events.
+     *
+     * The simulator normally leaves the cancelled events in the event
+     * list until they expire. With a scheduler which can remove an event
+     * as fast as it inserts one, it removes them when they are cancelled.
+     *
+     * \returns \c true if the cancelled events should be removed.
+     */
+    virtual bool IsRemoveCheap() const;
 };
 
 /**
@@ -24,6 +24,7 @@
 #include "assert.h"
 #include "default-deleter.h"
 
+#include <atomic>
 #include <limits>
 #include <stdint.h>
 
@@ -44,6 +45,59 @@ class Empty
 {
 };
 
+/**
+ * \ingroup ptr
+ * \brief Selects how SimpleRefCount updates the reference counts.
+ *
+ * The counts are plain integers by default. They are updated atomically
+ * once the simulations run in several threads (see
+ * SimulatorContext::EnableThreadLocal), since some objects are then
+ * shared between the threads, such as the initial attribute values held
+ * by the TypeIds, and while a simulation runs in several threads (see
+ * SimulatorContext::SetParallel).
+ *
+ * The reference counts of the packet buffers, tags and metadata use the
+ * same mode, through Increment() and Decrement().
+ */
+struct SimpleRefCountMode
+{
+    static inline bool atomic{false}; //!< Whether the counts are updated atomically
+
+    /**
+     * Increment a reference count.
+     *
+     * \param [in,out] count The count.
+     */
+    static void Increment(std::atomic<uint32_t>& count)
+    {
+        if (atomic)
+        {
+            count.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * Decrement a reference count.
+     *
+     * \param [in,out] count The count.
+     * \return The new count: the counted object is not referenced anymore if it is zero.
+     */
+    static uint32_t Decrement(std::atomic<uint32_t>& count)
+    {
+        if (atomic)
+        {
+            return count.fetch_sub(1, std::memory_order_acq_rel) - 1;
+        }
+        uint32_t value = count.load(std::memory_order_relaxed) - 1;
+        count.store(value, std::memory_order_relaxed);
+        return value;
+    }
+};
+
 /**
  * \ingroup ptr
  * \brief A template-based reference counting class
@@ -113,8 +167,8 @@ class SimpleRefCount : public PARENT
      */
     inline void Ref() const
     {
-        NS_ASSERT(m_count < std::numeric_limits<uint32_t>::max());
-        m_count++;
+        NS_ASSERT(m_count.load(std::memory_order_relaxed) < std::numeric_limits<uint32_t>::max());
+        SimpleRefCountMode::Increment(m_count);
     }
 
     /**
@@ -125,8 +179,7 @@ class SimpleRefCount : public PARENT
      */
     inline void Unref() const
     {
-        m_count--;
-        if (m_count == 0)
+        if (SimpleRefCountMode::Decrement(m_count) == 0)
         {
             DELETER::Delete(static_cast<T*>(const_cast<SimpleRefCount*>(this)));
         }
@@ -140,7 +193,7 @@ class SimpleRefCount : public PARENT
      */
     inline uint32_t GetReferenceCount() const
     {
-        return m_count;
+        return m_count.load(std::memory_order_relaxed);
     }
 
   private:
@@ -149,9 +202,10 @@ class SimpleRefCount : public PARENT
      *
      * \internal
      * Note we make this mutable so that the const methods can still
-     * change it.
+     * change it. Relaxed loads and stores compile to plain memory accesses,
+     * read-modify-write operations are only used in the atomic mode.
      */
-    mutable uint32_t m_count;
+    mutable std::atomic<uint32_t> m_count;
 };
 
 } // namespace ns3
@@ -80,6 +80,7 @@ class SimulationSingleton
  *  Implementation of the templates declared above.
  ********************************************************************/
 
+#include "simulator-context.h"
 #include "simulator.h"
 
 namespace ns3
@@ -97,7 +98,9 @@ template <typename T>
 T**
 SimulationSingleton<T>::GetObject()
 {
-    static T* pobject = nullptr;
+    static T* globalObject = nullptr;
+    static thread_local T* localObject = nullptr;
+    T*& pobject = SimulatorContext::Select(globalObject, localObject);
     if (pobject == nullptr)
     {
         pobject = new T();
@@ -0,0 +1,33 @@
+#include "simulator-context.h"
+
+#include "log.h"
+#include "simple-ref-count.h"
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::SimulatorContext implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SimulatorContext");
+
+void
+SimulatorContext::EnableThreadLocal()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_threadLocal = true;
+    SimpleRefCountMode::atomic = true;
+}
+
+void
+SimulatorContext::SetParallel(bool parallel)
+{
+    NS_LOG_FUNCTION(parallel);
+    m_parallel = parallel;
+    SimpleRefCountMode::atomic = m_threadLocal || m_parallel;
+}
+
+} // namespace ns3
@@ -0,0 +1,130 @@
+#ifndef SIMULATOR_CONTEXT_H
+#define SIMULATOR_CONTEXT_H
+
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::SimulatorContext declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup simulator
+ * \brief Run independent simulations in several threads of one process.
+ *
+ * By default the simulator, the node and channel lists, the simulation
+ * singletons, the Config root namespace and the state of the RngSeedManager
+ * are shared by the whole process. Once EnableThreadLocal has been called,
+ * each thread gets its own copy of this state: a thread can build, run and
+ * destroy a simulation while other threads run theirs, as if each of them
+ * was a separate process. The threads still share the loaded libraries and
+ * the TypeId database.
+ *
+ * The mode is selected once for the process, and cannot be disabled:
+ * EnableThreadLocal must be called before any simulation object is
+ * created, since the objects created before are not reachable anymore.
+ *
+ * Some state stays process-wide:
+ * - the TypeIds and their attributes, including the defaults changed by
+ *   Config::SetDefault and the global values, which should be configured
+ *   before the threads are started;
+ * - the log components and their levels.
+ *
+ * In this mode the reference counts of SimpleRefCount are updated
+ * atomically, and the free lists of the packet buffers, byte tags and
+ * metadata are disabled.
+ *
+ * A parallel simulator implementation, such as MultithreadedSimulatorImpl,
+ * rather runs one simulation in several threads. While it runs, it sets the
+ * parallel mode, which also updates the reference counts atomically and
+ * disables the free lists, and the partition of the events run by each
+ * thread.
+ */
+class SimulatorContext
+{
+  public:
+    /**
+     * Give each thread its own simulation state, for the rest of the process.
+     */
+    static void EnableThreadLocal();
+
+    /** \return \c true if each thread has its own simulation state. */
+    static bool IsThreadLocal()
+    {
+        return m_threadLocal;
+    }
+
+    /**
+     * Select the storage of some simulation state.
+     *
+     * \tparam T \deduced The type of the state.
+     * \param [in] global The process-wide state.
+     * \param [in] local The state of the calling thread.
+     * \return \pname{local} if each thread has its own simulation state,
+     *         \pname{global} otherwise.
+     */
+    template <typename T>
+    static T& Select(T& global, T& local)
+    {
+        return m_threadLocal ? local : global;
+    }
+
+    /** Partition of the threads which do not run a partition of a parallel simulation. */
+    static constexpr uint32_t NO_PARTITION = 0xffffffff;
+    /** Maximum number of partitions of a parallel simulation. */
+    static constexpr uint32_t MAX_PARTITIONS = 256;
+
+    /**
+     * Set whether a simulation runs in several threads. Called by the
+     * parallel simulator implementations, while only one thread runs.
+     *
+     * \param [in] parallel \c true when the threads start, \c false when
+     *             they stopped.
+     */
+    static void SetParallel(bool parallel);
+
+    /** \return \c true if a simulation runs in several threads. */
+    static bool IsParallel()
+    {
+        return m_parallel;
+    }
+
+    /**
+     * \return \c true if several threads can access the simulation objects,
+     *         in the thread-local or the parallel mode.
+     */
+    static bool IsMultithreaded()
+    {
+        return m_threadLocal || m_parallel;
+    }
+
+    /**
+     * Set the partition run by the calling thread.
+     *
+     * \param [in] partition The partition, or NO_PARTITION.
+     */
+    static void SetPartition(uint32_t partition)
+    {
+        m_partition = partition;
+    }
+
+    /** \return The partition run by the calling thread, or NO_PARTITION. */
+    static uint32_t GetPartition()
+    {
+        return m_partition;
+    }
+
+  private:
+    static inline bool m_threadLocal{false}; //!< Whether each thread has its own state
+    static inline bool m_parallel{false};    //!< Whether a simulation runs in several threads
+    /** Partition run by the thread */
+    static inline thread_local uint32_t m_partition{NO_PARTITION};
+};
+
+} // namespace ns3
+
+#endif /* SIMULATOR_CONTEXT_H */
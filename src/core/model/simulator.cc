@@ -27,6 +27,7 @@
 #include "object-factory.h"
 #include "ptr.h"
 #include "scheduler.h"
+#include "simulator-context.h"
 #include "simulator-impl.h"
 #include "string.h"
 
@@ -89,7 +90,8 @@ static SimulatorImpl**
 PeekImpl()
 {
     static SimulatorImpl* impl = nullptr;
-    return &impl;
+    static thread_local SimulatorImpl* localImpl = nullptr;
+    return &SimulatorContext::Select(impl, localImpl);
 }
 
 /**
@@ -23,9 +23,12 @@
 #include "singleton.h"
 #include "trace-source-accessor.h"
 
+#include <deque>
+#include <functional>
 #include <iomanip>
 #include <map>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 /**
@@ -229,6 +232,20 @@ class IidManager : public Singleton<IidManager>
      * \returns The information associated to attribute whose index is \pname{i}.
      */
     TypeId::AttributeInformation GetAttribute(uint16_t uid, std::size_t i) const;
+    /**
+     * Get a reference to the Attribute information by index.
+     * \param [in] uid The id.
+     * \param [in] i Index into attribute array
+     * \returns The information associated to attribute whose index is \pname{i}.
+     */
+    const TypeId::AttributeInformation& PeekAttribute(uint16_t uid, std::size_t i) const;
+    /**
+     * Find an Attribute by name in a type id and its parents.
+     * \param [in] uid The id.
+     * \param [in] name The Attribute name.
+     * \returns The information of the Attribute, or \c nullptr if not found.
+     */
+    const TypeId::AttributeInformation* FindAttribute(uint16_t uid, const std::string& name) const;
     /**
      * Record a new TraceSource.
      * \param [in] uid The id.
@@ -263,6 +280,14 @@ class IidManager : public Singleton<IidManager>
      * \returns Detailed information about the requested trace source.
      */
     TypeId::TraceSourceInformation GetTraceSource(uint16_t uid, std::size_t i) const;
+    /**
+     * Find a TraceSource by name in a type id and its parents.
+     * \param [in] uid The id.
+     * \param [in] name The TraceSource name.
+     * \returns The information of the TraceSource, or \c nullptr if not found.
+     */
+    const TypeId::TraceSourceInformation* FindTraceSource(uint16_t uid,
+                                                          const std::string& name) const;
     /**
      * Check if this TypeId should not be listed in documentation.
      * \param [in] uid The id.
@@ -292,6 +317,13 @@ class IidManager : public Singleton<IidManager>
      */
     static TypeId::hash_t Hasher(const std::string name);
 
+    /**
+     * Index of the Attributes or TraceSources of a type id, from the
+     * std::hash of their name to their index. The hash of a name is computed
+     * once per lookup, and compared to the index of each parent in turn.
+     */
+    typedef std::unordered_multimap<std::size_t, std::size_t> NameIndex;
+
     /** The information record about a single type id. */
     struct IidInformation
     {
@@ -312,9 +344,13 @@ class IidManager : public Singleton<IidManager>
         /** \c true if this type should be omitted from documentation. */
         bool mustHideFromDocumentation;
         /** The container of Attributes. */
-        std::vector<TypeId::AttributeInformation> attributes;
+        std::deque<TypeId::AttributeInformation> attributes;
+        /** The Attributes by name. */
+        NameIndex attributeIndex;
         /** The container of TraceSources. */
-        std::vector<TypeId::TraceSourceInformation> traceSources;
+        std::deque<TypeId::TraceSourceInformation> traceSources;
+        /** The TraceSources by name. */
+        NameIndex traceSourceIndex;
         /** Support level/deprecation. */
         TypeId::SupportLevel supportLevel;
         /** Support message. */
@@ -322,7 +358,7 @@ class IidManager : public Singleton<IidManager>
     };
 
     /** Iterator type. */
-    typedef std::vector<IidInformation>::const_iterator Iterator;
+    typedef std::deque<IidInformation>::const_iterator Iterator;
 
     /**
      * Retrieve the information record for a type.
@@ -331,8 +367,13 @@ class IidManager : public Singleton<IidManager>
      */
     IidManager::IidInformation* LookupInformation(uint16_t uid) const;
 
-    /** The container of all type id records. */
-    std::vector<IidInformation> m_information;
+    /**
+     * The container of all type id records.
+     *
+     * A deque, so that the records and their Attributes are never moved,
+     * and TypeId::PeekAttribute() can return a stable reference.
+     */
+    std::deque<IidInformation> m_information;
 
     /** Type of the by-name index. */
     typedef std::map<std::string, uint16_t> namemap_t;
@@ -624,29 +665,37 @@ bool
 IidManager::HasAttribute(uint16_t uid, std::string name)
 {
     NS_LOG_FUNCTION(IID << uid << name);
+    bool found = FindAttribute(uid, name) != nullptr;
+    NS_LOG_LOGIC(IIDL << found);
+    return found;
+}
+
+const TypeId::AttributeInformation*
+IidManager::FindAttribute(uint16_t uid, const std::string& name) const
+{
+    NS_LOG_FUNCTION(IID << uid << name);
+    std::size_t hash = std::hash<std::string>{}(name);
     IidInformation* information = LookupInformation(uid);
     while (true)
     {
-        for (auto i = information->attributes.begin(); i != information->attributes.end(); ++i)
+        auto [begin, end] = information->attributeIndex.equal_range(hash);
+        for (auto i = begin; i != end; ++i)
         {
-            if (i->name == name)
+            const TypeId::AttributeInformation& attribute = information->attributes[i->second];
+            if (attribute.name == name)
             {
-                NS_LOG_LOGIC(IIDL << true);
-                return true;
+                return &attribute;
             }
         }
         IidInformation* parent = LookupInformation(information->parent);
         if (parent == information)
         {
             // top of inheritance tree
-            NS_LOG_LOGIC(IIDL << false);
-            return false;
+            return nullptr;
         }
         // check parent
         information = parent;
     }
-    NS_LOG_LOGIC(IIDL << false);
-    return false;
 }
 
 void
@@ -684,6 +733,8 @@ IidManager::AddAttribute(uint16_t uid,
     info.checker = checker;
     info.supportLevel = supportLevel;
     info.supportMsg = supportMsg;
+    information->attributeIndex.emplace(std::hash<std::string>{}(name),
+                                        information->attributes.size());
     information->attributes.push_back(info);
     NS_LOG_LOGIC(IIDL << information->attributes.size() - 1);
 }
@@ -719,33 +770,50 @@ IidManager::GetAttribute(uint16_t uid, std::size_t i) const
     return information->attributes[i];
 }
 
+const TypeId::AttributeInformation&
+IidManager::PeekAttribute(uint16_t uid, std::size_t i) const
+{
+    NS_LOG_FUNCTION(IID << uid << i);
+    IidInformation* information = LookupInformation(uid);
+    NS_ASSERT(i < information->attributes.size());
+    return information->attributes[i];
+}
+
 bool
 IidManager::HasTraceSource(uint16_t uid, std::string name)
 {
     NS_LOG_FUNCTION(IID << uid << name);
+    bool found = FindTraceSource(uid, name) != nullptr;
+    NS_LOG_LOGIC(IIDL << found);
+    return found;
+}
+
+const TypeId::TraceSourceInformation*
+IidManager::FindTraceSource(uint16_t uid, const std::string& name) const
+{
+    NS_LOG_FUNCTION(IID << uid << name);
+    std::size_t hash = std::hash<std::string>{}(name);
     IidInformation* information = LookupInformation(uid);
     while (true)
     {
-        for (auto i = information->traceSources.begin(); i != information->traceSources.end(); ++i)
+        auto [begin, end] = information->traceSourceIndex.equal_range(hash);
+        for (auto i = begin; i != end; ++i)
         {
-            if (i->name == name)
+            const TypeId::TraceSourceInformation& source = information->traceSources[i->second];
+            if (source.name == name)
             {
-                NS_LOG_LOGIC(IIDL << true);
-                return true;
+                return &source;
             }
         }
         IidInformation* parent = LookupInformation(information->parent);
         if (parent == information)
         {
             // top of inheritance tree
-            NS_LOG_LOGIC(IIDL << false);
-            return false;
+            return nullptr;
         }
         // check parent
         information = parent;
     }
-    NS_LOG_LOGIC(IIDL << false);
-    return false;
 }
 
 void
@@ -772,6 +840,8 @@ IidManager::AddTraceSource(uint16_t uid,
     source.callback = callback;
     source.supportLevel = supportLevel;
     source.supportMsg = supportMsg;
+    information->traceSourceIndex.emplace(std::hash<std::string>{}(name),
+                                          information->traceSources.size());
     information->traceSources.push_back(source);
     NS_LOG_LOGIC(IIDL << information->traceSources.size() - 1);
 }
@@ -892,38 +962,23 @@ bool
 TypeId::LookupAttributeByName(std::string name, TypeId::AttributeInformation* info) const
 {
     NS_LOG_FUNCTION(this << name << info);
-    TypeId tid;
-    TypeId nextTid = *this;
-    do
+    const TypeId::AttributeInformation* found = IidManager::Get()->FindAttribute(m_tid, name);
+    if (found == nullptr)
     {
-        tid = nextTid;
-        for (std::size_t i = 0; i < tid.GetAttributeN(); i++)
-        {
-            TypeId::AttributeInformation tmp = tid.GetAttribute(i);
-            if (tmp.name == name)
-            {
-                if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                    *info = tmp;
-                    return true;
-                }
-                else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                    std::cerr << "Attribute '" << name << "' is deprecated: " << tmp.supportMsg
-                              << std::endl;
-                    *info = tmp;
-                    return true;
-                }
-                else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                    NS_FATAL_ERROR("Attribute '" << name << "' is obsolete, with no fallback: "
-                                                 << tmp.supportMsg);
-                }
-            }
-        }
-        nextTid = tid.GetParent();
-    } while (nextTid != tid);
-    return false;
+        return false;
+    }
+    if (found->supportLevel == TypeId::DEPRECATED)
+    {
+        std::cerr << "Attribute '" << name << "' is deprecated: " << found->supportMsg
+                  << std::endl;
+    }
+    else if (found->supportLevel == TypeId::OBSOLETE)
+    {
+        NS_FATAL_ERROR("Attribute '" << name << "' is obsolete, with no fallback: "
+                                     << found->supportMsg);
+    }
+    *info = *found;
+    return true;
 }
 
 TypeId
@@ -1110,12 +1165,18 @@ TypeId::GetAttribute(std::size_t i) const
     return IidManager::Get()->GetAttribute(m_tid, i);
 }
 
+const TypeId::AttributeInformation&
+TypeId::PeekAttribute(std::size_t i) const
+{
+    NS_LOG_FUNCTION(this << i);
+    return IidManager::Get()->PeekAttribute(m_tid, i);
+}
+
 std::string
 TypeId::GetAttributeFullName(std::size_t i) const
 {
     NS_LOG_FUNCTION(this << i);
-    TypeId::AttributeInformation info = GetAttribute(i);
-    return GetName() + "::" + info.name;
+    return GetName() + "::" + PeekAttribute(i).name;
 }
 
 std::size_t
@@ -1158,39 +1219,24 @@ Ptr<const TraceSourceAccessor>
 TypeId::LookupTraceSourceByName(std::string name, TraceSourceInformation* info) const
 {
     NS_LOG_FUNCTION(this << name);
-    TypeId tid;
-    TypeId nextTid = *this;
-    TypeId::TraceSourceInformation tmp;
-    do
+    const TypeId::TraceSourceInformation* found =
+        IidManager::Get()->FindTraceSource(m_tid, name);
+    if (found == nullptr)
     {
-        tid = nextTid;
-        for (std::size_t i = 0; i < tid.GetTraceSourceN(); i++)
-        {
-            tmp = tid.GetTraceSource(i);
-            if (tmp.name == name)
-            {
-                if (tmp.supportLevel == TypeId::SUPPORTED)
-                {
-                    *info = tmp;
-                    return tmp.accessor;
-                }
-                else if (tmp.supportLevel == TypeId::DEPRECATED)
-                {
-                    std::cerr << "TraceSource '" << name << "' is deprecated: " << tmp.supportMsg
-                              << std::endl;
-                    *info = tmp;
-                    return tmp.accessor;
-                }
-                else if (tmp.supportLevel == TypeId::OBSOLETE)
-                {
-                    NS_FATAL_ERROR("TraceSource '" << name << "' is obsolete, with no fallback: "
-                                                   << tmp.supportMsg);
-                }
-            }
-        }
-        nextTid = tid.GetParent();
-    } while (nextTid != tid);
-    return nullptr;
+        return nullptr;
+    }
+    if (found->supportLevel == TypeId::DEPRECATED)
+    {
+        std::cerr << "TraceSource '" << name << "' is deprecated: " << found->supportMsg
+                  << std::endl;
+    }
+    else if (found->supportLevel == TypeId::OBSOLETE)
+    {
+        NS_FATAL_ERROR("TraceSource '" << name << "' is obsolete, with no fallback: "
+                                       << found->supportMsg);
+    }
+    *info = *found;
+    return found->accessor;
 }
 
 Ptr<const TraceSourceAccessor>
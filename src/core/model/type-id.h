@@ -262,6 +262,16 @@ class TypeId
      * \returns The information associated to attribute whose index is \pname{i}.
      */
     TypeId::AttributeInformation GetAttribute(std::size_t i) const;
+    /**
+     * Get Attribute information by index, without copying it.
+     *
+     * The attribute information is never moved nor removed, so the
+     * reference stays valid for the lifetime of the program.
+     *
+     * \param [in] i Index into attribute array
+     * \returns The information associated to attribute whose index is \pname{i}.
+     */
+    const TypeId::AttributeInformation& PeekAttribute(std::size_t i) const;
     /**
      * Get the Attribute name by index.
      *
@@ -864,6 +864,134 @@ SearchAttributesOfParentObjectsTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(iv.Get(), 42, "Object Attribute \"X\" not settable in derived class");
 }
 
+/**
+ * \ingroup config-tests
+ * Test the compiled Config paths.
+ */
+class PathHandleConfigTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    PathHandleConfigTestCase();
+
+    /** Destructor. */
+    ~PathHandleConfigTestCase() override
+    {
+    }
+
+    /**
+     * Trace callback without context.
+     * \param oldValue The old value.
+     * \param newValue The new value.
+     */
+    void Trace(int16_t oldValue [[maybe_unused]], int16_t newValue)
+    {
+        m_newValue = newValue;
+    }
+
+  private:
+    void DoRun() override;
+
+    int16_t m_newValue; //!< Flag to detect tracing result.
+};
+
+PathHandleConfigTestCase::PathHandleConfigTestCase()
+    : TestCase("Check the compiled Config paths")
+{
+}
+
+void
+PathHandleConfigTestCase::DoRun()
+{
+    IntegerValue iv;
+
+    //
+    // Build /NodeA/NodeB/NodesB/[0-3] under a new root namespace object.
+    //
+    Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject>();
+    Config::RegisterRootNamespaceObject(root);
+    Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject>();
+    root->SetNodeA(a);
+    Ptr<ConfigTestObject> b = CreateObject<ConfigTestObject>();
+    a->SetNodeB(b);
+    std::vector<Ptr<ConfigTestObject>> objects;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        objects.push_back(CreateObject<ConfigTestObject>());
+        b->AddNodeB(objects.back());
+    }
+
+    //
+    // Set the attribute of all the objects of the vector, then of one.
+    //
+    Config::PathHandle all("/NodeA/NodeB/NodesB/*/A");
+    NS_TEST_ASSERT_MSG_EQ(all.GetName(), "A", "Wrong attribute name");
+    all.SetAll(IntegerValue(-3));
+    for (const auto& object : objects)
+    {
+        object->GetAttribute("A", iv);
+        NS_TEST_ASSERT_MSG_EQ(iv.Get(), -3, "Object Attribute \"A\" not set as expected");
+    }
+
+    Config::PathHandle one("/NodeA/NodeB/NodesB/2/A");
+    one.SetAll(IntegerValue(-4));
+    for (uint32_t i = 0; i < objects.size(); i++)
+    {
+        objects[i]->GetAttribute("A", iv);
+        NS_TEST_ASSERT_MSG_EQ(iv.Get(), (i == 2 ? -4 : -3), "Object Attribute \"A\" wrong");
+    }
+    Config::MatchContainer matches = one.LookupMatches();
+    bool found = false;
+    for (std::size_t i = 0; i < matches.GetN(); i++)
+    {
+        if (matches.Get(i) == objects[2])
+        {
+            NS_TEST_EXPECT_MSG_EQ(matches.GetMatchedPath(i),
+                                  "/NodeA/NodeB/NodesB/2/",
+                                  "Wrong context of the match");
+            found = true;
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(found, true, "Object 2 not matched");
+
+    //
+    // An index past the end of the vector does not match.
+    //
+    Config::PathHandle past("/NodeA/NodeB/NodesB/7/A");
+    NS_TEST_EXPECT_MSG_EQ(past.LookupMatches().GetN(),
+                          0,
+                          "Index past the end of the vector matched");
+
+    //
+    // The new matches are only returned once, until objects are added.
+    //
+    std::size_t n = all.LookupNewMatches().GetN();
+    NS_TEST_ASSERT_MSG_GT_OR_EQ(n, 4, "The objects of the vector not matched");
+    NS_TEST_ASSERT_MSG_EQ(all.LookupNewMatches().GetN(), 0, "Objects matched twice");
+    objects.push_back(CreateObject<ConfigTestObject>());
+    b->AddNodeB(objects.back());
+    matches = all.LookupNewMatches();
+    NS_TEST_ASSERT_MSG_EQ(matches.GetN(), 1, "The added object not matched once");
+    NS_TEST_ASSERT_MSG_EQ(matches.Get(0), objects.back(), "Wrong added object");
+    NS_TEST_ASSERT_MSG_EQ(matches.GetMatchedPath(0),
+                          "/NodeA/NodeB/NodesB/4/",
+                          "Wrong context of the added object");
+
+    //
+    // Trace a range of the vector.
+    //
+    Config::PathHandle source("/NodeA/NodeB/NodesB/[1-2]/Source");
+    source.ConnectAllWithoutContext(MakeCallback(&PathHandleConfigTestCase::Trace, this));
+    m_newValue = 0;
+    objects[1]->SetAttribute("Source", IntegerValue(-5));
+    NS_TEST_ASSERT_MSG_EQ(m_newValue, -5, "Trace 1 did not fire as expected");
+    m_newValue = 0;
+    objects[3]->SetAttribute("Source", IntegerValue(-6));
+    NS_TEST_ASSERT_MSG_EQ(m_newValue, 0, "Trace 3 fired unexpectedly");
+
+    Config::UnregisterRootNamespaceObject(root);
+}
+
 /**
  * \ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -882,6 +1010,7 @@ ConfigTestSuite::ConfigTestSuite()
     AddTestCase(new UnderRootNamespaceConfigTestCase);
     AddTestCase(new ObjectVectorConfigTestCase);
     AddTestCase(new SearchAttributesOfParentObjectsTestCase);
+    AddTestCase(new PathHandleConfigTestCase);
 }
 
 /**
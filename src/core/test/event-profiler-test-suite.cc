@@ -0,0 +1,156 @@
+#include "ns3/event-profiler.h"
+#include "ns3/global-value.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+
+#include <fstream>
+#include <sstream>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup simulator
+ * \ingroup simulator-tests
+ * EventProfiler test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup simulator-tests
+ * Profile a simulation with two types of events, and check the profile.
+ */
+class EventProfilerTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    EventProfilerTestCase();
+    void DoRun() override;
+
+  private:
+    /** Event which schedules two other events. */
+    void Fanout();
+    /**
+     * Event which schedules nothing.
+     * \param value Unused.
+     */
+    void Leaf(int value);
+};
+
+EventProfilerTestCase::EventProfilerTestCase()
+    : TestCase("Check the profile of the events")
+{
+}
+
+void
+EventProfilerTestCase::Fanout()
+{
+    Simulator::Schedule(Seconds(1), &EventProfilerTestCase::Leaf, this, 1);
+    Simulator::Schedule(Seconds(2), &EventProfilerTestCase::Leaf, this, 2);
+}
+
+void
+EventProfilerTestCase::Leaf(int value)
+{
+}
+
+void
+EventProfilerTestCase::DoRun()
+{
+    if (!EventProfiler::ENABLED)
+    {
+        return;
+    }
+
+    std::string prefix = CreateTempDirFilename("events");
+    GlobalValue::Bind("EventProfile", StringValue(prefix));
+    Simulator::Schedule(Seconds(1), &EventProfilerTestCase::Fanout, this);
+    Simulator::Run();
+    Simulator::Destroy();
+    GlobalValue::Bind("EventProfile", StringValue(""));
+
+    const std::string fanout = "MakeEvent<void (ns3::tests::EventProfilerTestCase::*)(), "
+                               "ns3::tests::EventProfilerTestCase*>";
+    const std::string leaf = "MakeEvent<void (ns3::tests::EventProfilerTestCase::*)(int), "
+                             "ns3::tests::EventProfilerTestCase*, int>";
+
+    std::ifstream flat(prefix + ".txt");
+    NS_TEST_ASSERT_MSG_EQ(flat.is_open(), true, "No flat profile");
+    std::string line;
+    uint32_t found = 0;
+    while (std::getline(flat, line))
+    {
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        std::istringstream columns(line);
+        double percent;
+        double total;
+        uint64_t count;
+        double mean;
+        double p99;
+        double max;
+        double fanouts;
+        columns >> percent >> total >> count >> mean >> p99 >> max >> fanouts;
+        std::string name;
+        std::getline(columns >> std::ws, name);
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(p99, max, "The p99 time is longer than the longest event");
+        if (name == fanout)
+        {
+            NS_TEST_EXPECT_MSG_EQ(count, 1, "Wrong count of " << name);
+            NS_TEST_EXPECT_MSG_EQ(fanouts, 2, "Wrong fan-out of " << name);
+            found++;
+        }
+        else if (name == leaf)
+        {
+            NS_TEST_EXPECT_MSG_EQ(count, 2, "Wrong count of " << name);
+            NS_TEST_EXPECT_MSG_EQ(fanouts, 0, "Wrong fan-out of " << name);
+            found++;
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(found, 2, "Missing events in the flat profile");
+
+    std::ifstream folded(prefix + ".folded");
+    NS_TEST_ASSERT_MSG_EQ(folded.is_open(), true, "No collapsed stacks");
+    const std::string stack = "ns3::Simulator::Run;ns3;tests;EventProfilerTestCase;";
+    found = 0;
+    while (std::getline(folded, line))
+    {
+        if (line.rfind(stack + fanout + " ", 0) == 0 || line.rfind(stack + leaf + " ", 0) == 0)
+        {
+            found++;
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(found, 2, "Missing events in the collapsed stacks");
+}
+
+/**
+ * \ingroup simulator-tests
+ * EventProfiler test suite
+ */
+class EventProfilerTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    EventProfilerTestSuite()
+        : TestSuite("event-profiler")
+    {
+        AddTestCase(new EventProfilerTestCase());
+    }
+};
+
+/**
+ * \ingroup simulator-tests
+ * EventProfilerTestSuite instance variable.
+ */
+static EventProfilerTestSuite g_eventProfilerTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
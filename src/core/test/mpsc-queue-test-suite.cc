@@ -0,0 +1,157 @@
+#include "ns3/mpsc-queue.h"
+#include "ns3/test.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * MpscQueue test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup core-tests
+ * Check that a MpscQueue is bounded and keeps the order of one thread.
+ */
+class MpscQueueBoundsTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    MpscQueueBoundsTestCase();
+    void DoRun() override;
+};
+
+MpscQueueBoundsTestCase::MpscQueueBoundsTestCase()
+    : TestCase("Check the capacity and order of a MpscQueue")
+{
+}
+
+void
+MpscQueueBoundsTestCase::DoRun()
+{
+    MpscQueue<int> queue(5);
+    NS_TEST_ASSERT_MSG_EQ(queue.GetCapacity(), 8, "The capacity should be a power of two");
+
+    int item;
+    NS_TEST_EXPECT_MSG_EQ(queue.Pop(item), false, "The queue should be empty");
+    for (int round = 0; round < 3; round++)
+    {
+        for (int i = 0; i < 8; i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(queue.Push(i), true, "The queue should not be full");
+        }
+        NS_TEST_EXPECT_MSG_EQ(queue.Push(8), false, "The queue should be full");
+        for (int i = 0; i < 8; i++)
+        {
+            NS_TEST_EXPECT_MSG_EQ(queue.Pop(item), true, "The queue should not be empty");
+            NS_TEST_EXPECT_MSG_EQ(item, i, "Wrong order");
+        }
+        NS_TEST_EXPECT_MSG_EQ(queue.Pop(item), false, "The queue should be empty");
+    }
+}
+
+/**
+ * \ingroup core-tests
+ * Push from several threads while one thread pops, and check that every
+ * item is received once, in the order of its thread.
+ */
+class MpscQueueThreadsTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    MpscQueueThreadsTestCase();
+    void DoRun() override;
+};
+
+MpscQueueThreadsTestCase::MpscQueueThreadsTestCase()
+    : TestCase("Check a MpscQueue with concurrent producers")
+{
+}
+
+void
+MpscQueueThreadsTestCase::DoRun()
+{
+    const uint32_t nThreads = 4;
+    const uint32_t nItems = 100000;
+    MpscQueue<uint64_t> queue(64);
+
+    std::vector<std::thread> producers;
+    for (uint32_t thread = 0; thread < nThreads; thread++)
+    {
+        producers.emplace_back([thread, &queue]() {
+            for (uint32_t i = 0; i < nItems; i++)
+            {
+                while (!queue.Push((static_cast<uint64_t>(thread) << 32) | i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<uint32_t> next(nThreads, 0);
+    uint32_t nErrors = 0;
+    uint64_t received = 0;
+    while (received < nThreads * nItems)
+    {
+        uint64_t item;
+        if (!queue.Pop(item))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        uint32_t thread = item >> 32;
+        uint32_t i = item & 0xffffffff;
+        if (thread >= nThreads || i != next[thread])
+        {
+            nErrors++;
+        }
+        else
+        {
+            next[thread]++;
+        }
+        received++;
+    }
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+
+    uint64_t item;
+    NS_TEST_EXPECT_MSG_EQ(queue.Pop(item), false, "The queue should be empty");
+    NS_TEST_EXPECT_MSG_EQ(nErrors, 0, "Items lost, duplicated or out of order");
+}
+
+/**
+ * \ingroup core-tests
+ *  MpscQueue test suite
+ */
+class MpscQueueTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    MpscQueueTestSuite()
+        : TestSuite("mpsc-queue")
+    {
+        AddTestCase(new MpscQueueBoundsTestCase());
+        AddTestCase(new MpscQueueThreadsTestCase());
+    }
+};
+
+/**
+ * \ingroup core-tests
+ * MpscQueueTestSuite instance variable.
+ */
+static MpscQueueTestSuite g_mpscQueueTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,342 @@
+#include "ns3/config.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <sstream>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup simulator
+ * \ingroup simulator-tests
+ * MultithreadedSimulatorImpl test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup simulator-tests
+ * A model of nodes which run random local events, send events to each
+ * other, and are read and written by periodic events without context.
+ * Everything the events observe is traced, to compare the simulations.
+ */
+class ParallelModel
+{
+  public:
+    /** Number of nodes. */
+    static constexpr uint32_t NODES = 8;
+    /** The shortest delay between two nodes, in microseconds. */
+    static constexpr uint32_t LOOKAHEAD = 5;
+
+    /** Constructor. */
+    ParallelModel();
+
+    /** Schedule the first events of the nodes and of the events without context. */
+    void Start();
+
+    std::ostringstream m_traces[NODES]; //!< What each node observed
+    std::ostringstream m_global;        //!< What the events without context observed
+    std::ostringstream m_destroy;       //!< Order of the events run at Simulator::Destroy()
+
+  private:
+    /**
+     * \param [in] node A node.
+     * \return The next random number of the node.
+     */
+    uint32_t Draw(uint32_t node);
+    /**
+     * Main event of a node, which schedules the next one.
+     * \param [in] node The node.
+     */
+    void Fire(uint32_t node);
+    /**
+     * Event sent by another node or by an event without context.
+     * \param [in] node The node.
+     * \param [in] from The sender, or NODES for an event without context.
+     * \param [in] value The value sent.
+     */
+    void Receive(uint32_t node, uint32_t from, uint64_t value);
+    /**
+     * Event which can be cancelled.
+     * \param [in] node The node.
+     */
+    void Timeout(uint32_t node);
+    /** Periodic event without context. */
+    void Global();
+    /**
+     * Event run at Simulator::Destroy().
+     * \param [in] node The node which scheduled it.
+     * \param [in] value Its value at this time.
+     */
+    void Destroyed(uint32_t node, uint64_t value);
+
+    uint64_t m_rng[NODES];    //!< State of the random numbers of each node
+    uint64_t m_value[NODES];  //!< Value of each node
+    EventId m_timeout[NODES]; //!< Timeout of each node
+};
+
+ParallelModel::ParallelModel()
+{
+    for (uint32_t i = 0; i < NODES; i++)
+    {
+        m_rng[i] = i + 1;
+        m_value[i] = 0;
+    }
+}
+
+uint32_t
+ParallelModel::Draw(uint32_t node)
+{
+    m_rng[node] = m_rng[node] * 6364136223846793005ULL + 1442695040888963407ULL;
+    return m_rng[node] >> 33;
+}
+
+void
+ParallelModel::Start()
+{
+    for (uint32_t i = 0; i < NODES; i++)
+    {
+        Simulator::ScheduleWithContext(i, MicroSeconds(i % 3), &ParallelModel::Fire, this, i);
+    }
+    Simulator::Schedule(MicroSeconds(7), &ParallelModel::Global, this);
+}
+
+void
+ParallelModel::Fire(uint32_t node)
+{
+    uint32_t r = Draw(node);
+    m_value[node] += r % 100;
+    std::ostream& trace = m_traces[node];
+    trace << Simulator::Now().GetMicroSeconds() << " fire " << m_value[node] << " "
+          << Simulator::GetContext() << " " << Simulator::IsExpired(m_timeout[node]) << " "
+          << Simulator::GetDelayLeft(m_timeout[node]).GetMicroSeconds() << "\n";
+
+    uint32_t delay = (r / 8) % 4;
+    switch (r % 8)
+    {
+    case 0:
+    case 1: {
+        uint32_t to = (node + 1 + (r / 32) % (NODES - 1)) % NODES;
+        Simulator::ScheduleWithContext(to,
+                                       MicroSeconds(LOOKAHEAD + delay),
+                                       &ParallelModel::Receive,
+                                       this,
+                                       to,
+                                       node,
+                                       m_value[node]);
+        break;
+    }
+    case 2:
+        if (!Simulator::IsExpired(m_timeout[node]))
+        {
+            trace << "cancel\n";
+            Simulator::Cancel(m_timeout[node]);
+        }
+        else
+        {
+            m_timeout[node] = Simulator::Schedule(MicroSeconds(delay * 3),
+                                                  &ParallelModel::Timeout,
+                                                  this,
+                                                  node);
+        }
+        break;
+    case 3:
+        if (r % 64 == 3)
+        {
+            Simulator::ScheduleDestroy(&ParallelModel::Destroyed, this, node, m_value[node]);
+        }
+        break;
+    case 4:
+        // events of the same time, run in their order of scheduling
+        Simulator::ScheduleNow(&ParallelModel::Receive, this, node, node, 1);
+        Simulator::Schedule(MicroSeconds(0), &ParallelModel::Receive, this, node, node, 2);
+        break;
+    default:
+        break;
+    }
+    Simulator::Schedule(MicroSeconds(delay), &ParallelModel::Fire, this, node);
+}
+
+void
+ParallelModel::Receive(uint32_t node, uint32_t from, uint64_t value)
+{
+    m_value[node] ^= value;
+    m_traces[node] << Simulator::Now().GetMicroSeconds() << " receive " << from << " " << value
+                   << " " << Simulator::GetContext() << "\n";
+}
+
+void
+ParallelModel::Timeout(uint32_t node)
+{
+    m_traces[node] << Simulator::Now().GetMicroSeconds() << " timeout "
+                   << Simulator::IsExpired(m_timeout[node]) << "\n";
+}
+
+void
+ParallelModel::Global()
+{
+    // the events without context see the state of all the nodes at this time
+    uint64_t sum = 0;
+    for (uint32_t i = 0; i < NODES; i++)
+    {
+        sum += m_value[i];
+    }
+    m_global << Simulator::Now().GetMicroSeconds() << " " << sum << " " << Simulator::GetContext()
+             << "\n";
+    uint32_t node = (Simulator::Now().GetMicroSeconds() / 7) % NODES;
+    m_value[node]++;
+    Simulator::ScheduleWithContext(node,
+                                   MicroSeconds(0),
+                                   &ParallelModel::Receive,
+                                   this,
+                                   node,
+                                   NODES,
+                                   sum);
+    Simulator::Schedule(MicroSeconds(7), &ParallelModel::Global, this);
+}
+
+void
+ParallelModel::Destroyed(uint32_t node, uint64_t value)
+{
+    m_destroy << node << " " << value << "\n";
+}
+
+/**
+ * \ingroup simulator-tests
+ * Run the model with MultithreadedSimulatorImpl, and compare its traces
+ * with the traces of DefaultSimulatorImpl.
+ */
+class MultithreadedSimulatorTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * \param [in] threads The number of threads.
+     * \param [in] grouped Whether to put the consecutive nodes in the same
+     *             partition, rather than the default partitions.
+     */
+    MultithreadedSimulatorTestCase(uint32_t threads, bool grouped);
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /**
+     * Run the model twice with the current simulator implementation.
+     * \param [in,out] model The model.
+     * \return The time at the end of each run.
+     */
+    std::string RunModel(ParallelModel& model);
+
+    uint32_t m_threads; //!< The number of threads
+    bool m_grouped;     //!< Whether the consecutive nodes are in the same partition
+};
+
+MultithreadedSimulatorTestCase::MultithreadedSimulatorTestCase(uint32_t threads, bool grouped)
+    : TestCase("Check the order of the events with " + std::to_string(threads) + " threads" +
+               (grouped ? " and grouped nodes" : "")),
+      m_threads(threads),
+      m_grouped(grouped)
+{
+}
+
+std::string
+MultithreadedSimulatorTestCase::RunModel(ParallelModel& model)
+{
+    std::ostringstream times;
+    model.Start();
+    Simulator::Stop(MicroSeconds(400));
+    Simulator::Run();
+    times << Simulator::Now().GetMicroSeconds() << " ";
+    // resume the simulation, with events scheduled between the runs
+    Simulator::ScheduleWithContext(Simulator::NO_CONTEXT,
+                                   MicroSeconds(0),
+                                   &ParallelModel::Start,
+                                   &model);
+    Simulator::Stop(MicroSeconds(300));
+    Simulator::Run();
+    times << Simulator::Now().GetMicroSeconds();
+    Simulator::Destroy();
+    return times.str();
+}
+
+void
+MultithreadedSimulatorTestCase::DoRun()
+{
+    ParallelModel reference;
+    std::string referenceTimes = RunModel(reference);
+
+    Config::SetGlobal("SimulatorImplementationType",
+                      StringValue("ns3::MultithreadedSimulatorImpl"));
+    Ptr<SimulatorImpl> impl = Simulator::GetImplementation();
+    impl->SetAttribute("Threads", UintegerValue(m_threads));
+    impl->SetAttribute("Lookahead", TimeValue(MicroSeconds(ParallelModel::LOOKAHEAD)));
+    if (m_grouped)
+    {
+        for (uint32_t i = 0; i < ParallelModel::NODES; i++)
+        {
+            DynamicCast<MultithreadedSimulatorImpl>(impl)->SetPartition(
+                i,
+                i * m_threads / ParallelModel::NODES);
+        }
+    }
+    impl = nullptr;
+    ParallelModel model;
+    std::string times = RunModel(model);
+
+    NS_TEST_EXPECT_MSG_EQ(times, referenceTimes, "Different times at the end of the runs");
+    for (uint32_t i = 0; i < ParallelModel::NODES; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ((model.m_traces[i].str() == reference.m_traces[i].str()),
+                              true,
+                              "Different events of node " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(model.m_global.str(),
+                          reference.m_global.str(),
+                          "Different events without context");
+    NS_TEST_EXPECT_MSG_EQ(model.m_destroy.str(),
+                          reference.m_destroy.str(),
+                          "Different order of the events at Simulator::Destroy()");
+}
+
+void
+MultithreadedSimulatorTestCase::DoTeardown()
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+}
+
+/**
+ * \ingroup simulator-tests
+ * MultithreadedSimulatorImpl test suite
+ */
+class MultithreadedSimulatorTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    MultithreadedSimulatorTestSuite()
+        : TestSuite("multithreaded-simulator")
+    {
+        AddTestCase(new MultithreadedSimulatorTestCase(1, false));
+        AddTestCase(new MultithreadedSimulatorTestCase(2, false));
+        AddTestCase(new MultithreadedSimulatorTestCase(4, false));
+        AddTestCase(new MultithreadedSimulatorTestCase(3, true));
+    }
+};
+
+/**
+ * \ingroup simulator-tests
+ * MultithreadedSimulatorTestSuite instance variable.
+ */
+static MultithreadedSimulatorTestSuite g_multithreadedSimulatorTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,141 @@
+#include "ns3/restartable-timer.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup timer
+ * \ingroup timer-tests
+ * RestartableTimer test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup timer-tests
+ *  RestartableTimer test
+ */
+class RestartableTimerTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    RestartableTimerTestCase();
+    void DoRun() override;
+    /**
+     * Function to invoke when the timer expires.
+     * \param arg The argument passed.
+     */
+    void Expire(int arg);
+    /**
+     * Restart the timer.
+     * \param delay The new delay.
+     */
+    void Restart(Time delay);
+    /**
+     * Cancel the timer.
+     */
+    void Cancel();
+
+    RestartableTimer m_timer;            //!< Tested timer
+    std::vector<Time> m_expiredTimes;    //!< Times when the timer expired
+    std::vector<int> m_expiredArguments; //!< Arguments supplied to the expired timer
+};
+
+RestartableTimerTestCase::RestartableTimerTestCase()
+    : TestCase("Check that a restartable timer follows its deadline")
+{
+}
+
+void
+RestartableTimerTestCase::Expire(int arg)
+{
+    NS_TEST_EXPECT_MSG_EQ(m_timer.IsRunning(), false, "The timer should not run in its function");
+    m_expiredTimes.push_back(Simulator::Now());
+    m_expiredArguments.push_back(arg);
+}
+
+void
+RestartableTimerTestCase::Restart(Time delay)
+{
+    m_timer.Schedule(delay);
+}
+
+void
+RestartableTimerTestCase::Cancel()
+{
+    m_timer.Cancel();
+}
+
+void
+RestartableTimerTestCase::DoRun()
+{
+    m_timer.SetFunction(&RestartableTimerTestCase::Expire, this);
+    m_timer.SetArguments(1);
+
+    // restarted every 5us with a 10us delay, then let expire: one event per 10us
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        Simulator::Schedule(MicroSeconds(5 * i),
+                            &RestartableTimerTestCase::Restart,
+                            this,
+                            MicroSeconds(10));
+    }
+    // cancelled then restarted after the deadline of the pending event
+    Simulator::Schedule(MicroSeconds(100), &RestartableTimerTestCase::Restart, this, Seconds(1));
+    Simulator::Schedule(MicroSeconds(110), &RestartableTimerTestCase::Cancel, this);
+    // restarted with a shorter delay than the pending event
+    Simulator::Schedule(MicroSeconds(120),
+                        &RestartableTimerTestCase::Restart,
+                        this,
+                        MicroSeconds(20));
+    // cancelled for good
+    Simulator::Schedule(MicroSeconds(200),
+                        &RestartableTimerTestCase::Restart,
+                        this,
+                        MicroSeconds(20));
+    Simulator::Schedule(MicroSeconds(210), &RestartableTimerTestCase::Cancel, this);
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_timer.IsRunning(), false, "The timer should have expired");
+    NS_TEST_ASSERT_MSG_EQ(m_timer.GetDelayLeft(), Seconds(0), "No delay left after expiring");
+    NS_TEST_ASSERT_MSG_EQ(m_expiredTimes.size(), 2, "The timer should have expired twice");
+    NS_TEST_EXPECT_MSG_EQ(m_expiredTimes[0], MicroSeconds(55), "Wrong first expiry");
+    NS_TEST_EXPECT_MSG_EQ(m_expiredTimes[1], MicroSeconds(140), "Wrong second expiry");
+    NS_TEST_EXPECT_MSG_EQ(m_expiredArguments[0], 1, "We did not get the right argument");
+    // 0us, 10us, 20us, 30us, 40us, 50us for the first expiry, then 100us, 120us and 200us
+    NS_TEST_EXPECT_MSG_EQ(m_timer.GetNScheduled(), 9, "Wrong number of scheduled events");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup timer-tests
+ *  RestartableTimer test suite
+ */
+class RestartableTimerTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    RestartableTimerTestSuite()
+        : TestSuite("restartable-timer")
+    {
+        AddTestCase(new RestartableTimerTestCase());
+    }
+};
+
+/**
+ * \ingroup timer-tests
+ * RestartableTimerTestSuite instance variable.
+ */
+static RestartableTimerTestSuite g_restartableTimerTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,151 @@
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator-context.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup core-tests
+ * \ingroup simulator
+ * \ingroup simulator-tests
+ * SimulatorContext test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * \ingroup simulator-tests
+ * Run the same simulations in the main thread and concurrently in
+ * several threads, and check that they give the same results.
+ */
+class SimulatorContextTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    SimulatorContextTestCase();
+    void DoRun() override;
+
+  private:
+    /**
+     * Run a simulation which schedules events after random delays.
+     *
+     * \param seed The rng seed of the simulation.
+     * \return The times of the events, in nanoseconds.
+     */
+    static std::vector<int64_t> RunSimulation(uint32_t seed);
+
+    /**
+     * Schedule the next event of the simulation.
+     *
+     * \param delay The random delays.
+     * \param times The times of the events run so far.
+     */
+    static void Step(Ptr<UniformRandomVariable> delay, std::vector<int64_t>* times);
+};
+
+SimulatorContextTestCase::SimulatorContextTestCase()
+    : TestCase("Check that threads run independent simulations")
+{
+}
+
+void
+SimulatorContextTestCase::Step(Ptr<UniformRandomVariable> delay, std::vector<int64_t>* times)
+{
+    times->push_back(Simulator::Now().GetNanoSeconds());
+    if (times->size() < 1000)
+    {
+        Simulator::Schedule(NanoSeconds(delay->GetInteger(1, 1000)),
+                            &SimulatorContextTestCase::Step,
+                            delay,
+                            times);
+    }
+}
+
+std::vector<int64_t>
+SimulatorContextTestCase::RunSimulation(uint32_t seed)
+{
+    RngSeedManager::SetSeed(seed);
+    RngSeedManager::SetRun(1);
+    std::vector<int64_t> times;
+    Ptr<UniformRandomVariable> delay = CreateObject<UniformRandomVariable>();
+    Simulator::Schedule(Seconds(0), &SimulatorContextTestCase::Step, delay, &times);
+    Simulator::Run();
+    Simulator::Destroy();
+    return times;
+}
+
+void
+SimulatorContextTestCase::DoRun()
+{
+    const uint32_t nThreads = 4;
+
+    uint32_t seed = RngSeedManager::GetSeed();
+    SimulatorContext::EnableThreadLocal();
+    NS_TEST_ASSERT_MSG_EQ(SimulatorContext::IsThreadLocal(), true, "Mode not enabled");
+
+    // each simulation alone in a fresh thread, then all of them at once
+    std::vector<std::vector<int64_t>> expected(nThreads);
+    for (uint32_t i = 0; i < nThreads; i++)
+    {
+        std::thread([i, &expected]() { expected[i] = RunSimulation(i + 1); }).join();
+    }
+    NS_TEST_ASSERT_MSG_EQ((expected[0] != expected[1]),
+                          true,
+                          "Different seeds should give different runs");
+
+    std::vector<std::vector<int64_t>> results(nThreads);
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < nThreads; i++)
+    {
+        threads.emplace_back([i, &results]() { results[i] = RunSimulation(i + 1); });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (uint32_t i = 0; i < nThreads; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(results[i].size(), 1000, "Wrong number of events in thread " << i);
+        NS_TEST_EXPECT_MSG_EQ((results[i] == expected[i]),
+                              true,
+                              "Thread " << i << " differs from the sequential run");
+    }
+
+    // the threads did not change the state of this one
+    NS_TEST_EXPECT_MSG_EQ(RngSeedManager::GetSeed(), seed, "Seed changed by the threads");
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), Seconds(0), "Time changed by the threads");
+}
+
+/**
+ * \ingroup simulator-tests
+ *  SimulatorContext test suite
+ */
+class SimulatorContextTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    SimulatorContextTestSuite()
+        : TestSuite("simulator-context")
+    {
+        AddTestCase(new SimulatorContextTestCase());
+    }
+};
+
+/**
+ * \ingroup simulator-tests
+ * SimulatorContextTestSuite instance variable.
+ */
+static SimulatorContextTestSuite g_simulatorContextTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -21,9 +21,12 @@
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
+#include "ns3/quad-heap-scheduler.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -211,6 +214,77 @@ SimulatorEventsTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(m_destroy, true, "Event should have run");
 }
 
+/**
+ * \ingroup simulator-tests
+ *
+ * \brief Check the order of the events of the QuadHeapScheduler after
+ * removing events from the middle of the heap.
+ */
+class QuadHeapSchedulerTestCase : public TestCase
+{
+  public:
+    QuadHeapSchedulerTestCase();
+    void DoRun() override;
+
+  private:
+    /** Event function, never invoked. */
+    static void Nothing();
+};
+
+QuadHeapSchedulerTestCase::QuadHeapSchedulerTestCase()
+    : TestCase("Check the order of the QuadHeapScheduler events after removals")
+{
+}
+
+void
+QuadHeapSchedulerTestCase::Nothing()
+{
+}
+
+void
+QuadHeapSchedulerTestCase::DoRun()
+{
+    const uint32_t nEvents = 1000;
+    Ptr<QuadHeapScheduler> scheduler = CreateObject<QuadHeapScheduler>();
+    std::vector<Scheduler::Event> events;
+    for (uint32_t i = 0; i < nEvents; i++)
+    {
+        // pseudo-random timestamps, with duplicates
+        Scheduler::Event ev{MakeEvent(&QuadHeapSchedulerTestCase::Nothing),
+                            {(i * 7919) % (nEvents / 2), i, 0}};
+        scheduler->Insert(ev);
+        events.push_back(ev);
+    }
+    // remove one event in three, including the root
+    uint32_t nRemoved = 0;
+    for (uint32_t i = 0; i < nEvents; i += 3)
+    {
+        scheduler->Remove(events[i]);
+        nRemoved++;
+    }
+
+    uint32_t nLeft = 0;
+    Scheduler::EventKey previous{0, 0, 0};
+    while (!scheduler->IsEmpty())
+    {
+        Scheduler::Event ev = scheduler->RemoveNext();
+        NS_TEST_EXPECT_MSG_NE(ev.key.m_uid % 3, 0, "Event " << ev.key.m_uid << " was removed");
+        NS_TEST_EXPECT_MSG_EQ(ev.impl, events[ev.key.m_uid].impl, "Wrong event");
+        if (nLeft > 0)
+        {
+            NS_TEST_EXPECT_MSG_EQ((previous < ev.key), true, "Events out of order");
+        }
+        previous = ev.key;
+        nLeft++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(nLeft, nEvents - nRemoved, "Wrong number of events");
+
+    for (auto& ev : events)
+    {
+        ev.impl->Unref();
+    }
+}
+
 /**
  * \ingroup simulator-tests
  *
@@ -730,6 +804,9 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
+        factory.SetTypeId(QuadHeapScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::QUICK);
+        AddTestCase(new QuadHeapSchedulerTestCase(), TestCase::QUICK);
     }
 };
 
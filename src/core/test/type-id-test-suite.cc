@@ -28,6 +28,7 @@
 #include <ctime>
 #include <iomanip>
 #include <iostream>
+#include <set>
 
 using namespace ns3;
 
@@ -343,6 +344,97 @@ DeprecatedAttributeTestCase::DoRun()
               << (tinfo.supportLevel == TypeId::DEPRECATED ? "deprecated" : "error") << std::endl;
 }
 
+/**
+ * \ingroup typeid-tests
+ *
+ * Check that the Attributes and TraceSources found by name are the
+ * first ones registered with that name on the TypeId or its parents.
+ */
+class LookupByNameTestCase : public TestCase
+{
+  public:
+    LookupByNameTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+LookupByNameTestCase::LookupByNameTestCase()
+    : TestCase("Check the Attributes and TraceSources found by name")
+{
+}
+
+void
+LookupByNameTestCase::DoRun()
+{
+    for (uint16_t i = 0; i < TypeId::GetRegisteredN(); ++i)
+    {
+        TypeId tid = TypeId::GetRegistered(i);
+        std::set<std::string> seen;
+        TypeId level = tid;
+        bool rooted = true;
+        while (true)
+        {
+            for (std::size_t j = 0; j < level.GetAttributeN(); ++j)
+            {
+                const TypeId::AttributeInformation& expected = level.PeekAttribute(j);
+                if (!seen.insert(expected.name).second ||
+                    expected.supportLevel != TypeId::SUPPORTED)
+                {
+                    continue;
+                }
+                TypeId::AttributeInformation info;
+                NS_TEST_ASSERT_MSG_EQ(tid.LookupAttributeByName(expected.name, &info),
+                                      true,
+                                      "Attribute " << expected.name << " not found on "
+                                                   << tid.GetName());
+                NS_TEST_EXPECT_MSG_EQ(info.checker,
+                                      expected.checker,
+                                      "Wrong attribute " << expected.name << " on "
+                                                         << tid.GetName());
+            }
+            for (std::size_t j = 0; j < level.GetTraceSourceN(); ++j)
+            {
+                TypeId::TraceSourceInformation expected = level.GetTraceSource(j);
+                if (!seen.insert("trace:" + expected.name).second ||
+                    expected.supportLevel != TypeId::SUPPORTED)
+                {
+                    continue;
+                }
+                TypeId::TraceSourceInformation info;
+                NS_TEST_EXPECT_MSG_EQ(tid.LookupTraceSourceByName(expected.name, &info),
+                                      expected.accessor,
+                                      "Wrong trace source " << expected.name << " on "
+                                                            << tid.GetName());
+            }
+            TypeId parent = level.GetParent();
+            if (parent == level)
+            {
+                break;
+            }
+            if (parent.GetUid() == 0)
+            {
+                // a type registered without parent can not look up missing names
+                rooted = false;
+                break;
+            }
+            level = parent;
+        }
+        if (!rooted)
+        {
+            continue;
+        }
+
+        TypeId::AttributeInformation info;
+        NS_TEST_EXPECT_MSG_EQ(tid.LookupAttributeByName("NoSuchAttribute", &info),
+                              false,
+                              "Found a missing attribute on " << tid.GetName());
+        NS_TEST_EXPECT_MSG_EQ(tid.LookupTraceSourceByName("NoSuchTraceSource"),
+                              nullptr,
+                              "Found a missing trace source on " << tid.GetName());
+    }
+}
+
 /**
  * \ingroup typeid-tests
  *
@@ -455,6 +547,7 @@ TypeIdTestSuite::TypeIdTestSuite()
     AddTestCase(new UniqueTypeIdTestCase, QUICK);
     AddTestCase(new CollisionTestCase, QUICK);
     AddTestCase(new DeprecatedAttributeTestCase, QUICK);
+    AddTestCase(new LookupByNameTestCase, QUICK);
 }
 
 /// Static variable for test initialization.
@@ -0,0 +1,102 @@
+#include "tcp-delayed-ack-stats-helper.h"
+
+#include "ns3/inet-socket-address.h"
+#include "ns3/log.h"
+#include "ns3/object-map.h"
+#include "ns3/tcp-l4-protocol.h"
+#include "ns3/tcp-socket-base.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TcpDelayedAckStatsHelper");
+
+namespace
+{
+
+/**
+ * \param address a socket address
+ * \return the address as addr:port, or "-" if it is not an IPv4 address
+ */
+std::string
+FormatAddress(const Address& address)
+{
+    if (!InetSocketAddress::IsMatchingType(address))
+    {
+        return "-";
+    }
+    InetSocketAddress inet = InetSocketAddress::ConvertFrom(address);
+    std::ostringstream oss;
+    oss << inet.GetIpv4() << ":" << inet.GetPort();
+    return oss.str();
+}
+
+} // namespace
+
+void
+TcpDelayedAckStatsHelper::Add(NodeContainer nodes)
+{
+    m_nodes.Add(nodes);
+}
+
+void
+TcpDelayedAckStatsHelper::Add(Ptr<Node> node)
+{
+    m_nodes.Add(node);
+}
+
+void
+TcpDelayedAckStatsHelper::PrintSummary(std::ostream& os) const
+{
+    os << "node\tlocal\tpeer\tsegments";
+    for (uint32_t t = 0; t < DelayedAckStats::N_TRIGGERS; t++)
+    {
+        os << "\t" << DelayedAckStats::GetTriggerName(static_cast<DelayedAckStats::Trigger>(t));
+    }
+    os << "\tacks_per_segment\tmean_delay_ms\tmax_delay_ms";
+    for (uint32_t i = 0; i < DelayedAckStats::DELAY_BUCKETS; i++)
+    {
+        os << "\th" << i;
+    }
+    os << "\n";
+
+    for (auto it = m_nodes.Begin(); it != m_nodes.End(); ++it)
+    {
+        Ptr<TcpL4Protocol> tcp = (*it)->GetObject<TcpL4Protocol>();
+        if (!tcp)
+        {
+            continue;
+        }
+        ObjectMapValue sockets;
+        tcp->GetAttribute("SocketList", sockets);
+        for (auto s = sockets.Begin(); s != sockets.End(); ++s)
+        {
+            Ptr<TcpSocketBase> socket = DynamicCast<TcpSocketBase>(s->second);
+            const DelayedAckStats& stats = socket->GetDelayedAckStats();
+            if (stats.segments == 0)
+            {
+                continue;
+            }
+            Address local;
+            Address peer;
+            socket->GetSockName(local);
+            socket->GetPeerName(peer);
+            os << (*it)->GetId() << "\t" << FormatAddress(local) << "\t" << FormatAddress(peer)
+               << "\t" << stats.segments;
+            for (auto n : stats.acks)
+            {
+                os << "\t" << n;
+            }
+            os << "\t" << stats.GetAcksPerSegment() << "\t"
+               << stats.GetMeanDelay().GetSeconds() * 1e3 << "\t"
+               << stats.maxDelay.GetSeconds() * 1e3;
+            for (auto n : stats.delayHistogram)
+            {
+                os << "\t" << n;
+            }
+            os << "\n";
+        }
+    }
+}
+
+} // namespace ns3
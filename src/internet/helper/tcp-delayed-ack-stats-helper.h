@@ -0,0 +1,52 @@
+#ifndef TCP_DELAYED_ACK_STATS_HELPER_H
+#define TCP_DELAYED_ACK_STATS_HELPER_H
+
+#include "ns3/node-container.h"
+
+#include <ostream>
+
+namespace ns3
+{
+
+/**
+ * \ingroup tcp
+ *
+ * \brief Report the delayed ACK statistics of the TCP sockets of a set of nodes.
+ *
+ * The statistics are kept by each socket (see DelayedAckStats), the helper
+ * only collects them: it prints one row per socket which received data, with
+ * the number of segments received, the ACKs sent per trigger, the ACKs per
+ * segment and the delay histogram.
+ *
+ * The report is built from the sockets known to the TcpL4Protocol of each
+ * node, so it should be printed after Simulator::Run and before
+ * Simulator::Destroy. Sockets already closed and removed are not reported.
+ */
+class TcpDelayedAckStatsHelper
+{
+  public:
+    /**
+     * \brief Add the nodes whose sockets are reported
+     * \param nodes the nodes
+     */
+    void Add(NodeContainer nodes);
+
+    /**
+     * \brief Add a node whose sockets are reported
+     * \param node the node
+     */
+    void Add(Ptr<Node> node);
+
+    /**
+     * \brief Print a tab-separated header and one row per socket which received data
+     * \param os the output stream
+     */
+    void PrintSummary(std::ostream& os) const;
+
+  private:
+    NodeContainer m_nodes; //!< Nodes whose sockets are reported
+};
+
+} // namespace ns3
+
+#endif /* TCP_DELAYED_ACK_STATS_HELPER_H */
@@ -24,6 +24,7 @@
 #include "ns3/assert.h"
 #include "ns3/log.h"
 #include "ns3/simulation-singleton.h"
+#include "ns3/simulator-context.h"
 
 namespace ns3
 {
@@ -62,7 +63,8 @@ GlobalRouteManager::AllocateRouterId()
 {
     NS_LOG_FUNCTION_NOARGS();
     static uint32_t routerId = 0;
-    return routerId++;
+    static thread_local uint32_t localRouterId = 0;
+    return SimulatorContext::Select(routerId, localRouterId)++;
 }
 
 } // namespace ns3
@@ -24,6 +24,7 @@
 
 #include "ns3/integer.h"
 #include "ns3/log.h"
+#include "ns3/net-device.h"
 
 namespace ns3
 {
@@ -82,4 +83,10 @@ IpL4Protocol::ReceiveIcmp(Ipv6Address icmpSource,
                          << icmpInfo << payloadSource << payloadDestination << payload);
 }
 
+void
+IpL4Protocol::ReceiveAggregateEnd(Ptr<NetDevice> device)
+{
+    NS_LOG_FUNCTION(this << device);
+}
+
 } // namespace ns3
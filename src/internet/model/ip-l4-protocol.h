@@ -39,6 +39,7 @@ class Ipv6Address;
 class Ipv6Interface;
 class Ipv4Route;
 class Ipv6Route;
+class NetDevice;
 
 /**
  * \ingroup internet
@@ -146,6 +147,17 @@ class IpL4Protocol : public Object
                              Ipv6Address payloadDestination,
                              const uint8_t payload[8]);
 
+    /**
+     * \brief Called from lower-level layers when a device has delivered the
+     * last packet of an aggregate (e.g., the last MPDU of a Wi-Fi A-MPDU).
+     *
+     * The packets of the aggregate have already been received when this is
+     * called. The default implementation does nothing.
+     *
+     * \param device the device which received the aggregate
+     */
+    virtual void ReceiveAggregateEnd(Ptr<NetDevice> device);
+
     /**
      * \brief callback to send packets over IPv4
      */
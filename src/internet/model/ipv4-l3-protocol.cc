@@ -322,6 +322,10 @@ Ipv4L3Protocol::DoDispose()
 
     for (auto i = m_interfaces.begin(); i != m_interfaces.end(); ++i)
     {
+        Ptr<NetDevice> device = (*i)->GetDevice();
+        device->TraceDisconnectWithoutContext(
+            "RxAggregateEnd",
+            MakeCallback(&Ipv4L3Protocol::RxAggregateEnd, this).Bind(device));
         *i = nullptr;
     }
     m_interfaces.clear();
@@ -420,6 +424,10 @@ Ipv4L3Protocol::AddInterface(Ptr<NetDevice> device)
         MakeCallback(&ArpL3Protocol::Receive, PeekPointer(GetObject<ArpL3Protocol>())),
         ArpL3Protocol::PROT_NUMBER,
         device);
+    // devices which aggregate frames (e.g., Wi-Fi) signal the end of each aggregate
+    device->TraceConnectWithoutContext(
+        "RxAggregateEnd",
+        MakeCallback(&Ipv4L3Protocol::RxAggregateEnd, this).Bind(device));
 
     Ptr<Ipv4Interface> interface = CreateObject<Ipv4Interface>();
     interface->SetNode(m_node);
@@ -1164,6 +1172,20 @@ Ipv4L3Protocol::LocalDeliver(Ptr<const Packet> packet, const Ipv4Header& ip, uin
     }
 }
 
+void
+Ipv4L3Protocol::RxAggregateEnd(Ptr<NetDevice> device)
+{
+    NS_LOG_FUNCTION(this << device);
+    int32_t iif = GetInterfaceForDevice(device);
+    for (const auto& [key, protocol] : m_protocols)
+    {
+        if (key.second == -1 || key.second == iif)
+        {
+            protocol->ReceiveAggregateEnd(device);
+        }
+    }
+}
+
 bool
 Ipv4L3Protocol::AddAddress(uint32_t i, Ipv4InterfaceAddress address)
 {
@@ -359,6 +359,17 @@ class Ipv4L3Protocol : public Ipv4
      */
     void LocalDeliver(Ptr<const Packet> p, const Ipv4Header& ip, uint32_t iif);
 
+    /**
+     * \brief Notify the transport protocols that a device has delivered the
+     * last packet of an aggregate.
+     *
+     * Connected to the "RxAggregateEnd" trace source of the devices which
+     * provide one (e.g., WifiNetDevice).
+     *
+     * \param device the device which received the aggregate
+     */
+    void RxAggregateEnd(Ptr<NetDevice> device);
+
     /**
      * \brief Fallback when no route is found.
      * \param p packet
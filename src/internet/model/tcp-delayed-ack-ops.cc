@@ -0,0 +1,561 @@
+#include "tcp-delayed-ack-ops.h"
+
+#include "tcp-socket-state.h"
+
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TcpDelayedAckOps");
+
+NS_OBJECT_ENSURE_REGISTERED(TcpDelayedAckOps);
+
+TypeId
+TcpDelayedAckOps::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::TcpDelayedAckOps").SetParent<Object>().SetGroupName("Internet");
+    return tid;
+}
+
+TcpDelayedAckOps::TcpDelayedAckOps()
+    : Object()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TcpDelayedAckOps::TcpDelayedAckOps(const TcpDelayedAckOps& other)
+    : Object(other)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TcpDelayedAckOps::~TcpDelayedAckOps()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+TcpDelayedAckOps::SetAdvWndCallback(Callback<uint16_t, bool> advWndCallback)
+{
+    NS_LOG_FUNCTION(this);
+    m_advWndCb = advWndCallback;
+}
+
+void
+TcpDelayedAckOps::SegmentReceived(Ptr<TcpSocketState> tcb)
+{
+    NS_LOG_FUNCTION(this << tcb);
+}
+
+void
+TcpDelayedAckOps::OutOfOrderReceived(Ptr<TcpSocketState> tcb)
+{
+    NS_LOG_FUNCTION(this << tcb);
+}
+
+void
+TcpDelayedAckOps::DelAckTimeoutExpired(Ptr<TcpSocketState> tcb)
+{
+    NS_LOG_FUNCTION(this << tcb);
+}
+
+bool
+TcpDelayedAckOps::RestartTimerOnSegment() const
+{
+    return false;
+}
+
+bool
+TcpDelayedAckOps::AggregateEndReceived(Ptr<TcpSocketState> tcb)
+{
+    NS_LOG_FUNCTION(this << tcb);
+    return false;
+}
+
+// Classic delayed ACK
+
+NS_OBJECT_ENSURE_REGISTERED(TcpDelayedAckClassic);
+
+TypeId
+TcpDelayedAckClassic::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::TcpDelayedAckClassic")
+                            .SetParent<TcpDelayedAckOps>()
+                            .SetGroupName("Internet")
+                            .AddConstructor<TcpDelayedAckClassic>();
+    return tid;
+}
+
+TcpDelayedAckClassic::TcpDelayedAckClassic()
+    : TcpDelayedAckOps()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TcpDelayedAckClassic::TcpDelayedAckClassic(const TcpDelayedAckClassic& other)
+    : TcpDelayedAckOps(other)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TcpDelayedAckClassic::~TcpDelayedAckClassic()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+std::string
+TcpDelayedAckClassic::GetName() const
+{
+    return "TcpDelayedAckClassic";
+}
+
+uint32_t
+TcpDelayedAckClassic::GetDelayWindow(Ptr<const TcpSocketState> tcb [[maybe_unused]],
+                                     uint32_t delAckMaxCount) const
+{
+    return delAckMaxCount;
+}
+
+Time
+TcpDelayedAckClassic::GetDelayTimeout(Ptr<const TcpSocketState> tcb [[maybe_unused]],
+                                      uint32_t delAckCount [[maybe_unused]],
+                                      uint32_t delAckMaxCount [[maybe_unused]],
+                                      Time delAckTimeout) const
+{
+    return delAckTimeout;
+}
+
+Ptr<TcpDelayedAckOps>
+TcpDelayedAckClassic::Fork()
+{
+    return CopyObject<TcpDelayedAckClassic>(this);
+}
+
+// IAT based delayed ACK
+
+NS_OBJECT_ENSURE_REGISTERED(TcpDelayedAckIatOps);
+
+TypeId
+TcpDelayedAckIatOps::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::TcpDelayedAckIatOps")
+            .SetParent<TcpDelayedAckOps>()
+            .SetGroupName("Internet")
+            .AddAttribute("Alpha",
+                          "Alpha parameter from ADW and AAD (used in smoothing function)",
+                          DoubleValue(0.75),
+                          MakeDoubleAccessor(&TcpDelayedAckIatOps::m_alpha),
+                          MakeDoubleChecker<double>(0, 1))
+            .AddAttribute("IatThreshold",
+                          "All considered IAT values must be higher than this threshold",
+                          DoubleValue(5e-5),
+                          MakeDoubleAccessor(&TcpDelayedAckIatOps::m_iatThreshold),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("BaseIatWindow",
+                          "Length of the window over which the base IAT is the minimum IAT",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&TcpDelayedAckIatOps::m_baseIatWindow),
+                          MakeTimeChecker(Time(0)))
+            .AddAttribute("BaseIatWindowRtts",
+                          "If not zero, length of the base IAT window in minimum RTTs. "
+                          "BaseIatWindow is used as long as the RTT is unknown",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&TcpDelayedAckIatOps::m_baseIatWindowRtts),
+                          MakeUintegerChecker<uint32_t>());
+    return tid;
+}
+
+TcpDelayedAckIatOps::TcpDelayedAckIatOps()
+    : TcpDelayedAckOps(),
+      m_baseIatFilter(m_baseIatWindow.GetNanoSeconds(), 0, 0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TcpDelayedAckIatOps::TcpDelayedAckIatOps(const TcpDelayedAckIatOps& other)
+    : TcpDelayedAckOps(other),
+      m_alpha(other.m_alpha),
+      m_iatThreshold(other.m_iatThreshold),
+      m_baseIatWindow(other.m_baseIatWindow),
+      m_baseIatWindowRtts(other.m_baseIatWindowRtts),
+      m_iat(other.m_iat),
+      m_baseIat(other.m_baseIat),
+      m_baseIatFilter(other.m_baseIatFilter),
+      m_lastPacketTime(other.m_lastPacketTime)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TcpDelayedAckIatOps::~TcpDelayedAckIatOps()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+TcpDelayedAckIatOps::SegmentReceived(Ptr<TcpSocketState> tcb)
+{
+    NS_LOG_FUNCTION(this << tcb);
+
+    // can't calculate iat for the first packet
+    if (m_lastPacketTime != Time::Min())
+    {
+        m_iat = (Simulator::Now() - m_lastPacketTime).GetSeconds();
+        // skip too small IATs
+        if (m_iat >= m_iatThreshold)
+        {
+            IatSampled(tcb);
+        }
+        else
+        {
+            NS_LOG_DEBUG("Got very small IAT = " << m_iat << ", skipping it");
+        }
+    }
+    m_lastPacketTime = Simulator::Now();
+}
+
+bool
+TcpDelayedAckIatOps::RestartTimerOnSegment() const
+{
+    return true;
+}
+
+double
+TcpDelayedAckIatOps::GetIat() const
+{
+    return m_iat;
+}
+
+double
+TcpDelayedAckIatOps::GetBaseIat() const
+{
+    return m_baseIat;
+}
+
+void
+TcpDelayedAckIatOps::IatSampled(Ptr<TcpSocketState> tcb)
+{
+    NS_LOG_FUNCTION(this << tcb);
+    m_baseIatFilter.SetWindowLength(GetBaseIatWindow(tcb).GetNanoSeconds());
+    m_baseIatFilter.Update(m_iat, Simulator::Now().GetNanoSeconds());
+    m_baseIat = m_baseIatFilter.GetBest();
+}
+
+double
+TcpDelayedAckIatOps::GetSmoothedIat() const
+{
+    return m_alpha * m_baseIat + (1 - m_alpha) * m_iat;
+}
+
+Time
+TcpDelayedAckIatOps::GetBaseIatWindow(Ptr<const TcpSocketState> tcb) const
+{
+    if (m_baseIatWindowRtts > 0 && tcb->m_minRtt != Time::Max())
+    {
+        return tcb->m_minRtt * m_baseIatWindowRtts;
+    }
+    return m_baseIatWindow;
+}
+
+// TCP-AAD
+
+NS_OBJECT_ENSURE_REGISTERED(TcpDelayedAckAad);
+
+TypeId
+TcpDelayedAckAad::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::TcpDelayedAckAad")
+                            .SetParent<TcpDelayedAckIatOps>()
+                            .SetGroupName("Internet")
+                            .AddConstructor<TcpDelayedAckAad>()
+                            .AddAttribute("Beta",
+                                          "Beta parameter from AAD algo",
+                                          DoubleValue(3),
+                                          MakeDoubleAccessor(&TcpDelayedAckAad::m_beta),
+                                          MakeDoubleChecker<double>(0));
+    return tid;
+}
+
+TcpDelayedAckAad::TcpDelayedAckAad()
+    : TcpDelayedAckIatOps()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TcpDelayedAckAad::TcpDelayedAckAad(const TcpDelayedAckAad& other)
+    : TcpDelayedAckIatOps(other),
+      m_beta(other.m_beta)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TcpDelayedAckAad::~TcpDelayedAckAad()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+std::string
+TcpDelayedAckAad::GetName() const
+{
+    return "TcpDelayedAckAad";
+}
+
+uint32_t
+TcpDelayedAckAad::GetDelayWindow(Ptr<const TcpSocketState> tcb [[maybe_unused]],
+                                 uint32_t delAckMaxCount [[maybe_unused]]) const
+{
+    // amount of packets is limited by timeout
+    return std::numeric_limits<uint32_t>::max();
+}
+
+Time
+TcpDelayedAckAad::GetDelayTimeout(Ptr<const TcpSocketState> tcb [[maybe_unused]],
+                                  uint32_t delAckCount,
+                                  uint32_t delAckMaxCount,
+                                  Time delAckTimeout) const
+{
+    // use default algorithm for first `delAckMaxCount` packets, and until
+    // an IAT has been sampled
+    if (delAckCount < delAckMaxCount || m_baseIat == INFINITY)
+    {
+        return delAckTimeout;
+    }
+    return std::min(Seconds(m_beta * GetSmoothedIat()), delAckTimeout);
+}
+
+Ptr<TcpDelayedAckOps>
+TcpDelayedAckAad::Fork()
+{
+    return CopyObject<TcpDelayedAckAad>(this);
+}
+
+// TCP-ADW
+
+NS_OBJECT_ENSURE_REGISTERED(TcpDelayedAckAdw);
+
+TypeId
+TcpDelayedAckAdw::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::TcpDelayedAckAdw")
+                            .SetParent<TcpDelayedAckIatOps>()
+                            .SetGroupName("Internet")
+                            .AddConstructor<TcpDelayedAckAdw>()
+                            .AddAttribute("Lambda",
+                                          "Lambda parameter from ADW algo",
+                                          DoubleValue(3),
+                                          MakeDoubleAccessor(&TcpDelayedAckAdw::m_lambda),
+                                          MakeDoubleChecker<double>(0));
+    return tid;
+}
+
+TcpDelayedAckAdw::TcpDelayedAckAdw()
+    : TcpDelayedAckIatOps()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TcpDelayedAckAdw::TcpDelayedAckAdw(const TcpDelayedAckAdw& other)
+    : TcpDelayedAckIatOps(other),
+      m_lambda(other.m_lambda),
+      m_dwnd(other.m_dwnd)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TcpDelayedAckAdw::~TcpDelayedAckAdw()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+std::string
+TcpDelayedAckAdw::GetName() const
+{
+    return "TcpDelayedAckAdw";
+}
+
+void
+TcpDelayedAckAdw::SegmentReceived(Ptr<TcpSocketState> tcb)
+{
+    NS_LOG_FUNCTION(this << tcb);
+    if (m_lastPacketTime == Time::Min())
+    {
+        // init delay window on the first packet
+        m_dwnd = m_lambda * tcb->m_segmentSize;
+    }
+    TcpDelayedAckIatOps::SegmentReceived(tcb);
+}
+
+void
+TcpDelayedAckAdw::OutOfOrderReceived(Ptr<TcpSocketState> tcb)
+{
+    NS_LOG_FUNCTION(this << tcb);
+    NS_LOG_DEBUG("out of order packet, reset dwnd to " << m_lambda);
+    m_dwnd = m_lambda * tcb->m_segmentSize;
+}
+
+void
+TcpDelayedAckAdw::DelAckTimeoutExpired(Ptr<TcpSocketState> tcb)
+{
+    NS_LOG_FUNCTION(this << tcb);
+    m_dwnd = std::max(m_lambda * tcb->m_segmentSize, m_dwnd - (1 - GetTimeRatio()));
+}
+
+uint32_t
+TcpDelayedAckAdw::GetDelayWindow(Ptr<const TcpSocketState> tcb,
+                                 uint32_t delAckMaxCount [[maybe_unused]]) const
+{
+    return static_cast<uint32_t>(std::ceil(m_dwnd / tcb->m_segmentSize));
+}
+
+Time
+TcpDelayedAckAdw::GetDelayTimeout(Ptr<const TcpSocketState> tcb [[maybe_unused]],
+                                  uint32_t delAckCount [[maybe_unused]],
+                                  uint32_t delAckMaxCount [[maybe_unused]],
+                                  Time delAckTimeout) const
+{
+    if (m_baseIat == INFINITY)
+    {
+        return delAckTimeout;
+    }
+    return std::min(Seconds(m_lambda * GetSmoothedIat()), delAckTimeout);
+}
+
+Ptr<TcpDelayedAckOps>
+TcpDelayedAckAdw::Fork()
+{
+    return CopyObject<TcpDelayedAckAdw>(this);
+}
+
+double
+TcpDelayedAckAdw::GetTimeRatio() const
+{
+    double timeRatio;
+
+    if (m_iat < m_lambda * m_baseIat)
+    {
+        timeRatio = (m_baseIat - m_iat) / m_baseIat;
+    }
+    else
+    {
+        timeRatio = 1 - m_lambda;
+    }
+    NS_LOG_DEBUG("Theta = " << (timeRatio + (m_lambda - 1)) / m_lambda);
+
+    return (timeRatio + (m_lambda - 1)) / m_lambda;
+}
+
+double
+TcpDelayedAckAdw::GetDwnd() const
+{
+    return m_dwnd;
+}
+
+void
+TcpDelayedAckAdw::IatSampled(Ptr<TcpSocketState> tcb)
+{
+    NS_LOG_FUNCTION(this << tcb);
+    TcpDelayedAckIatOps::IatSampled(tcb);
+    UpdateDelayWindow(tcb, GetTimeRatio());
+}
+
+void
+TcpDelayedAckAdw::UpdateDelayWindow(Ptr<const TcpSocketState> tcb, double theta)
+{
+    NS_LOG_FUNCTION(this << tcb << theta);
+
+    if (tcb->m_rcvCwndDiff > 0)
+    {
+        double R = std::min(tcb->m_rcvCwndValue, static_cast<uint32_t>(m_advWndCb(false)));
+        m_dwnd = std::min(m_dwnd + (1 - theta) * tcb->m_segmentSize, R);
+    }
+    else if (tcb->m_rcvCwndDiff < 0)
+    {
+        m_dwnd = m_lambda * tcb->m_segmentSize;
+    }
+
+    NS_LOG_INFO("Delay window updated = " << m_dwnd << ", cwndDiff=" << tcb->m_rcvCwndDiff
+                                          << " recvCwnd=" << tcb->m_rcvCwndValue);
+}
+
+// Aggregate end driven delayed ACK
+
+NS_OBJECT_ENSURE_REGISTERED(TcpDelayedAckAggregateEnd);
+
+TypeId
+TcpDelayedAckAggregateEnd::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::TcpDelayedAckAggregateEnd")
+                            .SetParent<TcpDelayedAckOps>()
+                            .SetGroupName("Internet")
+                            .AddConstructor<TcpDelayedAckAggregateEnd>();
+    return tid;
+}
+
+TcpDelayedAckAggregateEnd::TcpDelayedAckAggregateEnd()
+    : TcpDelayedAckOps()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TcpDelayedAckAggregateEnd::TcpDelayedAckAggregateEnd(const TcpDelayedAckAggregateEnd& other)
+    : TcpDelayedAckOps(other),
+      m_aggregating(other.m_aggregating)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TcpDelayedAckAggregateEnd::~TcpDelayedAckAggregateEnd()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+std::string
+TcpDelayedAckAggregateEnd::GetName() const
+{
+    return "TcpDelayedAckAggregateEnd";
+}
+
+bool
+TcpDelayedAckAggregateEnd::AggregateEndReceived(Ptr<TcpSocketState> tcb)
+{
+    NS_LOG_FUNCTION(this << tcb);
+    m_aggregating = true;
+    return true;
+}
+
+uint32_t
+TcpDelayedAckAggregateEnd::GetDelayWindow(Ptr<const TcpSocketState> tcb [[maybe_unused]],
+                                          uint32_t delAckMaxCount) const
+{
+    if (!m_aggregating)
+    {
+        return delAckMaxCount;
+    }
+    // amount of packets is limited by the end of the aggregate
+    return std::numeric_limits<uint32_t>::max();
+}
+
+Time
+TcpDelayedAckAggregateEnd::GetDelayTimeout(Ptr<const TcpSocketState> tcb [[maybe_unused]],
+                                           uint32_t delAckCount [[maybe_unused]],
+                                           uint32_t delAckMaxCount [[maybe_unused]],
+                                           Time delAckTimeout) const
+{
+    return delAckTimeout;
+}
+
+Ptr<TcpDelayedAckOps>
+TcpDelayedAckAggregateEnd::Fork()
+{
+    return CopyObject<TcpDelayedAckAggregateEnd>(this);
+}
+
+} // namespace ns3
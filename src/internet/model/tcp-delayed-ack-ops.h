@@ -0,0 +1,487 @@
+#ifndef TCP_DELAYED_ACK_OPS_H
+#define TCP_DELAYED_ACK_OPS_H
+
+#include "windowed-filter.h"
+
+#include "ns3/callback.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+
+#include <cmath>
+
+namespace ns3
+{
+
+class TcpSocketState;
+
+/**
+ * \ingroup tcp
+ * \defgroup delayedAckOps Delayed ACK Algorithms.
+ *
+ * The various policies used by a TCP receiver to decide when a delayed
+ * ACK has to be sent. The interface is defined in class TcpDelayedAckOps.
+ */
+
+/**
+ * \ingroup delayedAckOps
+ *
+ * \brief Delayed ACK policy abstract class
+ *
+ * The design follows TcpCongestionOps and TcpRecoveryOps: the delayed ACK
+ * decision is split from the main socket code, and it is a pluggable
+ * component. The socket notifies the policy about received data segments,
+ * out-of-order arrivals and delayed ACK timer expirations, and asks it two
+ * questions for every in-order segment:
+ *
+ * - how many segments may be acknowledged by a single ACK (GetDelayWindow)
+ * - how long an ACK may be delayed (GetDelayTimeout)
+ *
+ * \see TcpDelayedAckClassic
+ * \see TcpDelayedAckAad
+ * \see TcpDelayedAckAdw
+ * \see TcpDelayedAckAggregateEnd
+ */
+class TcpDelayedAckOps : public Object
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief Constructor
+     */
+    TcpDelayedAckOps();
+
+    /**
+     * \brief Copy constructor.
+     * \param other object to copy.
+     */
+    TcpDelayedAckOps(const TcpDelayedAckOps& other);
+
+    /**
+     * \brief Deconstructor
+     */
+    ~TcpDelayedAckOps() override;
+
+    /**
+     * \brief Get the name of the delayed ACK policy
+     *
+     * \return A string identifying the name
+     */
+    virtual std::string GetName() const = 0;
+
+    /**
+     * \brief Set the callback used to query the receiver advertised window
+     *
+     * The argument of the callback tells whether the window has to be scaled.
+     *
+     * \param advWndCallback advertised window callback
+     */
+    void SetAdvWndCallback(Callback<uint16_t, bool> advWndCallback);
+
+    /**
+     * \brief A data segment has been received
+     *
+     * Called for every data segment, before it is inserted in the Rx buffer.
+     *
+     * \param tcb internal congestion state
+     */
+    virtual void SegmentReceived(Ptr<TcpSocketState> tcb);
+
+    /**
+     * \brief A segment filled or created a hole in the Rx buffer
+     *
+     * The socket sends an immediate ACK after this call.
+     *
+     * \param tcb internal congestion state
+     */
+    virtual void OutOfOrderReceived(Ptr<TcpSocketState> tcb);
+
+    /**
+     * \brief The delayed ACK timer expired
+     *
+     * \param tcb internal congestion state
+     */
+    virtual void DelAckTimeoutExpired(Ptr<TcpSocketState> tcb);
+
+    /**
+     * \brief Whether the pending delayed ACK timer has to be re-armed on
+     * every in-order segment
+     *
+     * \return true if the timer restarts on each in-order segment
+     */
+    virtual bool RestartTimerOnSegment() const;
+
+    /**
+     * \brief The device which received the last segment signalled the end
+     * of an aggregate (e.g., the last MPDU of an A-MPDU)
+     *
+     * \param tcb internal congestion state
+     * \return true if the segments not acknowledged yet have to be
+     *         acknowledged now
+     */
+    virtual bool AggregateEndReceived(Ptr<TcpSocketState> tcb);
+
+    /**
+     * \brief Get the number of in-order segments that triggers an ACK
+     *
+     * \param tcb internal congestion state
+     * \param delAckMaxCount the socket DelAckCount attribute
+     * \return the delay window, in segments
+     */
+    virtual uint32_t GetDelayWindow(Ptr<const TcpSocketState> tcb,
+                                    uint32_t delAckMaxCount) const = 0;
+
+    /**
+     * \brief Get the time an ACK may be delayed
+     *
+     * \param tcb internal congestion state
+     * \param delAckCount number of segments not acknowledged yet
+     * \param delAckMaxCount the socket DelAckCount attribute
+     * \param delAckTimeout the socket DelAckTimeout attribute
+     * \return the delayed ACK timeout
+     */
+    virtual Time GetDelayTimeout(Ptr<const TcpSocketState> tcb,
+                                 uint32_t delAckCount,
+                                 uint32_t delAckMaxCount,
+                                 Time delAckTimeout) const = 0;
+
+    /**
+     * \brief Copy the delayed ACK policy across socket
+     *
+     * \return a pointer of the copied object
+     */
+    virtual Ptr<TcpDelayedAckOps> Fork() = 0;
+
+  protected:
+    Callback<uint16_t, bool> m_advWndCb; //!< Advertised window callback
+};
+
+/**
+ * \ingroup delayedAckOps
+ *
+ * \brief The classic delayed ACK policy
+ *
+ * An ACK is sent every DelAckCount in-order segments, or when
+ * DelAckTimeout expires (\RFC{1122}, \RFC{5681}). This is the default.
+ */
+class TcpDelayedAckClassic : public TcpDelayedAckOps
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief Constructor
+     */
+    TcpDelayedAckClassic();
+
+    /**
+     * \brief Copy constructor.
+     * \param other object to copy.
+     */
+    TcpDelayedAckClassic(const TcpDelayedAckClassic& other);
+
+    /**
+     * \brief Deconstructor
+     */
+    ~TcpDelayedAckClassic() override;
+
+    std::string GetName() const override;
+
+    uint32_t GetDelayWindow(Ptr<const TcpSocketState> tcb, uint32_t delAckMaxCount) const override;
+
+    Time GetDelayTimeout(Ptr<const TcpSocketState> tcb,
+                         uint32_t delAckCount,
+                         uint32_t delAckMaxCount,
+                         Time delAckTimeout) const override;
+
+    Ptr<TcpDelayedAckOps> Fork() override;
+};
+
+/**
+ * \ingroup delayedAckOps
+ *
+ * \brief Base class for policies driven by the segment inter-arrival time
+ *
+ * Keeps the last inter-arrival time (IAT) and its minimum (base IAT).
+ * IAT samples smaller than IatThreshold do not update the base IAT, as
+ * they come from segments delivered back-to-back by the lower layers.
+ *
+ * The base IAT is the minimum over a sliding window (BaseIatWindow, or
+ * BaseIatWindowRtts minimum RTTs), tracked with the Kathleen Nichols'
+ * windowed filter also used by TcpBbr, so that it follows an increase of the
+ * IAT without dropping its history.
+ */
+class TcpDelayedAckIatOps : public TcpDelayedAckOps
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief Constructor
+     */
+    TcpDelayedAckIatOps();
+
+    /**
+     * \brief Copy constructor.
+     * \param other object to copy.
+     */
+    TcpDelayedAckIatOps(const TcpDelayedAckIatOps& other);
+
+    /**
+     * \brief Deconstructor
+     */
+    ~TcpDelayedAckIatOps() override;
+
+    void SegmentReceived(Ptr<TcpSocketState> tcb) override;
+
+    bool RestartTimerOnSegment() const override;
+
+    /**
+     * \brief Get the last inter-arrival time
+     * \return the IAT, in seconds
+     */
+    double GetIat() const;
+
+    /**
+     * \brief Get the minimum inter-arrival time
+     * \return the base IAT, in seconds
+     */
+    double GetBaseIat() const;
+
+  protected:
+    /**
+     * \brief A new IAT sample has been accepted
+     *
+     * The default implementation updates the base IAT.
+     *
+     * \param tcb internal congestion state
+     */
+    virtual void IatSampled(Ptr<TcpSocketState> tcb);
+
+    /**
+     * \brief Get the IAT smoothed towards the base IAT
+     * \return alpha * baseIat + (1 - alpha) * iat, in seconds
+     */
+    double GetSmoothedIat() const;
+
+    /**
+     * \brief Get the length of the base IAT window
+     * \param tcb internal congestion state
+     * \return BaseIatWindowRtts times the minimum RTT if set and known, BaseIatWindow otherwise
+     */
+    Time GetBaseIatWindow(Ptr<const TcpSocketState> tcb) const;
+
+    typedef WindowedFilter<double, MinFilter<double>, int64_t, int64_t>
+        BaseIatFilter_t; //!< Definition of the base IAT filter, timestamps in nanoseconds.
+
+    double m_alpha{0.75};               //!< Smoothing factor of the IAT
+    double m_iatThreshold{5e-5};        //!< Smallest IAT taken into account
+    Time m_baseIatWindow{Seconds(1)};   //!< Length of the base IAT window
+    uint32_t m_baseIatWindowRtts{0};    //!< Length of the base IAT window, in RTTs
+    double m_iat{INFINITY};             //!< Last IAT
+    double m_baseIat{INFINITY};         //!< Minimum IAT
+    BaseIatFilter_t m_baseIatFilter;    //!< Windowed minimum of the IAT
+    Time m_lastPacketTime{Time::Min()}; //!< Arrival time of the last segment
+};
+
+/**
+ * \ingroup delayedAckOps
+ *
+ * \brief Aggregation-Aware Delayed ACK (TCP-AAD)
+ *
+ * ACKs are not limited by a segment count: the delayed ACK timer is
+ * restarted on every in-order segment with a timeout of Beta times the
+ * smoothed IAT, so that one ACK is sent after the last segment of a
+ * burst (e.g. an A-MPDU). The first DelAckCount segments after an ACK
+ * use the classic timeout.
+ */
+class TcpDelayedAckAad : public TcpDelayedAckIatOps
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief Constructor
+     */
+    TcpDelayedAckAad();
+
+    /**
+     * \brief Copy constructor.
+     * \param other object to copy.
+     */
+    TcpDelayedAckAad(const TcpDelayedAckAad& other);
+
+    /**
+     * \brief Deconstructor
+     */
+    ~TcpDelayedAckAad() override;
+
+    std::string GetName() const override;
+
+    uint32_t GetDelayWindow(Ptr<const TcpSocketState> tcb, uint32_t delAckMaxCount) const override;
+
+    Time GetDelayTimeout(Ptr<const TcpSocketState> tcb,
+                         uint32_t delAckCount,
+                         uint32_t delAckMaxCount,
+                         Time delAckTimeout) const override;
+
+    Ptr<TcpDelayedAckOps> Fork() override;
+
+  protected:
+    double m_beta{3}; //!< Timeout, in smoothed IATs
+};
+
+/**
+ * \ingroup delayedAckOps
+ *
+ * \brief Adaptive Delay Window (TCP-ADW)
+ *
+ * The number of segments acknowledged by one ACK (the delay window) grows
+ * while the sender congestion window grows, as reported by the
+ * TcpOptionCwnd option, and shrinks back to Lambda segments when it
+ * decreases or when segments arrive out of order.
+ */
+class TcpDelayedAckAdw : public TcpDelayedAckIatOps
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief Constructor
+     */
+    TcpDelayedAckAdw();
+
+    /**
+     * \brief Copy constructor.
+     * \param other object to copy.
+     */
+    TcpDelayedAckAdw(const TcpDelayedAckAdw& other);
+
+    /**
+     * \brief Deconstructor
+     */
+    ~TcpDelayedAckAdw() override;
+
+    std::string GetName() const override;
+
+    void SegmentReceived(Ptr<TcpSocketState> tcb) override;
+
+    void OutOfOrderReceived(Ptr<TcpSocketState> tcb) override;
+
+    void DelAckTimeoutExpired(Ptr<TcpSocketState> tcb) override;
+
+    uint32_t GetDelayWindow(Ptr<const TcpSocketState> tcb, uint32_t delAckMaxCount) const override;
+
+    Time GetDelayTimeout(Ptr<const TcpSocketState> tcb,
+                         uint32_t delAckCount,
+                         uint32_t delAckMaxCount,
+                         Time delAckTimeout) const override;
+
+    Ptr<TcpDelayedAckOps> Fork() override;
+
+    /**
+     * \brief Get the time ratio (theta) of the last IAT sample
+     * \return theta
+     */
+    double GetTimeRatio() const;
+
+    /**
+     * \brief Get the delay window
+     * \return the delay window, in bytes
+     */
+    double GetDwnd() const;
+
+  protected:
+    void IatSampled(Ptr<TcpSocketState> tcb) override;
+
+    /**
+     * \brief Grow or reset the delay window following the sender cwnd
+     * \param tcb internal congestion state
+     * \param theta time ratio of the last IAT sample
+     */
+    void UpdateDelayWindow(Ptr<const TcpSocketState> tcb, double theta);
+
+    double m_lambda{3}; //!< Minimum delay window and timeout, in segments and smoothed IATs
+    double m_dwnd{0};   //!< Delay window, in bytes
+};
+
+/**
+ * \ingroup delayedAckOps
+ *
+ * \brief Cross-layer delayed ACK driven by the end of the received aggregates
+ *
+ * Once the device receiving the segments has signalled the end of an
+ * aggregate (see the RxAggregateEnd trace source of WifiNetDevice), ACKs are
+ * not limited by a segment count anymore: one cumulative ACK is sent when the
+ * last MPDU of each A-MPDU has been delivered, and DelAckTimeout is only a
+ * fallback for lost hints. Until then, e.g. behind a device which does not
+ * aggregate, the classic policy is used.
+ *
+ * This is a reference for the aggregate boundaries inferred by TCP-AAD from
+ * the inter-arrival time.
+ */
+class TcpDelayedAckAggregateEnd : public TcpDelayedAckOps
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    /**
+     * \brief Constructor
+     */
+    TcpDelayedAckAggregateEnd();
+
+    /**
+     * \brief Copy constructor.
+     * \param other object to copy.
+     */
+    TcpDelayedAckAggregateEnd(const TcpDelayedAckAggregateEnd& other);
+
+    /**
+     * \brief Deconstructor
+     */
+    ~TcpDelayedAckAggregateEnd() override;
+
+    std::string GetName() const override;
+
+    bool AggregateEndReceived(Ptr<TcpSocketState> tcb) override;
+
+    uint32_t GetDelayWindow(Ptr<const TcpSocketState> tcb, uint32_t delAckMaxCount) const override;
+
+    Time GetDelayTimeout(Ptr<const TcpSocketState> tcb,
+                         uint32_t delAckCount,
+                         uint32_t delAckMaxCount,
+                         Time delAckTimeout) const override;
+
+    Ptr<TcpDelayedAckOps> Fork() override;
+
+  protected:
+    bool m_aggregating{false}; //!< Whether the end of an aggregate has been signalled
+};
+
+} // namespace ns3
+
+#endif /* TCP_DELAYED_ACK_OPS_H */
@@ -31,6 +31,7 @@
 #include "rtt-estimator.h"
 #include "tcp-congestion-ops.h"
 #include "tcp-cubic.h"
+#include "tcp-delayed-ack-ops.h"
 #include "tcp-header.h"
 #include "tcp-prr-recovery.h"
 #include "tcp-recovery-ops.h"
@@ -93,6 +94,11 @@ TcpL4Protocol::GetTypeId()
                           TypeIdValue(TcpPrrRecovery::GetTypeId()),
                           MakeTypeIdAccessor(&TcpL4Protocol::m_recoveryTypeId),
                           MakeTypeIdChecker())
+            .AddAttribute("DelayedAckType",
+                          "Delayed ACK policy of TCP objects.",
+                          TypeIdValue(TcpDelayedAckClassic::GetTypeId()),
+                          MakeTypeIdAccessor(&TcpL4Protocol::m_delayedAckTypeId),
+                          MakeTypeIdChecker())
             .AddAttribute("SocketList",
                           "A container of sockets associated to this protocol. "
                           "The underlying type is an unordered map, the attribute name "
@@ -202,20 +208,24 @@ TcpL4Protocol::CreateSocket(TypeId congestionTypeId, TypeId recoveryTypeId)
     ObjectFactory rttFactory;
     ObjectFactory congestionAlgorithmFactory;
     ObjectFactory recoveryAlgorithmFactory;
+    ObjectFactory delayedAckFactory;
     rttFactory.SetTypeId(m_rttTypeId);
     congestionAlgorithmFactory.SetTypeId(congestionTypeId);
     recoveryAlgorithmFactory.SetTypeId(recoveryTypeId);
+    delayedAckFactory.SetTypeId(m_delayedAckTypeId);
 
     Ptr<RttEstimator> rtt = rttFactory.Create<RttEstimator>();
     Ptr<TcpSocketBase> socket = CreateObject<TcpSocketBase>();
     Ptr<TcpCongestionOps> algo = congestionAlgorithmFactory.Create<TcpCongestionOps>();
     Ptr<TcpRecoveryOps> recovery = recoveryAlgorithmFactory.Create<TcpRecoveryOps>();
+    Ptr<TcpDelayedAckOps> delAck = delayedAckFactory.Create<TcpDelayedAckOps>();
 
     socket->SetNode(m_node);
     socket->SetTcp(this);
     socket->SetRtt(rtt);
     socket->SetCongestionControlAlgorithm(algo);
     socket->SetRecoveryAlgorithm(recovery);
+    socket->SetDelayedAckAlgorithm(delAck);
 
     m_sockets[m_socketIndex++] = socket;
     return socket;
@@ -384,6 +394,16 @@ TcpL4Protocol::ReceiveIcmp(Ipv6Address icmpSource,
     }
 }
 
+void
+TcpL4Protocol::ReceiveAggregateEnd(Ptr<NetDevice> device)
+{
+    NS_LOG_FUNCTION(this << device);
+    for (const auto& [id, socket] : m_sockets)
+    {
+        socket->ReceivedAggregateEnd(device);
+    }
+}
+
 IpL4Protocol::RxStatus
 TcpL4Protocol::PacketReceived(Ptr<Packet> packet,
                               TcpHeader& incomingTcpHeader,
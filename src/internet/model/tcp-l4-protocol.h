@@ -281,6 +281,7 @@ class TcpL4Protocol : public IpL4Protocol
                      Ipv6Address payloadSource,
                      Ipv6Address payloadDestination,
                      const uint8_t payload[8]) override;
+    void ReceiveAggregateEnd(Ptr<NetDevice> device) override;
 
     void SetDownTarget(IpL4Protocol::DownTargetCallback cb) override;
     void SetDownTarget6(IpL4Protocol::DownTargetCallback6 cb) override;
@@ -341,6 +342,7 @@ class TcpL4Protocol : public IpL4Protocol
     TypeId m_rttTypeId;              //!< The RTT Estimator TypeId
     TypeId m_congestionTypeId;       //!< The socket TypeId
     TypeId m_recoveryTypeId;         //!< The recovery TypeId
+    TypeId m_delayedAckTypeId;       //!< The delayed ACK policy TypeId
     std::unordered_map<uint64_t, Ptr<TcpSocketBase>>
         m_sockets;             //!< Unordered map of socket IDs and corresponding sockets
     uint64_t m_socketIndex{0}; //!< index of the next socket to be created
@@ -0,0 +1,99 @@
+#include "tcp-option-cwnd-permitted.h"
+
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TcpOptionCwndPermitted");
+
+NS_OBJECT_ENSURE_REGISTERED(TcpOptionCwndPermitted);
+
+TcpOptionCwndPermitted::TcpOptionCwndPermitted()
+    : TcpOption(),
+      m_scale(0)
+{
+}
+
+TcpOptionCwndPermitted::~TcpOptionCwndPermitted()
+{
+}
+
+TypeId
+TcpOptionCwndPermitted::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::TcpOptionCwndPermitted")
+                            .SetParent<TcpOption>()
+                            .SetGroupName("Internet")
+                            .AddConstructor<TcpOptionCwndPermitted>();
+    return tid;
+}
+
+TypeId
+TcpOptionCwndPermitted::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+void
+TcpOptionCwndPermitted::Print(std::ostream& os) const
+{
+    os << "[cwnd_perm] scale=" << static_cast<int>(m_scale);
+}
+
+uint32_t
+TcpOptionCwndPermitted::GetSerializedSize() const
+{
+    return 3;
+}
+
+void
+TcpOptionCwndPermitted::Serialize(Buffer::Iterator start) const
+{
+    Buffer::Iterator i = start;
+    i.WriteU8(GetKind()); // Kind
+    i.WriteU8(3);         // Length
+    i.WriteU8(m_scale);   // Scale
+}
+
+uint32_t
+TcpOptionCwndPermitted::Deserialize(Buffer::Iterator start)
+{
+    Buffer::Iterator i = start;
+
+    uint8_t readKind = i.ReadU8();
+    if (readKind != GetKind())
+    {
+        NS_LOG_WARN("Malformed CongestionWindow-Permitted option");
+        return 0;
+    }
+
+    uint8_t size = i.ReadU8();
+    if (size != 3)
+    {
+        NS_LOG_WARN("Malformed CongestionWindow-Permitted option");
+        return 0;
+    }
+    m_scale = i.ReadU8();
+    return GetSerializedSize();
+}
+
+uint8_t
+TcpOptionCwndPermitted::GetKind() const
+{
+    return TcpOption::CWNDPERMITTED;
+}
+
+uint8_t
+TcpOptionCwndPermitted::GetScale() const
+{
+    return m_scale;
+}
+
+void
+TcpOptionCwndPermitted::SetScale(uint8_t scale)
+{
+    m_scale = scale;
+}
+
+} // namespace ns3
@@ -0,0 +1,57 @@
+#ifndef TCP_OPTION_CWND_PERMITTED_H
+#define TCP_OPTION_CWND_PERMITTED_H
+
+#include "tcp-option.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup tcp
+ *
+ * \brief Defines the TCP option of kind 17 (congestion window permitted)
+ *
+ * The option is 3-byte in length and sent in a SYN segment by a TCP host
+ * that sends and processes the congestion window option (TcpOptionCwnd)
+ * during the lifetime of the connection. It carries the scale of the
+ * congestion windows the host sends: their value in segments is shifted
+ * right by this amount.
+ */
+class TcpOptionCwndPermitted : public TcpOption
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+
+    TcpOptionCwndPermitted();
+    ~TcpOptionCwndPermitted() override;
+
+    void Print(std::ostream& os) const override;
+    void Serialize(Buffer::Iterator start) const override;
+    uint32_t Deserialize(Buffer::Iterator start) override;
+
+    uint8_t GetKind() const override;
+    uint32_t GetSerializedSize() const override;
+
+    /**
+     * \brief Get the scale of the congestion windows sent by the host
+     * \return the scale
+     */
+    uint8_t GetScale() const;
+    /**
+     * \brief Set the scale of the congestion windows sent by the host
+     * \param scale the scale
+     */
+    void SetScale(uint8_t scale);
+
+  protected:
+    uint8_t m_scale; //!< Scale of the congestion windows, in bits
+};
+
+} // namespace ns3
+
+#endif /* TCP_OPTION_CWND_PERMITTED_H */
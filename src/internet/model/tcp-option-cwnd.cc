@@ -44,16 +44,16 @@ TcpOptionCwnd::Print(std::ostream& os) const
 uint32_t
 TcpOptionCwnd::GetSerializedSize() const
 {
-    return 6;
+    return 4;
 }
 
 void
 TcpOptionCwnd::Serialize(Buffer::Iterator start) const
 {
     Buffer::Iterator i = start;
-    i.WriteU8(GetKind());        // Kind
-    i.WriteU8(6);                // Length
-    i.WriteHtonU32(m_cwnd);      // cwnd
+    i.WriteU8(GetKind());   // Kind
+    i.WriteU8(4);           // Length
+    i.WriteHtonU16(m_cwnd); // cwnd
 }
 
 uint32_t
@@ -69,12 +69,12 @@ TcpOptionCwnd::Deserialize(Buffer::Iterator start)
     }
 
     uint8_t size = i.ReadU8();
-    if (size != 6)
+    if (size != 4)
     {
         NS_LOG_WARN("Malformed CongestionWindow option");
         return 0;
     }
-    m_cwnd = i.ReadNtohU32();
+    m_cwnd = i.ReadNtohU16();
     return GetSerializedSize();
 }
 
@@ -84,14 +84,14 @@ TcpOptionCwnd::GetKind() const
     return TcpOption::CWND;
 }
 
-uint32_t
+uint16_t
 TcpOptionCwnd::GetCongestionWindow() const
 {
     return m_cwnd;
 }
 
 void
-TcpOptionCwnd::SetCongestionWindow(uint32_t cwnd)
+TcpOptionCwnd::SetCongestionWindow(uint16_t cwnd)
 {
     m_cwnd = cwnd;
 }
@@ -30,7 +30,12 @@ namespace ns3
 /**
  * \ingroup tcp
  *
- * Defines the TCP option of kind 8 (timestamp option) as in \RFC{1323}
+ * Defines the TCP option of kind 16 (congestion window option)
+ *
+ * The option is 4-byte in length and carries the congestion window of the
+ * sender in segments, shifted right by the scale announced in the
+ * TcpOptionCwndPermitted option of its SYN. It is only sent once both
+ * hosts announced it in the SYN exchange.
  */
 
 class TcpOptionCwnd : public TcpOption
@@ -55,17 +60,17 @@ class TcpOptionCwnd : public TcpOption
 
     /**
      * \brief Get the cwnd stored in the Option
-     * \return the cwnd
+     * \return the cwnd, in scaled segments
      */
-    uint32_t GetCongestionWindow() const;
+    uint16_t GetCongestionWindow() const;
     /**
      * \brief Set the cwnd stored in the Option
-     * \param ts the cwnd
+     * \param cwnd the cwnd, in scaled segments
      */
-    void SetCongestionWindow(uint32_t cwnd);
+    void SetCongestionWindow(uint16_t cwnd);
 
   protected:
-    uint32_t m_cwnd; //!< congestion window
+    uint16_t m_cwnd; //!< congestion window, in scaled segments
 };
 
 } // namespace ns3
@@ -19,6 +19,7 @@
 
 #include "tcp-option.h"
 
+#include "tcp-option-cwnd-permitted.h"
 #include "tcp-option-cwnd.h"
 #include "tcp-option-rfc793.h"
 #include "tcp-option-sack-permitted.h"
@@ -27,6 +28,7 @@
 #include "tcp-option-winscale.h"
 
 #include "ns3/log.h"
+#include "ns3/simulator-context.h"
 #include "ns3/type-id.h"
 
 #include <vector>
@@ -68,13 +70,16 @@ TcpOption::CreateOption(uint8_t kind)
         TypeId tid;
     };
 
-    static ObjectFactory objectFactory;
+    static ObjectFactory globalFactory;
+    static thread_local ObjectFactory localFactory;
+    ObjectFactory& objectFactory = SimulatorContext::Select(globalFactory, localFactory);
     static KindToTid toTid[] = {
         {TcpOption::END, TcpOptionEnd::GetTypeId()},
         {TcpOption::MSS, TcpOptionMSS::GetTypeId()},
         {TcpOption::NOP, TcpOptionNOP::GetTypeId()},
         {TcpOption::TS, TcpOptionTS::GetTypeId()},
         {TcpOption::CWND, TcpOptionCwnd::GetTypeId()},
+        {TcpOption::CWNDPERMITTED, TcpOptionCwndPermitted::GetTypeId()},
         {TcpOption::WINSCALE, TcpOptionWinScale::GetTypeId()},
         {TcpOption::SACKPERMITTED, TcpOptionSackPermitted::GetTypeId()},
         {TcpOption::SACK, TcpOptionSack::GetTypeId()},
@@ -106,6 +111,7 @@ TcpOption::IsKindKnown(uint8_t kind)
     case SACK:
     case TS:
     case CWND:
+    case CWNDPERMITTED:
         // Do not add UNKNOWN here
         return true;
     }
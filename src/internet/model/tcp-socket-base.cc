@@ -27,6 +27,7 @@
 #include "tcp-socket-base.h"
 
 #include "ipv4-end-point.h"
+#include "ipv4-interface.h"
 #include "ipv4-route.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
@@ -36,8 +37,10 @@
 #include "ipv6-routing-protocol.h"
 #include "rtt-estimator.h"
 #include "tcp-congestion-ops.h"
+#include "tcp-delayed-ack-ops.h"
 #include "tcp-header.h"
 #include "tcp-l4-protocol.h"
+#include "tcp-option-cwnd-permitted.h"
 #include "tcp-option-cwnd.h"
 #include "tcp-option-sack-permitted.h"
 #include "tcp-option-sack.h"
@@ -127,6 +130,18 @@ TcpSocketBase::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(&TcpSocketBase::m_congestionWindowEnabled),
                           MakeBooleanChecker())
+            .AddAttribute("CongestionWindowOptionScale",
+                          "Right shift applied to the congestion window in segments "
+                          "sent in the Congestion Window option",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&TcpSocketBase::m_cwndOptionScale),
+                          MakeUintegerChecker<uint8_t>(0, 16))
+            .AddAttribute("CongestionWindowOptionDelta",
+                          "Change of the scaled congestion window which triggers a "
+                          "Congestion Window option. Otherwise the option is sent once per RTT",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&TcpSocketBase::m_cwndOptionDelta),
+                          MakeUintegerChecker<uint16_t>(1))
             .AddAttribute(
                 "MinRto",
                 "Minimum retransmit timeout value",
@@ -177,36 +192,11 @@ TcpSocketBase::GetTypeId()
                                           "On",
                                           TcpSocketState::AcceptOnly,
                                           "AcceptOnly"))
-            .AddAttribute("IatThreshold",
-                          "All considered IAT values must be higher than this threshold",
-                          DoubleValue(5e-5),
-                          MakeDoubleAccessor(&TcpSocketBase::m_iatThreshold),
-                          MakeDoubleChecker<double>(0))
-            .AddAttribute("Alpha",
-                          "Alpha parameter from ADW and AAD (used in smoothing function)",
-                          DoubleValue(0.75),
-                          MakeDoubleAccessor(&TcpSocketBase::m_alpha),
-                          MakeDoubleChecker<double>(0, 1))
-            .AddAttribute("AadBeta",
-                          "Lambda parameter from AAD algo ",
-                          DoubleValue(3),
-                          MakeDoubleAccessor(&TcpSocketBase::m_beta),
-                          MakeDoubleChecker<double>(0))
-            .AddAttribute("AdwLambda",
-                          "Lambda parameter from ADW algo ",
-                          DoubleValue(3),
-                          MakeDoubleAccessor(&TcpSocketBase::m_lambda),
-                          MakeDoubleChecker<double>(0))
-            .AddAttribute("AdaptiveDelayWindow",
-                          "Enable adaptive delay window",
-                          BooleanValue(false),
-                          MakeBooleanAccessor(&TcpSocketBase::m_adwEnabled),
-                          MakeBooleanChecker())
-            .AddAttribute("AggregationAwareDelay",
-                          "Enable Aggregation-Aware Delay Acking (TCP-AAD)",
-                          BooleanValue(false),
-                          MakeBooleanAccessor(&TcpSocketBase::m_aadEnabled),
-                          MakeBooleanChecker())
+            .AddAttribute("DelayedAckOps",
+                          "Pointer to TcpDelayedAckOps object",
+                          PointerValue(),
+                          MakePointerAccessor(&TcpSocketBase::GetDelayedAckAlgorithm),
+                          MakePointerChecker<TcpDelayedAckOps>())
             .AddTraceSource("RTO",
                             "Retransmission timeout",
                             MakeTraceSourceAccessor(&TcpSocketBase::m_rto),
@@ -283,6 +273,11 @@ TcpSocketBase::GetTypeId()
                             "Receive tcp packet from IP protocol",
                             MakeTraceSourceAccessor(&TcpSocketBase::m_rxTrace),
                             "ns3::TcpSocketBase::TcpTxRxTracedCallback")
+            .AddTraceSource("DelayedAck",
+                            "An ACK of received data is sent, with the updated delayed ACK "
+                            "statistics",
+                            MakeTraceSourceAccessor(&TcpSocketBase::m_delAckTrace),
+                            "ns3::TcpSocketBase::DelayedAckTracedCallback")
             .AddTraceSource("EcnEchoSeq",
                             "Sequence of last received ECN Echo",
                             MakeTraceSourceAccessor(&TcpSocketBase::m_ecnEchoSeq),
@@ -315,8 +310,13 @@ TcpSocketBase::TcpSocketBase()
 
     m_tcb->m_rxBuffer = CreateObject<TcpRxBuffer>();
 
+    SetDelayedAckAlgorithm(CreateObject<TcpDelayedAckClassic>());
+
     m_tcb->m_pacingRate = m_tcb->m_maxPacingRate;
     m_pacingTimer.SetFunction(&TcpSocketBase::NotifyPacingPerformed, this);
+    m_retxEvent.SetFunction(&TcpSocketBase::ReTxTimerExpired, this);
+    m_delAckEvent.SetFunction(&TcpSocketBase::DelAckTimeout, this);
+    m_persistEvent.SetFunction(&TcpSocketBase::PersistTimeout, this);
 
     m_tcb->m_sendEmptyPacketCallback = MakeCallback(&TcpSocketBase::SendEmptyPacket, this);
 
@@ -367,12 +367,6 @@ TcpSocketBase::TcpSocketBase()
 TcpSocketBase::TcpSocketBase(const TcpSocketBase& sock)
     : TcpSocket(sock),
       // copy object::m_tid and socket::callbacks
-      m_alpha(sock.m_alpha),
-      m_iatThreshold(sock.m_iatThreshold),
-      m_beta(sock.m_beta),
-      m_aadEnabled(sock.m_aadEnabled),
-      m_lambda(sock.m_lambda),
-      m_adwEnabled(sock.m_adwEnabled),
       m_dupAckCount(sock.m_dupAckCount),
       m_delAckCount(0),
       m_delAckMaxCount(sock.m_delAckMaxCount),
@@ -410,6 +404,9 @@ TcpSocketBase::TcpSocketBase(const TcpSocketBase& sock)
       m_sndWindShift(sock.m_sndWindShift),
       m_timestampEnabled(sock.m_timestampEnabled),
       m_congestionWindowEnabled(sock.m_congestionWindowEnabled),
+      m_cwndOptionScale(sock.m_cwndOptionScale),
+      m_rcvCwndOptionScale(sock.m_rcvCwndOptionScale),
+      m_cwndOptionDelta(sock.m_cwndOptionDelta),
       m_timestampToEcho(sock.m_timestampToEcho),
       m_recover(sock.m_recover),
       m_recoverActive(sock.m_recoverActive),
@@ -446,6 +443,9 @@ TcpSocketBase::TcpSocketBase(const TcpSocketBase& sock)
 
     m_tcb->m_pacingRate = m_tcb->m_maxPacingRate;
     m_pacingTimer.SetFunction(&TcpSocketBase::NotifyPacingPerformed, this);
+    m_retxEvent.SetFunction(&TcpSocketBase::ReTxTimerExpired, this);
+    m_delAckEvent.SetFunction(&TcpSocketBase::DelAckTimeout, this);
+    m_persistEvent.SetFunction(&TcpSocketBase::PersistTimeout, this);
 
     if (sock.m_congestionControl)
     {
@@ -458,6 +458,8 @@ TcpSocketBase::TcpSocketBase(const TcpSocketBase& sock)
         m_recoveryOps = sock.m_recoveryOps->Fork();
     }
 
+    SetDelayedAckAlgorithm(sock.m_delAckOps->Fork());
+
     m_rateOps = CreateObject<TcpRateLinux>();
     if (m_tcb->m_sendEmptyPacketCallback.IsNull())
     {
@@ -1240,6 +1242,11 @@ TcpSocketBase::ForwardUp(Ptr<Packet> packet,
         return;
     }
 
+    if (incomingInterface)
+    {
+        m_rxDevice = incomingInterface->GetDevice();
+    }
+
     if (header.GetEcn() == Ipv4Header::ECN_CE && m_ecnCESeq < tcpHeader.GetSequenceNumber())
     {
         NS_LOG_INFO("Received CE flag is valid");
@@ -1420,9 +1427,9 @@ TcpSocketBase::DoForwardUp(Ptr<Packet> packet, const Address& fromAddress, const
         {
             m_timestampEnabled = false;
         }
-        if (tcpHeader.HasOption(TcpOption::CWND) && m_congestionWindowEnabled)
+        if (tcpHeader.HasOption(TcpOption::CWNDPERMITTED) && m_congestionWindowEnabled)
         {
-            ProcessOptionCongestionWindow(tcpHeader.GetOption(TcpOption::CWND));
+            ProcessOptionCwndPermitted(tcpHeader.GetOption(TcpOption::CWNDPERMITTED));
         }
         else
         {
@@ -1459,14 +1466,11 @@ TcpSocketBase::DoForwardUp(Ptr<Packet> packet, const Address& fromAddress, const
                                        tcpHeader.GetSequenceNumber());
             }
         }
+        // The option is only sent when the window changes, or once per RTT
         if (tcpHeader.HasOption(TcpOption::CWND) && m_congestionWindowEnabled)
         {
             ProcessOptionCongestionWindow(tcpHeader.GetOption(TcpOption::CWND));
         }
-        else
-        {
-            m_congestionWindowEnabled = false;
-        }
 
         EstimateRtt(tcpHeader);
         UpdateWindowSize(tcpHeader);
@@ -1477,14 +1481,13 @@ TcpSocketBase::DoForwardUp(Ptr<Packet> packet, const Address& fromAddress, const
         NS_LOG_LOGIC(this << " Enter zerowindow persist state");
         NS_LOG_LOGIC(
             this << " Cancelled ReTxTimeout event which was set to expire at "
-                 << (Simulator::Now() + Simulator::GetDelayLeft(m_retxEvent)).GetSeconds());
+                 << (Simulator::Now() + m_retxEvent.GetDelayLeft()).GetSeconds());
         m_retxEvent.Cancel();
         NS_LOG_LOGIC("Schedule persist timeout at time "
                      << Simulator::Now().GetSeconds() << " to expire at time "
                      << (Simulator::Now() + m_persistTimeout).GetSeconds());
-        m_persistEvent =
-            Simulator::Schedule(m_persistTimeout, &TcpSocketBase::PersistTimeout, this);
-        NS_ASSERT(m_persistTimeout == Simulator::GetDelayLeft(m_persistEvent));
+        m_persistEvent.Schedule(m_persistTimeout);
+        NS_ASSERT(m_persistTimeout == m_persistEvent.GetDelayLeft());
     }
 
     // TCP state machine code in different process functions
@@ -1647,6 +1650,7 @@ TcpSocketBase::IsTcpOptionEnabled(uint8_t kind) const
     case TcpOption::SACKPERMITTED:
     case TcpOption::SACK:
         return m_sackEnabled;
+    case TcpOption::CWNDPERMITTED:
     case TcpOption::CWND:
         return m_congestionWindowEnabled;
     default:
@@ -2774,7 +2778,7 @@ TcpSocketBase::Destroy()
         m_tcp->RemoveSocket(this);
     }
     NS_LOG_LOGIC(this << " Cancelled ReTxTimeout event which was set to expire at "
-                      << (Simulator::Now() + Simulator::GetDelayLeft(m_retxEvent)).GetSeconds());
+                      << (Simulator::Now() + m_retxEvent.GetDelayLeft()).GetSeconds());
     CancelAllTimers();
 }
 
@@ -2790,7 +2794,7 @@ TcpSocketBase::Destroy6()
         m_tcp->RemoveSocket(this);
     }
     NS_LOG_LOGIC(this << " Cancelled ReTxTimeout event which was set to expire at "
-                      << (Simulator::Now() + Simulator::GetDelayLeft(m_retxEvent)).GetSeconds());
+                      << (Simulator::Now() + m_retxEvent.GetDelayLeft()).GetSeconds());
     CancelAllTimers();
 }
 
@@ -2856,6 +2860,11 @@ TcpSocketBase::SendEmptyPacket(uint8_t flags)
             AddOptionSackPermitted(header);
         }
 
+        if (m_congestionWindowEnabled)
+        {
+            AddOptionCwndPermitted(header);
+        }
+
         if (m_synCount == 0)
         { // No more connection retries, give up
             NS_LOG_LOGIC("Connection failed.");
@@ -2887,6 +2896,7 @@ TcpSocketBase::SendEmptyPacket(uint8_t flags)
 
     if (flags & TcpHeader::ACK)
     { // If sending an ACK, cancel the delay ACK as well
+        RecordDelayedAck();
         m_delAckEvent.Cancel();
         m_delAckCount = 0;
         if (m_highTxAck < header.GetAckNumber())
@@ -2924,7 +2934,8 @@ TcpSocketBase::SendEmptyPacket(uint8_t flags)
         NS_LOG_LOGIC("Schedule retransmission timeout at time "
                      << Simulator::Now().GetSeconds() << " to expire at time "
                      << (Simulator::Now() + m_rto.Get()).GetSeconds());
-        m_retxEvent = Simulator::Schedule(m_rto, &TcpSocketBase::SendEmptyPacket, this, flags);
+        m_retxFlags = flags;
+        m_retxEvent.Schedule(m_rto);
     }
 }
 
@@ -3224,6 +3235,8 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
 
     if (withAck)
     {
+        m_ackTrigger = DelayedAckStats::PIGGYBACK;
+        RecordDelayedAck();
         m_delAckEvent.Cancel();
         m_delAckCount = 0;
     }
@@ -3278,7 +3291,8 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
         NS_LOG_LOGIC(this << " SendDataPacket Schedule ReTxTimeout at time "
                           << Simulator::Now().GetSeconds() << " to expire at time "
                           << (Simulator::Now() + m_rto.Get()).GetSeconds());
-        m_retxEvent = Simulator::Schedule(m_rto, &TcpSocketBase::ReTxTimeout, this);
+        m_retxFlags = 0;
+        m_retxEvent.Schedule(m_rto);
     }
 
     m_txTrace(p, header, this);
@@ -3593,37 +3607,14 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
     NS_LOG_DEBUG("Data segment, seq=" << tcpHeader.GetSequenceNumber()
                                       << " pkt size=" << p->GetSize());
 
-    if (m_lastPacketTime == Time::Min())
-    // can't calculate iat for first packet -> init delay window
-    {
-        m_dwnd = m_lambda * GetSegSize();
-    }
-    else
-    {
-        m_iat = (Simulator::Now() - m_lastPacketTime).GetSeconds();
-        // skip too small IATs
-        if (m_iat >= m_iatThreshold)
-        {
-            // reset baseIat only in case of TCP-AAD, every one second
-            if (m_aadEnabled && (Simulator::Now() - m_lastUpdate).GetSeconds() > 1)
-            {
-                m_baseIat = INFINITY;
-                m_lastUpdate = Simulator::Now();
-            }
-            m_baseIat = std::min(m_iat, m_baseIat);
-            UpdateDelayWindow(GetTimeRatio());
-        }
-        else
-        {
-            NS_LOG_DEBUG("Got very small IAT = " << m_iat << ", skipping it");
-        }
-    }
-    m_lastPacketTime = Simulator::Now();
+    m_delAckOps->SegmentReceived(m_tcb);
+    m_delAckStats.segments++;
 
     // Put into Rx buffer
     SequenceNumber32 expectedSeq = m_tcb->m_rxBuffer->NextRxSequence();
     if (!m_tcb->m_rxBuffer->Add(p, tcpHeader))
     { // Insert failed: No data or RX buffer full
+        m_ackTrigger = DelayedAckStats::IMMEDIATE;
         if (m_tcb->m_ecnState == TcpSocketState::ECN_CE_RCVD ||
             m_tcb->m_ecnState == TcpSocketState::ECN_SENDING_ECE)
         {
@@ -3659,11 +3650,10 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
     }
 
     auto issueTimout = [&](){
-        m_delAckEvent =
-            Simulator::Schedule(GetDelayTimeout(), &TcpSocketBase::DelAckTimeout, this);
+        m_delAckEvent.Schedule(GetDelayTimeout());
         NS_LOG_LOGIC(
             this << " scheduled delayed ACK at "
-                << (Simulator::Now() + Simulator::GetDelayLeft(m_delAckEvent)).GetSeconds());
+                << (Simulator::Now() + m_delAckEvent.GetDelayLeft()).GetSeconds());
     };
 
     // Now send a new ACK packet acknowledging all received and delivered data
@@ -3671,9 +3661,8 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
         m_tcb->m_rxBuffer->NextRxSequence() > expectedSeq + p->GetSize())
     { // A gap exists in the buffer, or we filled a gap: Always ACK
         m_congestionControl->CwndEvent(m_tcb, TcpSocketState::CA_EVENT_NON_DELAYED_ACK);
-        // reset delay window
-        NS_LOG_DEBUG("out of order packet, reset dwnd to " << m_lambda);
-        m_dwnd = m_lambda * GetSegSize();
+        m_delAckOps->OutOfOrderReceived(m_tcb);
+        m_ackTrigger = DelayedAckStats::IMMEDIATE;
         if (m_tcb->m_ecnState == TcpSocketState::ECN_CE_RCVD ||
             m_tcb->m_ecnState == TcpSocketState::ECN_SENDING_ECE)
         {
@@ -3688,10 +3677,14 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
     }
     else
     { // In-sequence packet: ACK if delayed ack count allows
+        if (m_delAckCount.Get() == 0)
+        {
+            m_delAckFirstRx = Simulator::Now();
+        }
         if (++m_delAckCount >= DelayWindow())
         {
-            m_delAckEvent.Cancel();
-            m_delAckCount = 0;
+            // the delayed ACK timer and counter are reset by SendEmptyPacket
+            m_ackTrigger = DelayedAckStats::COUNT;
             m_congestionControl->CwndEvent(m_tcb, TcpSocketState::CA_EVENT_NON_DELAYED_ACK);
             if (m_tcb->m_ecnState == TcpSocketState::ECN_CE_RCVD ||
                 m_tcb->m_ecnState == TcpSocketState::ECN_SENDING_ECE)
@@ -3710,10 +3703,9 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
         else if (!m_delAckEvent.IsExpired())
         {
             m_congestionControl->CwndEvent(m_tcb, TcpSocketState::CA_EVENT_DELAYED_ACK);
-            // cancel previous timer and issue a new one
-            if (m_adwEnabled || m_aadEnabled)
+            // move the deadline of the running timer
+            if (m_delAckOps->RestartTimerOnSegment())
             {
-                m_delAckEvent.Cancel();
                 issueTimout();
             }
         }
@@ -3796,7 +3788,7 @@ TcpSocketBase::NewAck(const SequenceNumber32& ack, bool resetRTO)
     { // Set RTO unless the ACK is received in SYN_RCVD state
         NS_LOG_LOGIC(
             this << " Cancelled ReTxTimeout event which was set to expire at "
-                 << (Simulator::Now() + Simulator::GetDelayLeft(m_retxEvent)).GetSeconds());
+                 << (Simulator::Now() + m_retxEvent.GetDelayLeft()).GetSeconds());
         m_retxEvent.Cancel();
         // On receiving a "New" ack we restart retransmission timer .. RFC 6298
         // RFC 6298, clause 2.4
@@ -3806,7 +3798,8 @@ TcpSocketBase::NewAck(const SequenceNumber32& ack, bool resetRTO)
         NS_LOG_LOGIC(this << " Schedule ReTxTimeout at time " << Simulator::Now().GetSeconds()
                           << " to expire at time "
                           << (Simulator::Now() + m_rto.Get()).GetSeconds());
-        m_retxEvent = Simulator::Schedule(m_rto, &TcpSocketBase::ReTxTimeout, this);
+        m_retxFlags = 0;
+        m_retxEvent.Schedule(m_rto);
     }
 
     // Note the highest ACK and tell app to send more
@@ -3825,11 +3818,26 @@ TcpSocketBase::NewAck(const SequenceNumber32& ack, bool resetRTO)
     { // No retransmit timer if no data to retransmit
         NS_LOG_LOGIC(
             this << " Cancelled ReTxTimeout event which was set to expire at "
-                 << (Simulator::Now() + Simulator::GetDelayLeft(m_retxEvent)).GetSeconds());
+                 << (Simulator::Now() + m_retxEvent.GetDelayLeft()).GetSeconds());
         m_retxEvent.Cancel();
     }
 }
 
+void
+TcpSocketBase::ReTxTimerExpired()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_retxFlags != 0)
+    {
+        // SYN / FIN retransmission scheduled by SendEmptyPacket
+        uint8_t flags = m_retxFlags;
+        m_retxFlags = 0;
+        SendEmptyPacket(flags);
+        return;
+    }
+    ReTxTimeout();
+}
+
 // Retransmit timeout
 void
 TcpSocketBase::ReTxTimeout()
@@ -3965,8 +3973,51 @@ void
 TcpSocketBase::DelAckTimeout()
 {    
     NS_LOG_DEBUG("AckTimeout");
-    m_dwnd = std::max(m_lambda * GetSegSize(), m_dwnd - (1 - GetTimeRatio()));
+    m_delAckOps->DelAckTimeoutExpired(m_tcb);
+    m_ackTrigger = DelayedAckStats::TIMEOUT;
+    SendDelayedAck();
+}
+
+void
+TcpSocketBase::ReceivedAggregateEnd(Ptr<NetDevice> device)
+{
+    NS_LOG_FUNCTION(this << device);
+    if (device != m_rxDevice)
+    {
+        return;
+    }
+    if (m_delAckOps->AggregateEndReceived(m_tcb) && m_delAckCount.Get() > 0)
+    {
+        NS_LOG_DEBUG("Aggregate end, acknowledging " << m_delAckCount << " segments");
+        m_ackTrigger = DelayedAckStats::AGGREGATE_END;
+        SendDelayedAck();
+    }
+}
+
+void
+TcpSocketBase::RecordDelayedAck()
+{
+    DelayedAckStats::Trigger trigger = m_ackTrigger;
+    m_ackTrigger = DelayedAckStats::OTHER;
+    if (m_delAckCount.Get() == 0 && trigger != DelayedAckStats::IMMEDIATE)
+    {
+        // nothing received to acknowledge
+        return;
+    }
+    Time delay = m_delAckCount.Get() > 0 ? Simulator::Now() - m_delAckFirstRx : Time();
+    m_delAckStats.RecordAck(trigger, delay);
+    m_delAckTrace(m_delAckStats, trigger, delay);
+}
+
+const DelayedAckStats&
+TcpSocketBase::GetDelayedAckStats() const
+{
+    return m_delAckStats;
+}
 
+void
+TcpSocketBase::SendDelayedAck()
+{
     m_congestionControl->CwndEvent(m_tcb, TcpSocketState::CA_EVENT_DELAYED_ACK);
     if (m_tcb->m_ecnState == TcpSocketState::ECN_CE_RCVD ||
         m_tcb->m_ecnState == TcpSocketState::ECN_SENDING_ECE)
@@ -4062,7 +4113,7 @@ TcpSocketBase::PersistTimeout()
     NS_LOG_LOGIC("Schedule persist timeout at time "
                  << Simulator::Now().GetSeconds() << " to expire at time "
                  << (Simulator::Now() + m_persistTimeout).GetSeconds());
-    m_persistEvent = Simulator::Schedule(m_persistTimeout, &TcpSocketBase::PersistTimeout, this);
+    m_persistEvent.Schedule(m_persistTimeout);
 }
 
 void
@@ -4311,9 +4362,8 @@ TcpSocketBase::AddOptions(TcpHeader& header)
         AddOptionTimestamp(header);
     }
 
-    NS_LOG_INFO(m_node->GetId() << " cwnd_opt " << m_congestionWindowEnabled);
-
-    if (m_congestionWindowEnabled)
+    // The window is only sent once negotiated, i.e. not in a SYN
+    if (m_congestionWindowEnabled && !(header.GetFlags() & TcpHeader::SYN))
     {
         AddOptionCongestionWindow(header);
     }
@@ -4480,10 +4530,38 @@ TcpSocketBase::ProcessOptionCongestionWindow(const Ptr<const TcpOption> option)
 
     Ptr<const TcpOptionCwnd> cwnd = DynamicCast<const TcpOptionCwnd>(option);
 
-    m_cwndDiff = ((int32_t)cwnd->GetCongestionWindow()) - m_tcb->m_rcvCwndValue;
-    m_tcb->m_rcvCwndValue = cwnd->GetCongestionWindow();
+    // The window is sent in segments, assume both ends use the same segment size
+    uint32_t value = (static_cast<uint32_t>(cwnd->GetCongestionWindow()) << m_rcvCwndOptionScale) *
+                     m_tcb->m_segmentSize;
+    m_tcb->m_rcvCwndDiff = static_cast<int32_t>(value - m_tcb->m_rcvCwndValue);
+    m_tcb->m_rcvCwndValue = value;
 
-    NS_LOG_INFO(m_node->GetId() << " Got CongestionWindow=" << cwnd->GetCongestionWindow());
+    NS_LOG_INFO(m_node->GetId() << " Got CongestionWindow=" << value);
+}
+
+void
+TcpSocketBase::ProcessOptionCwndPermitted(const Ptr<const TcpOption> option)
+{
+    NS_LOG_FUNCTION(this << option);
+
+    Ptr<const TcpOptionCwndPermitted> p = DynamicCast<const TcpOptionCwndPermitted>(option);
+
+    NS_ASSERT(m_congestionWindowEnabled == true);
+    m_rcvCwndOptionScale = std::min<uint8_t>(p->GetScale(), 16);
+    NS_LOG_INFO(m_node->GetId() << " Received a CWND_PERMITTED option, scale "
+                                << static_cast<int>(m_rcvCwndOptionScale));
+}
+
+void
+TcpSocketBase::AddOptionCwndPermitted(TcpHeader& header)
+{
+    NS_LOG_FUNCTION(this << header);
+    NS_ASSERT(header.GetFlags() & TcpHeader::SYN);
+
+    Ptr<TcpOptionCwndPermitted> option = CreateObject<TcpOptionCwndPermitted>();
+    option->SetScale(m_cwndOptionScale);
+    header.AppendOption(option);
+    NS_LOG_INFO(m_node->GetId() << " Add option CWND-PERMITTED");
 }
 
 void
@@ -4506,9 +4584,23 @@ TcpSocketBase::AddOptionCongestionWindow(TcpHeader& header)
 {
     NS_LOG_FUNCTION(this << header);
 
-    Ptr<TcpOptionCwnd> option = CreateObject<TcpOptionCwnd>();
+    uint32_t segments = (m_tcb->m_cWnd.Get() / m_tcb->m_segmentSize) >> m_cwndOptionScale;
+    auto cwnd = static_cast<uint16_t>(std::min<uint32_t>(segments, UINT16_MAX));
 
-    option->SetCongestionWindow(m_tcb->m_cWnd.Get());
+    // Send the window if it changed enough since the last option, or once per RTT
+    Time now = Simulator::Now();
+    uint16_t change = cwnd > m_cwndOptionLastValue ? cwnd - m_cwndOptionLastValue
+                                                   : m_cwndOptionLastValue - cwnd;
+    if (!m_cwndOptionLastTime.IsZero() && change < m_cwndOptionDelta &&
+        now - m_cwndOptionLastTime < m_rtt->GetEstimate())
+    {
+        return;
+    }
+    m_cwndOptionLastValue = cwnd;
+    m_cwndOptionLastTime = now;
+
+    Ptr<TcpOptionCwnd> option = CreateObject<TcpOptionCwnd>();
+    option->SetCongestionWindow(cwnd);
 
     header.AppendOption(option);
     NS_LOG_INFO(m_node->GetId() << " Add option CWND, cwnd=" << option->GetCongestionWindow());
@@ -4682,6 +4774,20 @@ TcpSocketBase::SetRecoveryAlgorithm(Ptr<TcpRecoveryOps> recovery)
     m_recoveryOps = recovery;
 }
 
+void
+TcpSocketBase::SetDelayedAckAlgorithm(Ptr<TcpDelayedAckOps> delAck)
+{
+    NS_LOG_FUNCTION(this << delAck);
+    m_delAckOps = delAck;
+    m_delAckOps->SetAdvWndCallback(MakeCallback(&TcpSocketBase::AdvertisedWindowSize, this));
+}
+
+Ptr<TcpDelayedAckOps>
+TcpSocketBase::GetDelayedAckAlgorithm() const
+{
+    return m_delAckOps;
+}
+
 Ptr<TcpSocketBase>
 TcpSocketBase::Fork()
 {
@@ -4815,82 +4921,18 @@ TcpSocketBase::GetHighRxAck() const
     return m_highRxAckMark.Get();
 }
 
-double 
-TcpSocketBase::GetTimeRatio() const
-{
-    double timeRatio;
-    
-    if (m_iat < m_lambda * m_baseIat)
-    {
-        timeRatio = (m_baseIat - m_iat) / m_baseIat;
-    }
-    else
-    {
-        timeRatio = 1 - m_lambda;
-    }
-    NS_LOG_DEBUG("Theta = "  << (timeRatio + (m_lambda - 1)) / m_lambda);
-
-    return (timeRatio + (m_lambda - 1)) / m_lambda;
-}
-
-double 
-TcpSocketBase::UpdateDelayWindow(double theta)
-{
-    NS_LOG_FUNCTION(this << theta);
-    double R = std::min(m_tcb->m_rcvCwndValue, static_cast<uint32_t>(AdvertisedWindowSize(false)));
-    
-    if (m_cwndDiff > 0) 
-    {
-        m_dwnd = std::min(m_dwnd + (1 - theta) * GetSegSize(), R);
-    } 
-    else if (m_cwndDiff < 0) 
-    {
-        m_dwnd = m_lambda * GetSegSize();
-    }
-
-    NS_LOG_INFO("Delay window updated = " << m_dwnd << ", cwndDiff=" << m_cwndDiff << " recvCwnd=" << m_tcb->m_rcvCwndValue);
-
-    return m_dwnd;
-}
-
-Time 
+Time
 TcpSocketBase::GetDelayTimeout() const
 {
     NS_LOG_FUNCTION(this);
-    // use default timeout
-    if (!m_adwEnabled && !m_aadEnabled)
-    {
-        return m_delAckTimeout;
-    }
-
-    // use default algorithm for first `m_delAckMaxCount` packets
-    if (m_delAckCount < m_delAckMaxCount && m_aadEnabled)
-    {
-        return m_delAckTimeout;
-    }
-
-    double smoothedIat = m_alpha * m_baseIat + (1 - m_alpha) * m_iat;
-
-    auto parameter = m_adwEnabled ? m_lambda : m_beta;
-    return std::min(Seconds(parameter * smoothedIat), m_delAckTimeout);
+    return m_delAckOps->GetDelayTimeout(m_tcb, m_delAckCount, m_delAckMaxCount, m_delAckTimeout);
 }
 
-double
+uint32_t
 TcpSocketBase::DelayWindow() const
 {
     NS_LOG_FUNCTION(this);
-    if (m_adwEnabled)
-    {
-        return (m_dwnd / GetSegSize());
-    }
-
-    // amount of packets is limited by timeout
-    if (m_aadEnabled)
-    {
-        return INFINITY;
-    }
-
-    return m_delAckMaxCount;
+    return m_delAckOps->GetDelayWindow(m_tcb, m_delAckMaxCount);
 }
 
 // RttHistory methods
@@ -4910,4 +4952,56 @@ RttHistory::RttHistory(const RttHistory& h)
 {
 }
 
+// DelayedAckStats methods
+
+void
+DelayedAckStats::RecordAck(Trigger trigger, Time delay)
+{
+    acks[trigger]++;
+    totalDelay += delay;
+    maxDelay = Max(maxDelay, delay);
+
+    // bucket i holds the delays in [2^(i-1), 2^i) us
+    uint64_t us = delay.GetMicroSeconds();
+    uint32_t bucket = 0;
+    while (us > 0 && bucket < DELAY_BUCKETS - 1)
+    {
+        us >>= 1;
+        bucket++;
+    }
+    delayHistogram[bucket]++;
+}
+
+uint64_t
+DelayedAckStats::GetNAcks() const
+{
+    uint64_t nAcks = 0;
+    for (auto n : acks)
+    {
+        nAcks += n;
+    }
+    return nAcks;
+}
+
+double
+DelayedAckStats::GetAcksPerSegment() const
+{
+    return segments > 0 ? static_cast<double>(GetNAcks()) / segments : 0;
+}
+
+Time
+DelayedAckStats::GetMeanDelay() const
+{
+    uint64_t nAcks = GetNAcks();
+    return nAcks > 0 ? totalDelay / nAcks : Time();
+}
+
+const char*
+DelayedAckStats::GetTriggerName(Trigger trigger)
+{
+    static const char* names[N_TRIGGERS] =
+        {"count", "timeout", "aggregate_end", "immediate", "piggyback", "other"};
+    return names[trigger];
+}
+
 } // namespace ns3
@@ -27,10 +27,12 @@
 
 #include "ns3/data-rate.h"
 #include "ns3/node.h"
+#include "ns3/restartable-timer.h"
 #include "ns3/sequence-number.h"
 #include "ns3/timer.h"
 #include "ns3/traced-value.h"
 
+#include <array>
 #include <queue>
 #include <stdint.h>
 
@@ -45,6 +47,7 @@ class TcpL4Protocol;
 class TcpHeader;
 class TcpCongestionOps;
 class TcpRecoveryOps;
+class TcpDelayedAckOps;
 class RttEstimator;
 class TcpRxBuffer;
 class TcpTxBuffer;
@@ -80,6 +83,69 @@ class RttHistory
     bool retx;            //!< True if this has been retransmitted
 };
 
+/**
+ * \ingroup tcp
+ *
+ * \brief Delayed ACK statistics of a TCP receiver
+ *
+ * Counts the data segments received and the ACKs which acknowledged them,
+ * split by what triggered the ACK, and the distribution of the time the
+ * oldest unacknowledged segment waited for its ACK (the delay). The delays
+ * are counted in DELAY_BUCKETS buckets: bucket 0 holds the delays shorter
+ * than 1 us, bucket i the delays in [2^(i-1), 2^i) us, and the last bucket
+ * all the longer delays.
+ */
+struct DelayedAckStats
+{
+    /// What triggered an ACK
+    enum Trigger
+    {
+        COUNT = 0,     //!< The delay window was reached
+        TIMEOUT,       //!< The delayed ACK timer expired
+        AGGREGATE_END, //!< The device signalled the end of an aggregate
+        IMMEDIATE,     //!< Out-of-order or duplicate segment, ACKed at once
+        PIGGYBACK,     //!< The ACK was carried by a data segment
+        OTHER,         //!< Any other ACK sent while segments were waiting
+        N_TRIGGERS     //!< Number of triggers
+    };
+
+    static constexpr uint32_t DELAY_BUCKETS = 20; //!< Number of buckets of the delay histogram
+
+    /**
+     * \brief Count an ACK
+     * \param trigger what triggered the ACK
+     * \param delay the time the oldest unacknowledged segment waited
+     */
+    void RecordAck(Trigger trigger, Time delay);
+
+    /**
+     * \return the number of ACKs sent for the received data
+     */
+    uint64_t GetNAcks() const;
+
+    /**
+     * \return the number of ACKs per data segment, 0 if no segment has been received
+     */
+    double GetAcksPerSegment() const;
+
+    /**
+     * \return the mean delay of the ACKs, 0 if no ACK has been sent
+     */
+    Time GetMeanDelay() const;
+
+    /**
+     * \param trigger a trigger
+     * \return the name of the trigger
+     */
+    static const char* GetTriggerName(Trigger trigger);
+
+    uint64_t segments{0};                                 //!< Data segments received
+    std::array<uint64_t, N_TRIGGERS> acks{};              //!< ACKs sent, per trigger
+    std::array<uint64_t, DELAY_BUCKETS> delayHistogram{}; //!< Delays of the ACKs
+    Time totalDelay{};                                    //!< Sum of the delays
+    Time maxDelay{};                                      //!< Longest delay
+};
+
 /**
  * \ingroup socket
  * \ingroup tcp
@@ -271,7 +337,6 @@ class TcpSocketBase : public TcpSocket
      * \param rtt the RTT estimator
      */
     virtual void SetRtt(Ptr<RttEstimator> rtt);
-    double DelayWindow() const;
 
     /**
      * \brief Sets the Minimum RTO.
@@ -460,6 +525,38 @@ class TcpSocketBase : public TcpSocket
      */
     void SetRecoveryAlgorithm(Ptr<TcpRecoveryOps> recovery);
 
+    /**
+     * \brief Install a delayed ACK policy on this socket
+     *
+     * \param delAck Policy to be installed
+     */
+    void SetDelayedAckAlgorithm(Ptr<TcpDelayedAckOps> delAck);
+
+    /**
+     * \brief Get the delayed ACK policy of this socket
+     *
+     * \return the delayed ACK policy
+     */
+    Ptr<TcpDelayedAckOps> GetDelayedAckAlgorithm() const;
+
+    /**
+     * \brief Called by TcpL4Protocol when a device signals the end of a
+     * received aggregate (e.g., the last MPDU of a Wi-Fi A-MPDU)
+     *
+     * If the last segments came from this device and are not acknowledged
+     * yet, the delayed ACK policy may decide to acknowledge them now.
+     *
+     * \param device the device which received the aggregate
+     */
+    void ReceivedAggregateEnd(Ptr<NetDevice> device);
+
+    /**
+     * \brief Get the delayed ACK statistics of the data received by this socket
+     *
+     * \return the statistics
+     */
+    const DelayedAckStats& GetDelayedAckStats() const;
+
     /**
      * \brief Mark ECT(0) codepoint
      *
@@ -620,11 +717,35 @@ class TcpSocketBase : public TcpSocket
                                           const TcpHeader& header,
                                           const Ptr<const TcpSocketBase> socket);
 
+    /**
+     * TracedCallback signature for the ACKs of received data
+     *
+     * \param [in] stats the delayed ACK statistics, including this ACK
+     * \param [in] trigger what triggered the ACK
+     * \param [in] delay the time the oldest unacknowledged segment waited
+     */
+    typedef void (*DelayedAckTracedCallback)(const DelayedAckStats& stats,
+                                             DelayedAckStats::Trigger trigger,
+                                             Time delay);
+
     uint32_t GetSegSize() const override;
 
-    double GetTimeRatio() const;
-    double UpdateDelayWindow(double theta);
+    /**
+     * \brief Get the number of in-order segments that triggers an ACK
+     *
+     * \see TcpDelayedAckOps::GetDelayWindow
+     * \return the delay window, in segments
+     */
+    uint32_t DelayWindow() const;
+
+    /**
+     * \brief Get the time the next delayed ACK may be delayed
+     *
+     * \see TcpDelayedAckOps::GetDelayTimeout
+     * \return the delayed ACK timeout
+     */
     Time GetDelayTimeout() const;
+
   protected:
     // Implementing ns3::TcpSocket -- Attribute get/set
     // inherited, no need to doc
@@ -1099,6 +1220,14 @@ class TcpSocketBase : public TcpSocket
      */
     void EnterRecovery(uint32_t currentDelivered);
 
+    /**
+     * \brief The retransmission timer expired
+     *
+     * Retransmits the SYN or FIN segment if m_retxFlags is set, calls
+     * ReTxTimeout otherwise.
+     */
+    void ReTxTimerExpired();
+
     /**
      * \brief An RTO event happened
      */
@@ -1109,6 +1238,19 @@ class TcpSocketBase : public TcpSocket
      */
     virtual void DelAckTimeout();
 
+    /**
+     * \brief Send the ACK of the segments received since the last one
+     */
+    void SendDelayedAck();
+
+    /**
+     * \brief Count an ACK about to be sent in the delayed ACK statistics
+     *
+     * Called by SendEmptyPacket and SendDataPacket when they send an ACK. The
+     * trigger is m_ackTrigger, reset to OTHER afterwards.
+     */
+    void RecordDelayedAck();
+
     /**
      * \brief Timeout at LAST_ACK, close the connection
      */
@@ -1233,25 +1375,42 @@ class TcpSocketBase : public TcpSocket
      */
     void AddOptionTimestamp(TcpHeader& header);
 
-    /** \brief Process the timestamp option from other side
+    /** \brief Process the congestion window option from other side
      *
-     * Get the timestamp and the echo, then save timestamp (which will
-     * be the echo value in our out-packets) and save the echoed timestamp,
-     * to utilize later to calculate RTT.
+     * Save the congestion window of the peer, in bytes, and its change since
+     * the last option in the socket state. The option is not sent in every
+     * segment, so these values are kept until the next one.
      *
-     * \see EstimateRtt
      * \param option Option from the segment
-     * \param seq Sequence number of the segment
      */
     void ProcessOptionCongestionWindow(const Ptr<const TcpOption> option);
     /**
      * \brief Add the CongestionWindow option to the header
      *
+     * The option is only added if the scaled window changed by at least
+     * CongestionWindowOptionDelta since the last option, or if the last one
+     * was sent more than an RTT ago.
      *
      * \param header TcpHeader to which add the option to
      */
     void AddOptionCongestionWindow(TcpHeader& header);
 
+    /**
+     * \brief Read the CongestionWindow-Permitted option
+     *
+     * Save the scale of the congestion windows sent by the peer.
+     *
+     * \param option CongestionWindow-Permitted option from the header
+     */
+    void ProcessOptionCwndPermitted(const Ptr<const TcpOption> option);
+
+    /**
+     * \brief Add the CongestionWindow-Permitted option to the header
+     *
+     * \param header TcpHeader where the method should add the option
+     */
+    void AddOptionCwndPermitted(TcpHeader& header);
+
     /**
      * \brief Performs a safe subtraction between a and b (a-b)
      *
@@ -1300,34 +1459,22 @@ class TcpSocketBase : public TcpSocket
     SequenceNumber32 GetHighRxAck() const;
 
   public:
-    // Delay schemas related
-    double m_alpha{0.75};
-    double m_iatThreshold{5e-5};
-    double m_baseIat{INFINITY};
-    double m_iat{INFINITY};
-    Time m_lastPacketTime{Time::Min()};
-    Time m_lastUpdate{Time::FromInteger(0, Time::S)};
-
-    // TCP-AAD related
-    double m_beta{3};
-    bool m_aadEnabled{false};
-
-    // TCP-ADW related
-    double m_lambda{3};
-    double m_dwnd{3};
-    bool m_adwEnabled{false};
-
     // Counters and events
-    EventId m_retxEvent{};     //!< Retransmission event
-    EventId m_lastAckEvent{};  //!< Last ACK timeout event
-    EventId m_delAckEvent{};   //!< Delayed ACK timeout event
-    EventId m_persistEvent{};  //!< Persist event: Send 1 byte to probe for a non-zero Rx window
-    EventId m_timewaitEvent{}; //!< TIME_WAIT expiration event: Move this socket to CLOSED state
+    RestartableTimer m_retxEvent;    //!< Retransmission timer
+    uint8_t m_retxFlags{0};          //!< SYN / FIN flags to retransmit, 0 for a ReTxTimeout
+    EventId m_lastAckEvent{};        //!< Last ACK timeout event
+    RestartableTimer m_delAckEvent;  //!< Delayed ACK timer
+    RestartableTimer m_persistEvent; //!< Persist timer: Send 1 byte to probe for a non-zero Rx wnd
+    EventId m_timewaitEvent{};       //!< TIME_WAIT expiration event: Move socket to CLOSED state
 
     // ACK management
     uint32_t m_dupAckCount{0};    //!< Dupack counter
     TracedValue<uint32_t> m_delAckCount{0};    //!< Delayed ACK counter
     uint32_t m_delAckMaxCount{0}; //!< Number of packet to fire an ACK before delay timeout
+    Ptr<NetDevice> m_rxDevice;    //!< Device which received the last segment
+    Time m_delAckFirstRx;         //!< Arrival time of the oldest segment not ACKed yet
+    DelayedAckStats::Trigger m_ackTrigger{DelayedAckStats::OTHER}; //!< Trigger of the next ACK
+    DelayedAckStats m_delAckStats;                                 //!< Delayed ACK statistics
 
     // Nagle algorithm
     bool m_noDelay{true}; //!< Set to true to disable Nagle's algorithm
@@ -1392,7 +1539,11 @@ class TcpSocketBase : public TcpSocket
     uint8_t m_sndWindShift{0};             //!< Window shift to apply to incoming segments
     bool m_timestampEnabled{true};         //!< Timestamp option enabled
     bool m_congestionWindowEnabled{false}; //!< Congestion window option enabled
-    int32_t m_cwndDiff{0}; 
+    uint8_t m_cwndOptionScale{0};          //!< Scale of the sent congestion windows
+    uint8_t m_rcvCwndOptionScale{0};       //!< Scale of the received congestion windows
+    uint16_t m_cwndOptionDelta{1};         //!< Window change which triggers an option
+    uint16_t m_cwndOptionLastValue{0};     //!< Scaled window sent in the last option
+    Time m_cwndOptionLastTime{};           //!< Time of the last congestion window option
     uint32_t m_timestampToEcho{0};         //!< Timestamp to echo
 
     EventId m_sendPendingDataEvent{}; //!< micro-delay event to send pending data
@@ -1410,6 +1561,7 @@ class TcpSocketBase : public TcpSocket
     Ptr<TcpSocketState> m_tcb;                 //!< Congestion control information
     Ptr<TcpCongestionOps> m_congestionControl; //!< Congestion control
     Ptr<TcpRecoveryOps> m_recoveryOps;         //!< Recovery Algorithm
+    Ptr<TcpDelayedAckOps> m_delAckOps;         //!< Delayed ACK policy
     Ptr<TcpRateOps> m_rateOps;                 //!< Rate operations
 
     // Guesses over the other connection end
@@ -1426,6 +1578,9 @@ class TcpSocketBase : public TcpSocket
                    Ptr<const TcpSocketBase>>
         m_rxTrace; //!< Trace of received packets
 
+    TracedCallback<const DelayedAckStats&, DelayedAckStats::Trigger, Time>
+        m_delAckTrace; //!< Trace of the ACKs of received data
+
     // Pacing related variable
     Timer m_pacingTimer{Timer::CANCEL_ON_DESTROY}; //!< Pacing Event
 
@@ -197,6 +197,7 @@ class TcpSocketState : public Object
     uint32_t m_rcvTimestampEchoReply{0}; //!< Sender Timestamp echoed by the receiver
 
     uint32_t m_rcvCwndValue{0};     //!< Receiver Timestamp value
+    int32_t m_rcvCwndDiff{0};       //!< Change of the peer cwnd in the last CWND option
 
     // Pacing related variables
     bool m_pacing{false};                  //!< Pacing status
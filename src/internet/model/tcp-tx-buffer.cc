@@ -61,7 +61,10 @@ TcpTxBuffer::TcpTxBuffer(uint32_t n)
     : m_maxBuffer(32768),
       m_size(0),
       m_sentSize(0),
-      m_firstByteSeq(n)
+      m_firstByteSeq(n),
+      m_lostHint(n),
+      m_nextSegHint(n),
+      m_highestLost(n)
 {
     m_rWndCallback = MakeNullCallback<uint32_t>();
 }
@@ -169,12 +172,16 @@ TcpTxBuffer::SetHeadSequence(const SequenceNumber32& seq)
 
     if (!m_sentList.empty())
     {
+        m_sentIndex.erase(m_sentList.front()->m_startSeq);
         m_sentList.front()->m_startSeq = seq;
+        IndexSentItem(m_sentList.begin());
     }
 
     // if you change the head with data already sent, something bad will happen
     NS_ASSERT(m_sentList.empty());
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    ResetHints();
+    m_highestLost = seq;
 }
 
 bool
@@ -295,7 +302,7 @@ TcpTxBuffer::GetNewSegment(uint32_t numBytes)
     NS_ASSERT(it != m_appList.end());
 
     m_appList.erase(it);
-    m_sentList.insert(m_sentList.end(), item);
+    IndexSentItem(m_sentList.insert(m_sentList.end(), item));
     m_sentSize += item->m_packet->GetSize();
 
     return item;
@@ -309,37 +316,34 @@ TcpTxBuffer::GetTransmittedSegment(uint32_t numBytes, const SequenceNumber32& se
     NS_ASSERT(numBytes <= m_sentSize);
     NS_ASSERT(!m_sentList.empty());
 
-    auto it = m_sentList.begin();
     bool listEdited = false;
     uint32_t s = numBytes;
 
     // Avoid to merge different packet for this retransmission if flags are
     // different.
-    for (; it != m_sentList.end(); ++it)
+    auto index = m_sentIndex.find(seq);
+    if (index != m_sentIndex.end())
     {
-        if ((*it)->m_startSeq == seq)
+        auto it = index->second;
+        auto next = it;
+        next++;
+        if (next != m_sentList.end())
         {
-            auto next = it;
-            next++;
-            if (next != m_sentList.end())
+            // Next is not sacked and have the same value for m_lost ... there is the
+            // possibility to merge
+            if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
             {
-                // Next is not sacked and have the same value for m_lost ... there is the
-                // possibility to merge
-                if ((!(*next)->m_sacked) && ((*it)->m_lost == (*next)->m_lost))
-                {
-                    s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
-                }
-                else
-                {
-                    // Next is sacked... better to retransmit only the first segment
-                    s = std::min(s, (*it)->m_packet->GetSize());
-                }
+                s = std::min(s, (*it)->m_packet->GetSize() + (*next)->m_packet->GetSize());
             }
             else
             {
+                // Next is sacked... better to retransmit only the first segment
                 s = std::min(s, (*it)->m_packet->GetSize());
             }
-            break;
+        }
+        else
+        {
+            s = std::min(s, (*it)->m_packet->GetSize());
         }
     }
 
@@ -376,6 +380,31 @@ TcpTxBuffer::FindHighestSacked() const
     return ret;
 }
 
+TcpTxBuffer::SentIndex::const_iterator
+TcpTxBuffer::FindSentItem(const SequenceNumber32& seq) const
+{
+    NS_ASSERT(!m_sentIndex.empty());
+    auto it = m_sentIndex.upper_bound(seq);
+    if (it != m_sentIndex.begin())
+    {
+        --it;
+    }
+    return it;
+}
+
+void
+TcpTxBuffer::IndexSentItem(PacketList::iterator it) const
+{
+    m_sentIndex[(*it)->m_startSeq] = it;
+}
+
+void
+TcpTxBuffer::ResetHints() const
+{
+    m_lostHint = m_firstByteSeq;
+    m_nextSegHint = m_firstByteSeq;
+}
+
 void
 TcpTxBuffer::SplitItems(TcpTxItem* t1, TcpTxItem* t2, uint32_t size) const
 {
@@ -437,12 +466,21 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
     TcpTxItem* outItem = nullptr;
     auto it = list.begin();
     SequenceNumber32 beginOfCurrentPacket = listStartFrom;
+    bool isSentList = (&list == &m_sentList);
+
+    if (isSentList && !m_sentIndex.empty() && seq >= listStartFrom)
+    {
+        // Skip the packets before the one which contains seq
+        auto index = FindSentItem(seq);
+        it = index->second;
+        beginOfCurrentPacket = index->first;
+    }
 
     while (it != list.end())
     {
         currentItem = *it;
         currentPacket = currentItem->m_packet;
-        NS_ASSERT_MSG(list != m_sentList || currentItem->m_startSeq >= m_firstByteSeq,
+        NS_ASSERT_MSG(!isSentList || currentItem->m_startSeq >= m_firstByteSeq,
                       "start: " << m_firstByteSeq
                                 << " currentItem start: " << currentItem->m_startSeq);
 
@@ -471,7 +509,12 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                 SplitItems(firstPart, currentItem, seq - beginOfCurrentPacket);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                auto firstPartIt = list.insert(it, firstPart);
+                if (isSentList)
+                {
+                    IndexSentItem(firstPartIt);
+                    IndexSentItem(it);
+                }
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -515,9 +558,14 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                     // current > outPacket in the list. Merge current with the
                     // previous, and recurse.
                     NS_ASSERT(it != list.begin());
+                    auto currentIt = it;
                     TcpTxItem* previous = *(--it);
 
-                    list.erase(it);
+                    if (isSentList)
+                    {
+                        m_sentIndex.erase(currentItem->m_startSeq);
+                    }
+                    list.erase(currentIt);
 
                     MergeItems(previous, currentItem);
                     delete currentItem;
@@ -537,7 +585,12 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                 SplitItems(firstPart, currentItem, numBytes);
 
                 // insert firstPart before currentItem
-                list.insert(it, firstPart);
+                auto firstPartIt = list.insert(it, firstPart);
+                if (isSentList)
+                {
+                    IndexSentItem(firstPartIt);
+                    IndexSentItem(it);
+                }
                 if (listEdited)
                 {
                     *listEdited = true;
@@ -566,6 +619,10 @@ TcpTxBuffer::GetPacketFromList(PacketList& list,
                                      // in the previous if
 
             MergeItems(currentItem, next);
+            if (isSentList)
+            {
+                m_sentIndex.erase(next->m_startSeq);
+            }
             list.erase(it);
 
             delete next;
@@ -612,6 +669,10 @@ TcpTxBuffer::MergeItems(TcpTxItem* t1, TcpTxItem* t2) const
             self->m_retrans -= t2->m_packet->GetSize();
             t2->m_retrans = false;
         }
+        if (m_nextSegHint > t1->m_startSeq)
+        {
+            m_nextSegHint = t1->m_startSeq;
+        }
     }
 
     if (t1->m_lastSent < t2->m_lastSent)
@@ -650,16 +711,15 @@ bool
 TcpTxBuffer::IsRetransmittedDataAcked(const SequenceNumber32& ack) const
 {
     NS_LOG_FUNCTION(this);
-    for (const auto& it : m_sentList)
+    // The only item which can end at ack is the one before the item starting at ack
+    auto it = m_sentIndex.lower_bound(ack);
+    if (it == m_sentIndex.begin())
     {
-        TcpTxItem* item = it;
-        Ptr<Packet> p = item->m_packet;
-        if (item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans)
-        {
-            return true;
-        }
+        return false;
     }
-    return false;
+    TcpTxItem* item = *(std::prev(it)->second);
+    Ptr<Packet> p = item->m_packet;
+    return item->m_startSeq + p->GetSize() == ack && !item->m_sacked && item->m_retrans;
 }
 
 void
@@ -707,6 +767,7 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
 
             RemoveFromCounts(item, pktSize);
 
+            m_sentIndex.erase(item->m_startSeq);
             i = m_sentList.erase(i);
             NS_LOG_INFO("Removed " << *item << " lost: " << m_lostOut << " retrans: " << m_retrans
                                    << " sacked: " << m_sackedOut << ". Remaining data " << m_size);
@@ -725,7 +786,9 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
             NS_LOG_INFO(*item);
             // PacketTags are preserved when fragmenting
             item->m_packet = item->m_packet->CreateFragment(offset, pktSize);
+            m_sentIndex.erase(item->m_startSeq);
             item->m_startSeq += offset;
+            IndexSentItem(i);
             m_size -= offset;
             m_sentSize -= offset;
             m_firstByteSeq += offset;
@@ -755,6 +818,7 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
             // when adding Reno dupacks in the count.
             head->m_sacked = false;
             m_sackedOut -= head->m_packet->GetSize();
+            ResetHints();
             NS_LOG_INFO("Moving the SACK flag from the HEAD to another segment");
             AddRenoSack();
             MarkHeadAsLost();
@@ -769,6 +833,18 @@ TcpTxBuffer::DiscardUpTo(const SequenceNumber32& seq, const Callback<void, TcpTx
     {
         m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
     }
+    if (m_lostHint < m_firstByteSeq)
+    {
+        m_lostHint = m_firstByteSeq;
+    }
+    if (m_nextSegHint < m_firstByteSeq)
+    {
+        m_nextSegHint = m_firstByteSeq;
+    }
+    if (m_highestLost < m_firstByteSeq)
+    {
+        m_highestLost = m_firstByteSeq;
+    }
 
     NS_LOG_DEBUG("Discarded up to " << seq << " lost: " << m_lostOut << " retrans: " << m_retrans
                                     << " sacked: " << m_sackedOut);
@@ -797,6 +873,18 @@ TcpTxBuffer::Update(const TcpOptionSack::SackList& list, const Callback<void, Tc
             return bytesSacked;
         }
 
+        // The items which start before the block can not be sacked by it
+        auto index = m_sentIndex.lower_bound((*option_it).first);
+        if (index == m_sentIndex.end())
+        {
+            item_it = m_sentList.end();
+        }
+        else if (index->first > m_firstByteSeq)
+        {
+            item_it = index->second;
+            beginOfCurrentPacket = index->first;
+        }
+
         while (item_it != m_sentList.end())
         {
             uint32_t pktSize = (*item_it)->m_packet->GetSize();
@@ -889,6 +977,8 @@ TcpTxBuffer::UpdateLostCount()
                                                  << *(*m_highestSack.first));
     }
 
+    SequenceNumber32 lostHint = m_lostHint;
+    bool lostHintSet = false;
     for (auto it = m_highestSack.first; it != m_sentList.begin(); --it)
     {
         TcpTxItem* item = *it;
@@ -899,6 +989,20 @@ TcpTxBuffer::UpdateLostCount()
 
         if (sacked >= m_dupAckThresh)
         {
+            if (item->m_startSeq < lostHint)
+            {
+                // the items before were already marked by a previous update
+                break;
+            }
+            if (!lostHintSet)
+            {
+                lostHintSet = true;
+                m_lostHint = item->m_startSeq + item->m_packet->GetSize();
+                if (m_highestLost < m_lostHint)
+                {
+                    m_highestLost = m_lostHint;
+                }
+            }
             if (!item->m_sacked && !item->m_lost)
             {
                 item->m_lost = true;
@@ -915,6 +1019,10 @@ TcpTxBuffer::UpdateLostCount()
         {
             item->m_lost = true;
             m_lostOut += item->m_packet->GetSize();
+            if (m_highestLost < item->m_startSeq + item->m_packet->GetSize())
+            {
+                m_highestLost = item->m_startSeq + item->m_packet->GetSize();
+            }
         }
     }
     NS_LOG_INFO("Status after the update: " << *this);
@@ -933,9 +1041,16 @@ TcpTxBuffer::IsLost(const SequenceNumber32& seq) const
         return false;
     }
 
-    // In theory, using a map and hints when inserting elements can improve
-    // performance
-    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    // Start from the first item which does not begin before seq
+    auto index = m_sentIndex.lower_bound(seq);
+    auto it = m_sentList.end();
+    if (index != m_sentIndex.end())
+    {
+        it = index->second;
+        beginOfCurrentPacket = index->first;
+    }
+
+    for (; it != m_sentList.end(); ++it)
     {
         // Search for the right iterator before calling IsLost()
         if (beginOfCurrentPacket >= seq)
@@ -981,11 +1096,37 @@ TcpTxBuffer::NextSeg(SequenceNumber32* seq, SequenceNumber32* seqHigh, bool isRe
     SequenceNumber32 seqPerRule3;
     bool isSeqPerRule3Valid = false;
     SequenceNumber32 beginOfCurrentPkt = m_firstByteSeq;
+    auto it = m_sentList.begin();
 
-    for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
+    // The items before the hint are retransmitted or sacked, and they are skipped
+    if (!m_sentIndex.empty() && m_nextSegHint > m_firstByteSeq)
+    {
+        auto index = FindSentItem(m_nextSegHint);
+        it = index->second;
+        beginOfCurrentPkt = index->first;
+    }
+    bool moveHint = true;
+
+    for (; it != m_sentList.end(); ++it)
     {
         item = *it;
 
+        // Rule 1 does not apply to the items after the lost ones, and rule 3
+        // only to the first item which is neither retransmitted nor sacked
+        if (beginOfCurrentPkt >= m_highestLost && (!isRecovery || isSeqPerRule3Valid))
+        {
+            break;
+        }
+
+        if (moveHint && (item->m_retrans || item->m_sacked))
+        {
+            m_nextSegHint = beginOfCurrentPkt + item->m_packet->GetSize();
+        }
+        else
+        {
+            moveHint = false;
+        }
+
         // Condition 1.a , 1.b , and 1.c
         if (!item->m_retrans && !item->m_sacked)
         {
@@ -1221,6 +1362,7 @@ TcpTxBuffer::ResetRenoSack()
     }
 
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    ResetHints();
 }
 
 void
@@ -1245,11 +1387,14 @@ TcpTxBuffer::ResetSentList()
         m_sentList.pop_back();
     }
 
+    m_sentIndex.clear();
+    m_highestLost = m_firstByteSeq;
     m_sentSize = 0;
     m_lostOut = 0;
     m_retrans = 0;
     m_sackedOut = 0;
     m_highestSack = std::make_pair(m_sentList.end(), SequenceNumber32(0));
+    ResetHints();
 }
 
 void
@@ -1260,6 +1405,15 @@ TcpTxBuffer::ResetLastSegmentSent()
     {
         TcpTxItem* item = m_sentList.back();
 
+        m_sentIndex.erase(item->m_startSeq);
+        if (m_lostHint > item->m_startSeq)
+        {
+            m_lostHint = item->m_startSeq;
+        }
+        if (m_nextSegHint > item->m_startSeq)
+        {
+            m_nextSegHint = item->m_startSeq;
+        }
         m_sentList.pop_back();
         m_sentSize -= item->m_packet->GetSize();
         if (item->m_retrans)
@@ -1313,6 +1467,8 @@ TcpTxBuffer::SetSentListLost(bool resetSack)
         (*it)->m_retrans = false;
     }
 
+    ResetHints();
+    m_highestLost = m_firstByteSeq + m_sentSize;
     NS_LOG_INFO("Set sent list lost, status: " << *this);
     NS_ASSERT_MSG(m_sentSize >= m_sackedOut + m_lostOut, *this);
     ConsistencyCheck();
@@ -1345,6 +1501,7 @@ TcpTxBuffer::DeleteRetransmittedFlagFromHead()
     {
         m_sentList.front()->m_retrans = false;
         m_retrans -= m_sentList.front()->m_packet->GetSize();
+        ResetHints();
     }
     ConsistencyCheck();
 }
@@ -1374,6 +1531,11 @@ TcpTxBuffer::MarkHeadAsLost()
             m_sentList.front()->m_lost = true;
             m_lostOut += m_sentList.front()->m_packet->GetSize();
         }
+        if (m_highestLost < m_firstByteSeq + m_sentList.front()->m_packet->GetSize())
+        {
+            m_highestLost = m_firstByteSeq + m_sentList.front()->m_packet->GetSize();
+        }
+        ResetHints();
     }
     ConsistencyCheck();
 }
@@ -1434,8 +1596,22 @@ TcpTxBuffer::ConsistencyCheck() const
     uint32_t lost = 0;
     uint32_t retrans = 0;
 
+    NS_ASSERT_MSG(m_sentIndex.size() == m_sentList.size(),
+                  "Indexed items: " << m_sentIndex.size() << " sent items: " << m_sentList.size());
+
     for (auto it = m_sentList.begin(); it != m_sentList.end(); ++it)
     {
+        auto index = m_sentIndex.find((*it)->m_startSeq);
+        NS_ASSERT_MSG(index != m_sentIndex.end() && index->second == it,
+                      "Item " << *(*it) << " is not indexed");
+        NS_ASSERT_MSG((*it)->m_startSeq >= m_lostHint || (*it)->m_lost || (*it)->m_sacked,
+                      "Item " << *(*it) << " before the lost hint " << m_lostHint);
+        NS_ASSERT_MSG((*it)->m_startSeq >= m_nextSegHint || (*it)->m_retrans ||
+                          (*it)->m_sacked,
+                      "Item " << *(*it) << " before the NextSeg hint " << m_nextSegHint);
+        NS_ASSERT_MSG(!(*it)->m_lost ||
+                          (*it)->m_startSeq + (*it)->m_packet->GetSize() <= m_highestLost,
+                      "Lost item " << *(*it) << " after the highest lost " << m_highestLost);
         if ((*it)->m_sacked)
         {
             sacked += (*it)->m_packet->GetSize();
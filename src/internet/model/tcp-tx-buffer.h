@@ -28,6 +28,9 @@
 #include "ns3/sequence-number.h"
 #include "ns3/traced-value.h"
 
+#include <list>
+#include <map>
+
 namespace ns3
 {
 class Packet;
@@ -74,6 +77,14 @@ class Packet;
  * documentation) and maintaining the scoreboard is a matter of travelling the
  * list and set the SACK flag on the corresponding segment sent.
  *
+ * The items of the SentList are also indexed by the sequence number of their
+ * first byte, so that a SACK block, a sequence or a retransmission is found
+ * without a walk from the head of the list. Two hints, the sequences below
+ * which all the items are lost or sacked, and retransmitted or sacked, bound
+ * the walks of UpdateLostCount and NextSeg to the part of the list which can
+ * change, and NextSeg stops after the last lost item. With a window of thousands of segments, the processing of an ACK
+ * does not walk anymore the whole list for each SACK block.
+ *
  * Item properties
  * ---------------
  *
@@ -412,6 +423,8 @@ class TcpTxBuffer : public Object
     friend std::ostream& operator<<(std::ostream& os, const TcpTxBuffer& tcpTxBuf);
 
     typedef std::list<TcpTxItem*> PacketList; //!< container for data stored in the buffer
+    /// Index of the items of the SentList by the sequence number of their first byte
+    typedef std::map<SequenceNumber32, PacketList::iterator> SentIndex;
 
     /**
      * \brief Update the lost count
@@ -596,6 +609,27 @@ class TcpTxBuffer : public Object
      */
     void ConsistencyCheck() const;
 
+    /**
+     * \brief Find the item of the SentList which contains a sequence
+     * \param seq a sequence of the SentList
+     * \return the index entry of the item
+     */
+    SentIndex::const_iterator FindSentItem(const SequenceNumber32& seq) const;
+
+    /**
+     * \brief Set the index entry of an item of the SentList, after a change of its
+     * first sequence or of its position in the list
+     * \param it the item in the SentList
+     */
+    void IndexSentItem(PacketList::iterator it) const;
+
+    /**
+     * \brief Reset the hints of UpdateLostCount and NextSeg to the head of the
+     * SentList, after the sacked, lost or retransmitted flags are removed
+     * from some items
+     */
+    void ResetHints() const;
+
     /**
      * \brief Find the highest SACK byte
      * \return a pair with the highest byte and an iterator inside m_sentList
@@ -604,6 +638,7 @@ class TcpTxBuffer : public Object
 
     PacketList m_appList;              //!< Buffer for application data
     PacketList m_sentList;             //!< Buffer for sent (but not acked) data
+    mutable SentIndex m_sentIndex;     //!< Items of the SentList by first sequence
     uint32_t m_maxBuffer;              //!< Max number of data bytes in buffer (SND.WND)
     uint32_t m_size;                   //!< Size of all data in this buffer
     uint32_t m_sentSize;               //!< Size of sent (and not discarded) segments
@@ -617,6 +652,13 @@ class TcpTxBuffer : public Object
     uint32_t m_sackedOut{0}; //!< Number of sacked bytes
     uint32_t m_retrans{0};   //!< Number of retransmitted bytes
 
+    /// The items of the SentList which start before this sequence are lost or sacked
+    mutable SequenceNumber32 m_lostHint;
+    /// The items of the SentList which start before this sequence are retransmitted or sacked
+    mutable SequenceNumber32 m_nextSegHint;
+    /// The lost items of the SentList end before this sequence, or at it
+    SequenceNumber32 m_highestLost;
+
     uint32_t m_dupAckThresh{0}; //!< Duplicate Ack threshold from TcpSocketBase
     uint32_t m_segmentSize{0};  //!< Segment size from TcpSocketBase
     bool m_renoSack{false};     //!< Indicates if AddRenoSack was called
@@ -0,0 +1,207 @@
+#include "tcp-general-test.h"
+
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/tcp-header.h"
+#include "ns3/tcp-option-cwnd-permitted.h"
+#include "ns3/tcp-option-cwnd.h"
+#include "ns3/uinteger.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TcpCwndOptionTestSuite");
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Serialization of the congestion window options.
+ */
+class TcpOptionCwndSerializationTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor.
+     */
+    TcpOptionCwndSerializationTest();
+
+  private:
+    void DoRun() override;
+};
+
+TcpOptionCwndSerializationTest::TcpOptionCwndSerializationTest()
+    : TestCase("Serialization of the congestion window options")
+{
+}
+
+void
+TcpOptionCwndSerializationTest::DoRun()
+{
+    TcpOptionCwnd cwnd;
+    cwnd.SetCongestionWindow(1234);
+    NS_TEST_ASSERT_MSG_EQ(cwnd.GetSerializedSize(), 4, "The option should be 4 bytes long");
+
+    Buffer buffer;
+    buffer.AddAtStart(cwnd.GetSerializedSize());
+    cwnd.Serialize(buffer.Begin());
+    NS_TEST_ASSERT_MSG_EQ(buffer.Begin().PeekU8(), TcpOption::CWND, "Different kind found");
+
+    Ptr<TcpOption> read = TcpOption::CreateOption(TcpOption::CWND);
+    NS_TEST_ASSERT_MSG_EQ(read->Deserialize(buffer.Begin()), 4, "Deserialization failed");
+    NS_TEST_ASSERT_MSG_EQ(DynamicCast<TcpOptionCwnd>(read)->GetCongestionWindow(),
+                          1234,
+                          "Different cwnd found");
+
+    TcpOptionCwndPermitted permitted;
+    permitted.SetScale(3);
+    NS_TEST_ASSERT_MSG_EQ(permitted.GetSerializedSize(), 3, "The option should be 3 bytes long");
+
+    Buffer permittedBuffer;
+    permittedBuffer.AddAtStart(permitted.GetSerializedSize());
+    permitted.Serialize(permittedBuffer.Begin());
+
+    read = TcpOption::CreateOption(TcpOption::CWNDPERMITTED);
+    NS_TEST_ASSERT_MSG_EQ(read->Deserialize(permittedBuffer.Begin()), 3, "Deserialization failed");
+    NS_TEST_ASSERT_MSG_EQ(+DynamicCast<TcpOptionCwndPermitted>(read)->GetScale(),
+                          3,
+                          "Different scale found");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Negotiation and emission of the congestion window option.
+ *
+ * The option is only sent when both ends announced it in their SYN, never
+ * in a SYN, and not in every segment: only when the window changes or once
+ * per RTT.
+ */
+class TcpCwndOptionTestCase : public TcpGeneralTest
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param receiverEnabled whether the receiver enables the option
+     * \param scale scale of the windows sent by the sender
+     */
+    TcpCwndOptionTestCase(bool receiverEnabled, uint8_t scale);
+
+  protected:
+    void ConfigureEnvironment() override;
+    Ptr<TcpSocketMsgBase> CreateReceiverSocket(Ptr<Node> node) override;
+    Ptr<TcpSocketMsgBase> CreateSenderSocket(Ptr<Node> node) override;
+
+    void Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who) override;
+    void FinalChecks() override;
+
+    bool m_receiverEnabled; //!< Whether the receiver enables the option
+    uint8_t m_scale;        //!< Scale of the windows sent by the sender
+    uint32_t m_dataSegs{0}; //!< Data segments sent by the sender
+    uint32_t m_cwndSegs{0}; //!< Options sent by the sender
+    uint16_t m_lastCwnd{0}; //!< Last window sent by the sender
+};
+
+TcpCwndOptionTestCase::TcpCwndOptionTestCase(bool receiverEnabled, uint8_t scale)
+    : TcpGeneralTest("Testing the TCP congestion window option"),
+      m_receiverEnabled(receiverEnabled),
+      m_scale(scale)
+{
+}
+
+void
+TcpCwndOptionTestCase::ConfigureEnvironment()
+{
+    TcpGeneralTest::ConfigureEnvironment();
+    SetAppPktCount(100);
+    SetPropagationDelay(MilliSeconds(10));
+}
+
+Ptr<TcpSocketMsgBase>
+TcpCwndOptionTestCase::CreateReceiverSocket(Ptr<Node> node)
+{
+    Ptr<TcpSocketMsgBase> socket = TcpGeneralTest::CreateReceiverSocket(node);
+    socket->SetAttribute("CongestionWindowOption", BooleanValue(m_receiverEnabled));
+    return socket;
+}
+
+Ptr<TcpSocketMsgBase>
+TcpCwndOptionTestCase::CreateSenderSocket(Ptr<Node> node)
+{
+    Ptr<TcpSocketMsgBase> socket = TcpGeneralTest::CreateSenderSocket(node);
+    socket->SetAttribute("CongestionWindowOption", BooleanValue(true));
+    socket->SetAttribute("CongestionWindowOptionScale", UintegerValue(m_scale));
+    return socket;
+}
+
+void
+TcpCwndOptionTestCase::Tx(const Ptr<const Packet> p, const TcpHeader& h, SocketWho who)
+{
+    if (h.GetFlags() & TcpHeader::SYN)
+    {
+        NS_TEST_ASSERT_MSG_EQ(h.HasOption(TcpOption::CWND), false, "Cwnd option in a SYN");
+        bool expected = who == SENDER || m_receiverEnabled;
+        NS_TEST_ASSERT_MSG_EQ(h.HasOption(TcpOption::CWNDPERMITTED),
+                              expected,
+                              "Wrong Cwnd-Permitted option in a SYN");
+        return;
+    }
+
+    NS_TEST_ASSERT_MSG_EQ(h.HasOption(TcpOption::CWNDPERMITTED),
+                          false,
+                          "Cwnd-Permitted option in a non-SYN segment");
+    if (!m_receiverEnabled)
+    {
+        NS_TEST_ASSERT_MSG_EQ(h.HasOption(TcpOption::CWND), false, "Option not negotiated");
+        return;
+    }
+
+    if (who != SENDER)
+    {
+        return;
+    }
+    if (p->GetSize() > 0)
+    {
+        m_dataSegs++;
+    }
+    if (h.HasOption(TcpOption::CWND))
+    {
+        m_cwndSegs++;
+        m_lastCwnd = DynamicCast<const TcpOptionCwnd>(h.GetOption(TcpOption::CWND))
+                         ->GetCongestionWindow();
+        uint32_t segments = GetTcb(SENDER)->m_cWnd.Get() / GetSegSize(SENDER);
+        NS_TEST_ASSERT_MSG_EQ(m_lastCwnd, (segments >> m_scale), "Wrong window in the option");
+    }
+}
+
+void
+TcpCwndOptionTestCase::FinalChecks()
+{
+    if (!m_receiverEnabled)
+    {
+        return;
+    }
+    NS_TEST_ASSERT_MSG_GT(m_cwndSegs, 0, "The option should be sent");
+    NS_TEST_ASSERT_MSG_LT(m_cwndSegs, m_dataSegs, "The option should not be in every segment");
+    NS_TEST_ASSERT_MSG_EQ(GetTcb(RECEIVER)->m_rcvCwndValue,
+                          (static_cast<uint32_t>(m_lastCwnd) << m_scale) * GetSegSize(RECEIVER),
+                          "The receiver should know the last window sent");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief TCP congestion window option TestSuite
+ */
+class TcpCwndOptionTestSuite : public TestSuite
+{
+  public:
+    TcpCwndOptionTestSuite()
+        : TestSuite("tcp-cwnd-option", UNIT)
+    {
+        AddTestCase(new TcpOptionCwndSerializationTest(), TestCase::QUICK);
+        AddTestCase(new TcpCwndOptionTestCase(false, 0), TestCase::QUICK);
+        AddTestCase(new TcpCwndOptionTestCase(true, 0), TestCase::QUICK);
+        AddTestCase(new TcpCwndOptionTestCase(true, 1), TestCase::QUICK);
+    }
+};
+
+static TcpCwndOptionTestSuite g_tcpCwndOptionTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,439 @@
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/tcp-delayed-ack-ops.h"
+#include "ns3/tcp-socket-base.h"
+#include "ns3/tcp-socket-state.h"
+#include "ns3/test.h"
+
+#include <limits>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("TcpDelayedAckOpsTestSuite");
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Classic delayed ACK policy test
+ */
+class TcpDelayedAckClassicTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor.
+     */
+    TcpDelayedAckClassicTest();
+
+  private:
+    void DoRun() override;
+};
+
+TcpDelayedAckClassicTest::TcpDelayedAckClassicTest()
+    : TestCase("Classic delayed ACK follows DelAckCount and DelAckTimeout")
+{
+}
+
+void
+TcpDelayedAckClassicTest::DoRun()
+{
+    Ptr<TcpSocketState> state = CreateObject<TcpSocketState>();
+    state->m_segmentSize = 1000;
+
+    Ptr<TcpDelayedAckClassic> delAck = CreateObject<TcpDelayedAckClassic>();
+
+    NS_TEST_ASSERT_MSG_EQ(delAck->GetName(),
+                          "TcpDelayedAckClassic",
+                          "The name of the policy should be TcpDelayedAckClassic");
+    NS_TEST_ASSERT_MSG_EQ(delAck->RestartTimerOnSegment(),
+                          false,
+                          "Classic policy should not restart the timer");
+    NS_TEST_ASSERT_MSG_EQ(delAck->AggregateEndReceived(state),
+                          false,
+                          "Classic policy should ignore the end of the aggregates");
+
+    delAck->SegmentReceived(state);
+    NS_TEST_ASSERT_MSG_EQ(delAck->GetDelayWindow(state, 2), 2, "Window should be DelAckCount");
+    NS_TEST_ASSERT_MSG_EQ(delAck->GetDelayTimeout(state, 1, 2, MilliSeconds(200)),
+                          MilliSeconds(200),
+                          "Timeout should be DelAckTimeout");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief TCP-AAD delayed ACK policy test
+ *
+ * Segments arrive every millisecond: the timeout has to converge to
+ * Beta times the IAT, and the window must not limit the ACKs.
+ */
+class TcpDelayedAckAadTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor.
+     */
+    TcpDelayedAckAadTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Deliver a segment to the policy
+     */
+    void Receive();
+
+    Ptr<TcpSocketState> m_state;    //!< TCP socket state.
+    Ptr<TcpDelayedAckAad> m_delAck; //!< Tested policy.
+};
+
+TcpDelayedAckAadTest::TcpDelayedAckAadTest()
+    : TestCase("TCP-AAD timeout follows the inter-arrival time")
+{
+}
+
+void
+TcpDelayedAckAadTest::Receive()
+{
+    m_delAck->SegmentReceived(m_state);
+}
+
+void
+TcpDelayedAckAadTest::DoRun()
+{
+    m_state = CreateObject<TcpSocketState>();
+    m_state->m_segmentSize = 1000;
+
+    m_delAck = CreateObject<TcpDelayedAckAad>();
+    m_delAck->SetAttribute("Beta", DoubleValue(2));
+
+    NS_TEST_ASSERT_MSG_EQ(m_delAck->RestartTimerOnSegment(),
+                          true,
+                          "AAD should restart the timer on every segment");
+    NS_TEST_ASSERT_MSG_EQ(m_delAck->GetDelayWindow(m_state, 2),
+                          std::numeric_limits<uint32_t>::max(),
+                          "AAD ACKs are limited by the timeout only");
+    NS_TEST_ASSERT_MSG_EQ(m_delAck->GetDelayTimeout(m_state, 5, 2, MilliSeconds(200)),
+                          MilliSeconds(200),
+                          "Without IAT samples the default timeout is used");
+
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        Simulator::Schedule(MilliSeconds(i), &TcpDelayedAckAadTest::Receive, this);
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_delAck->GetIat(), 1e-3, 1e-9, "Wrong IAT");
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_delAck->GetBaseIat(), 1e-3, 1e-9, "Wrong base IAT");
+    NS_TEST_ASSERT_MSG_EQ(m_delAck->GetDelayTimeout(m_state, 1, 2, MilliSeconds(200)),
+                          MilliSeconds(200),
+                          "The first DelAckCount segments use the default timeout");
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_delAck->GetDelayTimeout(m_state, 5, 2, MilliSeconds(200)),
+                              MilliSeconds(2),
+                              NanoSeconds(1),
+                              "Timeout should be Beta times the IAT");
+    NS_TEST_ASSERT_MSG_EQ(m_delAck->GetDelayTimeout(m_state, 5, 2, MicroSeconds(500)),
+                          MicroSeconds(500),
+                          "Timeout should not exceed DelAckTimeout");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief TCP-ADW delayed ACK policy test
+ *
+ * The delay window grows while the sender cwnd grows, and is reset to
+ * Lambda segments on a cwnd reduction or an out-of-order segment.
+ */
+class TcpDelayedAckAdwTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor.
+     */
+    TcpDelayedAckAdwTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Deliver a segment to the policy
+     */
+    void Receive();
+
+    /**
+     * \brief Advertised window callback
+     * \param scale whether the window has to be scaled
+     * \return the advertised window
+     */
+    uint16_t GetAdvWnd(bool scale) const;
+
+    Ptr<TcpSocketState> m_state;    //!< TCP socket state.
+    Ptr<TcpDelayedAckAdw> m_delAck; //!< Tested policy.
+};
+
+TcpDelayedAckAdwTest::TcpDelayedAckAdwTest()
+    : TestCase("TCP-ADW delay window follows the sender cwnd")
+{
+}
+
+void
+TcpDelayedAckAdwTest::Receive()
+{
+    m_delAck->SegmentReceived(m_state);
+}
+
+uint16_t
+TcpDelayedAckAdwTest::GetAdvWnd(bool scale [[maybe_unused]]) const
+{
+    return 65535;
+}
+
+void
+TcpDelayedAckAdwTest::DoRun()
+{
+    m_state = CreateObject<TcpSocketState>();
+    m_state->m_segmentSize = 1000;
+    m_state->m_rcvCwndValue = 10000;
+    m_state->m_rcvCwndDiff = 1000;
+
+    m_delAck = CreateObject<TcpDelayedAckAdw>();
+    m_delAck->SetAttribute("Lambda", DoubleValue(2));
+    m_delAck->SetAdvWndCallback(MakeCallback(&TcpDelayedAckAdwTest::GetAdvWnd, this));
+
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        Simulator::Schedule(MilliSeconds(i), &TcpDelayedAckAdwTest::Receive, this);
+    }
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(m_delAck->GetDelayWindow(m_state, 2),
+                          10,
+                          "Window should grow up to the sender cwnd");
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_delAck->GetDelayTimeout(m_state, 1, 2, MilliSeconds(200)),
+                              MilliSeconds(2),
+                              NanoSeconds(1),
+                              "Timeout should be Lambda times the IAT");
+
+    m_delAck->OutOfOrderReceived(m_state);
+    NS_TEST_ASSERT_MSG_EQ(m_delAck->GetDelayWindow(m_state, 2),
+                          2,
+                          "Window should be reset on out-of-order segments");
+
+    Ptr<TcpDelayedAckOps> fork = m_delAck->Fork();
+    NS_TEST_ASSERT_MSG_EQ(fork->GetName(), "TcpDelayedAckAdw", "Fork should keep the policy");
+    NS_TEST_ASSERT_MSG_EQ(fork->GetDelayWindow(m_state, 2), 2, "Fork should keep the window");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Base IAT windowed minimum test
+ *
+ * The IAT grows from 1 ms to 2 ms: the base IAT keeps the minimum for
+ * BaseIatWindow, and then follows the new IAT.
+ */
+class TcpDelayedAckBaseIatWindowTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor.
+     */
+    TcpDelayedAckBaseIatWindowTest();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Deliver a segment to the policy
+     */
+    void Receive();
+
+    /**
+     * \brief Check the base IAT
+     * \param expected the expected base IAT, in seconds
+     */
+    void CheckBaseIat(double expected);
+
+    Ptr<TcpSocketState> m_state;    //!< TCP socket state.
+    Ptr<TcpDelayedAckAad> m_delAck; //!< Tested policy.
+};
+
+TcpDelayedAckBaseIatWindowTest::TcpDelayedAckBaseIatWindowTest()
+    : TestCase("The base IAT is the windowed minimum of the IAT")
+{
+}
+
+void
+TcpDelayedAckBaseIatWindowTest::Receive()
+{
+    m_delAck->SegmentReceived(m_state);
+}
+
+void
+TcpDelayedAckBaseIatWindowTest::CheckBaseIat(double expected)
+{
+    NS_TEST_EXPECT_MSG_EQ_TOL(m_delAck->GetBaseIat(),
+                              expected,
+                              1e-9,
+                              "Wrong base IAT at " << Simulator::Now().As(Time::MS));
+}
+
+void
+TcpDelayedAckBaseIatWindowTest::DoRun()
+{
+    m_state = CreateObject<TcpSocketState>();
+    m_state->m_segmentSize = 1000;
+
+    m_delAck = CreateObject<TcpDelayedAckAad>();
+    m_delAck->SetAttribute("BaseIatWindow", TimeValue(MilliSeconds(50)));
+
+    for (uint32_t i = 0; i <= 10; ++i)
+    {
+        Simulator::Schedule(MilliSeconds(i), &TcpDelayedAckBaseIatWindowTest::Receive, this);
+    }
+    for (uint32_t i = 12; i <= 200; i += 2)
+    {
+        Simulator::Schedule(MilliSeconds(i), &TcpDelayedAckBaseIatWindowTest::Receive, this);
+    }
+    Simulator::Schedule(MicroSeconds(40500),
+                        &TcpDelayedAckBaseIatWindowTest::CheckBaseIat,
+                        this,
+                        1e-3);
+    Simulator::Schedule(MicroSeconds(200500),
+                        &TcpDelayedAckBaseIatWindowTest::CheckBaseIat,
+                        this,
+                        2e-3);
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ_TOL(m_delAck->GetIat(), 2e-3, 1e-9, "Wrong IAT");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Aggregate end driven delayed ACK policy test
+ */
+class TcpDelayedAckAggregateEndTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor.
+     */
+    TcpDelayedAckAggregateEndTest();
+
+  private:
+    void DoRun() override;
+};
+
+TcpDelayedAckAggregateEndTest::TcpDelayedAckAggregateEndTest()
+    : TestCase("Aggregate end policy acknowledges on the end of the aggregates")
+{
+}
+
+void
+TcpDelayedAckAggregateEndTest::DoRun()
+{
+    Ptr<TcpSocketState> state = CreateObject<TcpSocketState>();
+    state->m_segmentSize = 1000;
+
+    Ptr<TcpDelayedAckAggregateEnd> delAck = CreateObject<TcpDelayedAckAggregateEnd>();
+
+    delAck->SegmentReceived(state);
+    NS_TEST_ASSERT_MSG_EQ(delAck->GetDelayWindow(state, 2),
+                          2,
+                          "Without aggregates the window should be DelAckCount");
+    NS_TEST_ASSERT_MSG_EQ(delAck->GetDelayTimeout(state, 5, 2, MilliSeconds(200)),
+                          MilliSeconds(200),
+                          "Timeout should be DelAckTimeout");
+
+    NS_TEST_ASSERT_MSG_EQ(delAck->AggregateEndReceived(state),
+                          true,
+                          "The end of an aggregate should trigger an ACK");
+    NS_TEST_ASSERT_MSG_EQ(delAck->GetDelayWindow(state, 2),
+                          std::numeric_limits<uint32_t>::max(),
+                          "ACKs should not be limited by a segment count anymore");
+
+    Ptr<TcpDelayedAckOps> fork = delAck->Fork();
+    NS_TEST_ASSERT_MSG_EQ(fork->GetName(), "TcpDelayedAckAggregateEnd", "Wrong forked policy");
+    NS_TEST_ASSERT_MSG_EQ(fork->GetDelayWindow(state, 2),
+                          std::numeric_limits<uint32_t>::max(),
+                          "The forked policy should keep the aggregation state");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Delayed ACK statistics test
+ */
+class TcpDelayedAckStatsTest : public TestCase
+{
+  public:
+    /**
+     * \brief Constructor.
+     */
+    TcpDelayedAckStatsTest();
+
+  private:
+    void DoRun() override;
+};
+
+TcpDelayedAckStatsTest::TcpDelayedAckStatsTest()
+    : TestCase("Delayed ACK statistics count the ACKs and their delays")
+{
+}
+
+void
+TcpDelayedAckStatsTest::DoRun()
+{
+    DelayedAckStats stats;
+    NS_TEST_ASSERT_MSG_EQ(stats.GetAcksPerSegment(), 0, "No segment received yet");
+    NS_TEST_ASSERT_MSG_EQ(stats.GetMeanDelay(), Time(), "No ACK sent yet");
+
+    stats.segments = 8;
+    stats.RecordAck(DelayedAckStats::IMMEDIATE, Time());
+    stats.RecordAck(DelayedAckStats::COUNT, MicroSeconds(3));
+    stats.RecordAck(DelayedAckStats::COUNT, MicroSeconds(100));
+    stats.RecordAck(DelayedAckStats::TIMEOUT, MilliSeconds(200));
+
+    NS_TEST_ASSERT_MSG_EQ(stats.GetNAcks(), 4, "Wrong number of ACKs");
+    NS_TEST_ASSERT_MSG_EQ(stats.acks[DelayedAckStats::COUNT], 2, "Wrong number of count ACKs");
+    NS_TEST_ASSERT_MSG_EQ(stats.GetAcksPerSegment(), 0.5, "Wrong number of ACKs per segment");
+    NS_TEST_ASSERT_MSG_EQ(stats.maxDelay, MilliSeconds(200), "Wrong longest delay");
+    NS_TEST_ASSERT_MSG_EQ(stats.GetMeanDelay(), NanoSeconds(50025750), "Wrong mean delay");
+
+    NS_TEST_ASSERT_MSG_EQ(stats.delayHistogram[0], 1, "A null delay goes to the first bucket");
+    NS_TEST_ASSERT_MSG_EQ(stats.delayHistogram[2], 1, "3us is in [2us, 4us)");
+    NS_TEST_ASSERT_MSG_EQ(stats.delayHistogram[7], 1, "100us is in [64us, 128us)");
+    NS_TEST_ASSERT_MSG_EQ(stats.delayHistogram[18], 1, "200ms is in [131ms, 262ms)");
+    NS_TEST_ASSERT_MSG_EQ(std::string(DelayedAckStats::GetTriggerName(DelayedAckStats::TIMEOUT)),
+                          "timeout",
+                          "Wrong trigger name");
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Delayed ACK policies TestSuite
+ */
+class TcpDelayedAckOpsTestSuite : public TestSuite
+{
+  public:
+    TcpDelayedAckOpsTestSuite()
+        : TestSuite("tcp-delayed-ack-ops-test", UNIT)
+    {
+        AddTestCase(new TcpDelayedAckClassicTest(), TestCase::QUICK);
+        AddTestCase(new TcpDelayedAckAadTest(), TestCase::QUICK);
+        AddTestCase(new TcpDelayedAckAdwTest(), TestCase::QUICK);
+        AddTestCase(new TcpDelayedAckBaseIatWindowTest(), TestCase::QUICK);
+        AddTestCase(new TcpDelayedAckAggregateEndTest(), TestCase::QUICK);
+        AddTestCase(new TcpDelayedAckStatsTest(), TestCase::QUICK);
+    }
+};
+
+static TcpDelayedAckOpsTestSuite
+    g_tcpDelayedAckOpsTestSuite; //!< Static variable for test initialization
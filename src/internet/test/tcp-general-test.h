@@ -552,12 +552,12 @@ class TcpGeneralTest : public TestCase
     uint32_t GetRWnd(SocketWho who);
 
     /**
-     * \brief Get the persistent event of the selected socket
+     * \brief Get the persist timer of the selected socket
      *
      * \param who socket where check the parameter
-     * \return the persistent event in the selected socket
+     * \return the persist timer of the selected socket
      */
-    EventId GetPersistentEvent(SocketWho who);
+    const RestartableTimer& GetPersistentEvent(SocketWho who);
 
     /**
      * \brief Get the persistent timeout of the selected socket
@@ -235,7 +235,7 @@ TcpZeroWindowTest::ProcessedAck(const Ptr<const TcpSocketState> tcb,
     {
         if (h.GetFlags() & TcpHeader::SYN)
         {
-            EventId persistentEvent = GetPersistentEvent(SENDER);
+            const RestartableTimer& persistentEvent = GetPersistentEvent(SENDER);
             NS_TEST_ASSERT_MSG_EQ(persistentEvent.IsRunning(),
                                   true,
                                   "Persistent event not started");
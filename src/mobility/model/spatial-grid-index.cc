@@ -0,0 +1,191 @@
+#include "spatial-grid-index.h"
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * \file
+ * \ingroup mobility
+ * ns3::SpatialGridIndex implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("SpatialGridIndex");
+
+std::size_t
+SpatialGridIndex::CellHash::operator()(const Cell& cell) const
+{
+    std::size_t hash = std::hash<int64_t>{}(cell.x);
+    hash = hash * 31 + std::hash<int64_t>{}(cell.y);
+    hash = hash * 31 + std::hash<int64_t>{}(cell.z);
+    return hash;
+}
+
+SpatialGridIndex::SpatialGridIndex(double cellSize)
+    : m_cellSize(cellSize)
+{
+    NS_LOG_FUNCTION(this << cellSize);
+    NS_ASSERT_MSG(cellSize > 0, "The cells of the grid must have a positive size");
+}
+
+SpatialGridIndex::~SpatialGridIndex()
+{
+    NS_LOG_FUNCTION(this);
+    Clear();
+}
+
+double
+SpatialGridIndex::GetCellSize() const
+{
+    return m_cellSize;
+}
+
+SpatialGridIndex::Cell
+SpatialGridIndex::GetCell(const Vector& position) const
+{
+    return {static_cast<int64_t>(std::floor(position.x / m_cellSize)),
+            static_cast<int64_t>(std::floor(position.y / m_cellSize)),
+            static_cast<int64_t>(std::floor(position.z / m_cellSize))};
+}
+
+void
+SpatialGridIndex::Add(uint32_t id, Ptr<MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << id << mobility);
+    auto [it, inserted] = m_items.emplace(id, Item());
+    NS_ASSERT_MSG(inserted, "Item " << id << " is already in the index");
+    Item& item = it->second;
+    item.mobility = mobility;
+    if (mobility)
+    {
+        item.courseChange = MakeCallback(&SpatialGridIndex::CourseChanged, this).Bind(id);
+        mobility->TraceConnectWithoutContext("CourseChange", item.courseChange);
+    }
+    Insert(id, item);
+}
+
+void
+SpatialGridIndex::Remove(uint32_t id)
+{
+    NS_LOG_FUNCTION(this << id);
+    auto it = m_items.find(id);
+    if (it == m_items.end())
+    {
+        return;
+    }
+    Erase(id, it->second);
+    if (it->second.mobility)
+    {
+        it->second.mobility->TraceDisconnectWithoutContext("CourseChange", it->second.courseChange);
+    }
+    m_items.erase(it);
+}
+
+void
+SpatialGridIndex::Clear()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& [id, item] : m_items)
+    {
+        if (item.mobility)
+        {
+            item.mobility->TraceDisconnectWithoutContext("CourseChange", item.courseChange);
+        }
+    }
+    m_items.clear();
+    m_cells.clear();
+    m_moving.clear();
+}
+
+std::size_t
+SpatialGridIndex::GetN() const
+{
+    return m_items.size();
+}
+
+void
+SpatialGridIndex::Insert(uint32_t id, Item& item)
+{
+    item.moving = true;
+    if (item.mobility)
+    {
+        Vector velocity = item.mobility->GetVelocity();
+        item.moving = velocity.x != 0 || velocity.y != 0 || velocity.z != 0;
+    }
+    if (item.moving)
+    {
+        m_moving.push_back(id);
+    }
+    else
+    {
+        item.cell = GetCell(item.mobility->GetPosition());
+        m_cells[item.cell].push_back(id);
+    }
+}
+
+void
+SpatialGridIndex::Erase(uint32_t id, const Item& item)
+{
+    std::vector<uint32_t>& ids = item.moving ? m_moving : m_cells[item.cell];
+    ids.erase(std::find(ids.begin(), ids.end(), id));
+    if (!item.moving && ids.empty())
+    {
+        m_cells.erase(item.cell);
+    }
+}
+
+void
+SpatialGridIndex::CourseChanged(uint32_t id, Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << id << mobility);
+    Item& item = m_items[id];
+    Erase(id, item);
+    Insert(id, item);
+}
+
+void
+SpatialGridIndex::GetNear(const Vector& position, double range, std::vector<uint32_t>& ids) const
+{
+    ids.assign(m_moving.begin(), m_moving.end());
+    Cell low = GetCell(position - Vector(range, range, range));
+    Cell high = GetCell(position + Vector(range, range, range));
+    auto cells = static_cast<double>(high.x - low.x + 1) * (high.y - low.y + 1) *
+                 (high.z - low.z + 1);
+    if (cells > m_cells.size())
+    {
+        // the range covers more cells than there are non-empty cells
+        for (const auto& [cell, items] : m_cells)
+        {
+            if (cell.x >= low.x && cell.x <= high.x && cell.y >= low.y && cell.y <= high.y &&
+                cell.z >= low.z && cell.z <= high.z)
+            {
+                ids.insert(ids.end(), items.begin(), items.end());
+            }
+        }
+    }
+    else
+    {
+        for (int64_t x = low.x; x <= high.x; x++)
+        {
+            for (int64_t y = low.y; y <= high.y; y++)
+            {
+                for (int64_t z = low.z; z <= high.z; z++)
+                {
+                    auto it = m_cells.find({x, y, z});
+                    if (it != m_cells.end())
+                    {
+                        ids.insert(ids.end(), it->second.begin(), it->second.end());
+                    }
+                }
+            }
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+}
+
+} // namespace ns3
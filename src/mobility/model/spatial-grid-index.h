@@ -0,0 +1,162 @@
+#ifndef SPATIAL_GRID_INDEX_H
+#define SPATIAL_GRID_INDEX_H
+
+#include "mobility-model.h"
+
+#include "ns3/callback.h"
+#include "ns3/ptr.h"
+#include "ns3/vector.h"
+
+#include <unordered_map>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup mobility
+ * ns3::SpatialGridIndex declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup mobility
+ * \brief Index of the positions of mobility models in a uniform grid.
+ *
+ * The index finds the items near a position without a scan of all the
+ * items, for instance the receivers of a channel in range of a transmitter.
+ * Each item is an identifier chosen by the owner of the index, with the
+ * MobilityModel which gives its position.
+ *
+ * The items which do not move are in the cells of a grid of cubes, and
+ * change of cell at each course change of their mobility model. The items
+ * which move, those with a non-zero velocity at their last course change,
+ * are near every position until they stop, as are the items without
+ * mobility model. A mobility model which moves
+ * without velocity nor course change, such as a
+ * ConstantAccelerationMobilityModel starting at rest, must not be indexed.
+ *
+ * The index is connected to the CourseChange trace source of the mobility
+ * models of its items, until they are removed or the index is destroyed.
+ */
+class SpatialGridIndex
+{
+  public:
+    /**
+     * Create an empty index.
+     * \param cellSize the size of the cells of the grid, in meters. The
+     *        index is the fastest when the cells are about the size of the
+     *        range of the queries.
+     */
+    SpatialGridIndex(double cellSize);
+    ~SpatialGridIndex();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    SpatialGridIndex(const SpatialGridIndex&) = delete;
+    SpatialGridIndex& operator=(const SpatialGridIndex&) = delete;
+
+    /**
+     * \return the size of the cells of the grid, in meters
+     */
+    double GetCellSize() const;
+    /**
+     * Add an item to the index.
+     * \param id the identifier of the item, not already in the index
+     * \param mobility the mobility model of the item, or null
+     */
+    void Add(uint32_t id, Ptr<MobilityModel> mobility);
+    /**
+     * Remove an item from the index, if it is in the index.
+     * \param id the identifier of the item
+     */
+    void Remove(uint32_t id);
+    /**
+     * Remove all the items.
+     */
+    void Clear();
+    /**
+     * \return the number of items in the index
+     */
+    std::size_t GetN() const;
+    /**
+     * Find the items which may be within a distance of a position.
+     *
+     * The result includes every item within the distance, and some items
+     * further away: the caller checks the exact distance when needed.
+     *
+     * \param position the position
+     * \param range the distance, in meters
+     * \param [out] ids the identifiers of the items, in increasing order
+     */
+    void GetNear(const Vector& position, double range, std::vector<uint32_t>& ids) const;
+
+  private:
+    /** Coordinates of a cell of the grid. */
+    struct Cell
+    {
+        int64_t x; //!< x coordinate
+        int64_t y; //!< y coordinate
+        int64_t z; //!< z coordinate
+
+        /**
+         * \param other another cell
+         * \return true if the cells are the same
+         */
+        bool operator==(const Cell& other) const
+        {
+            return x == other.x && y == other.y && z == other.z;
+        }
+    };
+
+    /** Hash of the coordinates of a cell. */
+    struct CellHash
+    {
+        /**
+         * \param cell a cell
+         * \return the hash of the cell
+         */
+        std::size_t operator()(const Cell& cell) const;
+    };
+
+    /** An item of the index. */
+    struct Item
+    {
+        Ptr<MobilityModel> mobility;                           //!< The mobility model
+        Callback<void, Ptr<const MobilityModel>> courseChange; //!< The course change callback
+        bool moving;                                           //!< Whether the item moves
+        Cell cell;                                             //!< The cell, if it does not move
+    };
+
+    /**
+     * \param position a position
+     * \return the cell of the position
+     */
+    Cell GetCell(const Vector& position) const;
+    /**
+     * Put an item in its cell, or in the list of the moving items.
+     * \param id the identifier of the item
+     * \param item the item
+     */
+    void Insert(uint32_t id, Item& item);
+    /**
+     * Remove an item from its cell, or from the list of the moving items.
+     * \param id the identifier of the item
+     * \param item the item
+     */
+    void Erase(uint32_t id, const Item& item);
+    /**
+     * Update the place of an item after a course change of its mobility model.
+     * \param id the identifier of the item
+     * \param mobility the mobility model
+     */
+    void CourseChanged(uint32_t id, Ptr<const MobilityModel> mobility);
+
+    double m_cellSize;                                                 //!< Size of the cells
+    std::unordered_map<uint32_t, Item> m_items;                        //!< The items
+    std::unordered_map<Cell, std::vector<uint32_t>, CellHash> m_cells; //!< Items which do not move
+    std::vector<uint32_t> m_moving;                                    //!< Items which move
+};
+
+} // namespace ns3
+
+#endif /* SPATIAL_GRID_INDEX_H */
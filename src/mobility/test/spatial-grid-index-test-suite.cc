@@ -0,0 +1,168 @@
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/constant-velocity-mobility-model.h>
+#include <ns3/simulator.h>
+#include <ns3/spatial-grid-index.h>
+#include <ns3/test.h>
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup mobility-test
+ *
+ * \brief Check the items found near a position by the SpatialGridIndex
+ * against the distances to all the items, as the items move.
+ */
+class SpatialGridIndexTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     */
+    SpatialGridIndexTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the items found near some positions.
+     * \param step the step of the test, for the messages
+     */
+    void Check(const std::string& step);
+
+    /**
+     * \return a random coordinate, between -500 and 500 meters
+     */
+    double Draw();
+
+    uint64_t m_rng{1};                            //!< State of the random coordinates
+    std::vector<Ptr<MobilityModel>> m_mobilities; //!< Mobility models of the items
+    std::vector<bool> m_indexed;                  //!< Whether each item is in the index
+    SpatialGridIndex m_index{100};                //!< The index
+};
+
+SpatialGridIndexTestCase::SpatialGridIndexTestCase()
+    : TestCase("Check the items found near a position")
+{
+}
+
+double
+SpatialGridIndexTestCase::Draw()
+{
+    m_rng = m_rng * 6364136223846793005ULL + 1442695040888963407ULL;
+    return static_cast<double>(m_rng >> 33) / (1ULL << 31) * 1000 - 500;
+}
+
+void
+SpatialGridIndexTestCase::Check(const std::string& step)
+{
+    for (uint32_t query = 0; query < 50; query++)
+    {
+        Vector position(Draw(), Draw(), Draw() / 50);
+        double range = (Draw() + 500) / 4;
+        std::vector<uint32_t> ids;
+        m_index.GetNear(position, range, ids);
+        std::vector<uint32_t> expected;
+        for (uint32_t id = 0; id < m_mobilities.size(); id++)
+        {
+            if (m_indexed[id] &&
+                CalculateDistance(m_mobilities[id]->GetPosition(), position) <= range)
+            {
+                expected.push_back(id);
+            }
+        }
+        std::vector<uint32_t> found;
+        for (std::size_t i = 0; i < ids.size(); i++)
+        {
+            NS_TEST_ASSERT_MSG_EQ((i == 0 || ids[i - 1] < ids[i]),
+                                  true,
+                                  step << ": the items are not in increasing order");
+            NS_TEST_ASSERT_MSG_EQ(m_indexed[ids[i]], true, step << ": unexpected item " << ids[i]);
+            if (CalculateDistance(m_mobilities[ids[i]]->GetPosition(), position) <= range)
+            {
+                found.push_back(ids[i]);
+            }
+        }
+        NS_TEST_EXPECT_MSG_EQ((found == expected),
+                              true,
+                              step << ": wrong items near " << position << " within " << range);
+    }
+}
+
+void
+SpatialGridIndexTestCase::DoRun()
+{
+    for (uint32_t id = 0; id < 200; id++)
+    {
+        Ptr<MobilityModel> mobility;
+        if (id % 20 == 0)
+        {
+            mobility = CreateObject<ConstantVelocityMobilityModel>();
+        }
+        else
+        {
+            mobility = CreateObject<ConstantPositionMobilityModel>();
+        }
+        mobility->SetPosition(Vector(Draw(), Draw(), Draw() / 50));
+        if (id % 20 == 0)
+        {
+            DynamicCast<ConstantVelocityMobilityModel>(mobility)->SetVelocity(
+                Vector(Draw() / 10, Draw() / 10, 0));
+        }
+        m_mobilities.push_back(mobility);
+        m_indexed.push_back(true);
+        m_index.Add(id, mobility);
+    }
+    NS_TEST_ASSERT_MSG_EQ(m_index.GetN(), 200, "Wrong number of items");
+    Check("initial positions");
+
+    // the moving items are found at their current position
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+    Check("after 10 s");
+
+    // course changes
+    for (uint32_t id = 1; id < m_mobilities.size(); id += 7)
+    {
+        m_mobilities[id]->SetPosition(Vector(Draw(), Draw(), 0));
+    }
+    DynamicCast<ConstantVelocityMobilityModel>(m_mobilities[0])->SetVelocity(Vector(0, 0, 0));
+    DynamicCast<ConstantVelocityMobilityModel>(m_mobilities[20])->SetVelocity(Vector(0, 0, 0));
+    Check("after course changes");
+
+    for (uint32_t id = 0; id < m_mobilities.size(); id += 3)
+    {
+        m_index.Remove(id);
+        m_indexed[id] = false;
+    }
+    // the removed items are no longer connected to the course changes
+    m_mobilities[3]->SetPosition(Vector(Draw(), Draw(), 0));
+    Check("after removals");
+
+    m_index.Clear();
+    NS_TEST_EXPECT_MSG_EQ(m_index.GetN(), 0, "Items left after Clear()");
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup mobility-test
+ *
+ * \brief SpatialGridIndex test suite.
+ */
+class SpatialGridIndexTestSuite : public TestSuite
+{
+  public:
+    /**
+     * Constructor
+     */
+    SpatialGridIndexTestSuite();
+};
+
+SpatialGridIndexTestSuite::SpatialGridIndexTestSuite()
+    : TestSuite("spatial-grid-index", UNIT)
+{
+    AddTestCase(new SpatialGridIndexTestCase, TestCase::QUICK);
+}
+
+static SpatialGridIndexTestSuite g_spatialGridIndexTestSuite; ///< the test suite
@@ -20,6 +20,7 @@
 
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/simulator-context.h"
 
 #define LOG_INTERNAL_STATE(y)                                                                      \
     NS_LOG_LOGIC(y << "start=" << m_start << ", end=" << m_end                                     \
@@ -102,6 +103,12 @@ Buffer::Recycle(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
+    if (SimulatorContext::IsMultithreaded())
+    {
+        // the free list would be shared by the simulation threads
+        Buffer::Deallocate(data);
+        return;
+    }
     NS_ASSERT(!IS_UNINITIALIZED(g_freeList));
     g_maxSize = std::max(g_maxSize, data->m_size);
     /* feed into free list */
@@ -120,6 +127,10 @@ Buffer::Data*
 Buffer::Create(uint32_t dataSize)
 {
     NS_LOG_FUNCTION(dataSize);
+    if (SimulatorContext::IsMultithreaded())
+    {
+        return Buffer::Allocate(dataSize);
+    }
     /* try to find a buffer correctly sized. */
     if (IS_UNINITIALIZED(g_freeList))
     {
@@ -133,7 +144,7 @@ Buffer::Create(uint32_t dataSize)
             g_freeList->pop_back();
             if (data->m_size >= dataSize)
             {
-                data->m_count = 1;
+                data->m_count.store(1, std::memory_order_relaxed);
                 return data;
             }
             Buffer::Deallocate(data);
@@ -176,7 +187,7 @@ Buffer::Allocate(uint32_t reqSize)
     auto b = new uint8_t[size];
     auto data = reinterpret_cast<Buffer::Data*>(b);
     data->m_size = reqSize;
-    data->m_count = 1;
+    data->m_count.store(1, std::memory_order_relaxed);
     return data;
 }
 
@@ -266,13 +277,12 @@ Buffer::operator=(const Buffer& o)
     if (m_data != o.m_data)
     {
         // not assignment to self.
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (SimpleRefCountMode::Decrement(m_data->m_count) == 0)
         {
             Recycle(m_data);
         }
         m_data = o.m_data;
-        m_data->m_count++;
+        SimpleRefCountMode::Increment(m_data->m_count);
     }
     g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
     m_maxZeroAreaStart = o.m_maxZeroAreaStart;
@@ -289,8 +299,7 @@ Buffer::~Buffer()
     NS_LOG_FUNCTION(this);
     NS_ASSERT(CheckInternalState());
     g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (SimpleRefCountMode::Decrement(m_data->m_count) == 0)
     {
         Recycle(m_data);
     }
@@ -315,7 +324,9 @@ Buffer::AddAtStart(uint32_t start)
 {
     NS_LOG_FUNCTION(this << start);
     NS_ASSERT(CheckInternalState());
-    bool isDirty = m_data->m_count > 1 && m_start > m_data->m_dirtyStart;
+    // in parallel, the other buffers may add their bytes at the same time
+    bool isDirty = m_data->m_count > 1 &&
+                   (m_start > m_data->m_dirtyStart || SimulatorContext::IsParallel());
     if (m_start >= start && !isDirty)
     {
         /* enough space in the buffer and not dirty.
@@ -333,8 +344,7 @@ Buffer::AddAtStart(uint32_t start)
         uint32_t newSize = GetInternalSize() + start;
         Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data + start, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (SimpleRefCountMode::Decrement(m_data->m_count) == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -361,7 +371,8 @@ Buffer::AddAtEnd(uint32_t end)
 {
     NS_LOG_FUNCTION(this << end);
     NS_ASSERT(CheckInternalState());
-    bool isDirty = m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
+    bool isDirty =
+        m_data->m_count > 1 && (m_end < m_data->m_dirtyEnd || SimulatorContext::IsParallel());
     if (GetInternalEnd() + end <= m_data->m_size && !isDirty)
     {
         /* enough space in buffer and not dirty
@@ -379,8 +390,7 @@ Buffer::AddAtEnd(uint32_t end)
         uint32_t newSize = GetInternalSize() + end;
         Buffer::Data* newData = Buffer::Create(newSize);
         memcpy(newData->m_data, m_data->m_data + m_start, GetInternalSize());
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (SimpleRefCountMode::Decrement(m_data->m_count) == 0)
         {
             Buffer::Recycle(m_data);
         }
@@ -20,7 +20,9 @@
 #define BUFFER_H
 
 #include "ns3/assert.h"
+#include "ns3/simple-ref-count.h"
 
+#include <atomic>
 #include <ostream>
 #include <stdint.h>
 #include <vector>
@@ -664,8 +666,9 @@ class Buffer
         /**
          * The reference count of an instance of this data structure.
          * Each buffer which references an instance holds a count.
+         * It is updated with SimpleRefCountMode.
          */
-        uint32_t m_count;
+        std::atomic<uint32_t> m_count;
         /**
          * the size of the m_data field below.
          */
@@ -1060,7 +1063,7 @@ Buffer::Buffer(const Buffer& o)
       m_start(o.m_start),
       m_end(o.m_end)
 {
-    m_data->m_count++;
+    SimpleRefCountMode::Increment(m_data->m_count);
     NS_ASSERT(CheckInternalState());
 }
 
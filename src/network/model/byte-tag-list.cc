@@ -19,7 +19,10 @@
 #include "byte-tag-list.h"
 
 #include "ns3/log.h"
+#include "ns3/simple-ref-count.h"
+#include "ns3/simulator-context.h"
 
+#include <atomic>
 #include <cstring>
 #include <limits>
 #include <vector>
@@ -42,10 +45,10 @@ NS_LOG_COMPONENT_DEFINE("ByteTagList");
  */
 struct ByteTagListData
 {
-    uint32_t size;   //!< size of the data
-    uint32_t count;  //!< use counter (for smart deallocation)
-    uint32_t dirty;  //!< number of bytes actually in use
-    uint8_t data[4]; //!< data
+    uint32_t size;               //!< size of the data
+    std::atomic<uint32_t> count; //!< use counter (for smart deallocation)
+    uint32_t dirty;              //!< number of bytes actually in use
+    uint8_t data[4];             //!< data
 };
 
 #ifdef USE_FREE_LIST
@@ -167,7 +170,7 @@ ByteTagList::ByteTagList(const ByteTagList& o)
     NS_LOG_FUNCTION(this << &o);
     if (m_data != nullptr)
     {
-        m_data->count++;
+        SimpleRefCountMode::Increment(m_data->count);
     }
 }
 
@@ -187,7 +190,7 @@ ByteTagList::operator=(const ByteTagList& o)
     m_used = o.m_used;
     if (m_data != nullptr)
     {
-        m_data->count++;
+        SimpleRefCountMode::Increment(m_data->count);
     }
     return *this;
 }
@@ -211,7 +214,8 @@ ByteTagList::Add(TypeId tid, uint32_t bufferSize, int32_t start, int32_t end)
         m_data = Allocate(spaceNeeded);
         m_used = 0;
     }
-    else if (m_data->size < spaceNeeded || (m_data->count != 1 && m_data->dirty != m_used))
+    else if (m_data->size < spaceNeeded ||
+             (m_data->count != 1 && (m_data->dirty != m_used || SimulatorContext::IsParallel())))
     {
         ByteTagListData* newData = Allocate(spaceNeeded);
         std::memcpy(&newData->data, &m_data->data, m_used);
@@ -355,14 +359,15 @@ ByteTagListData*
 ByteTagList::Allocate(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
-    while (!g_freeList.empty())
+    // the free list would be shared by the simulation threads
+    while (!SimulatorContext::IsMultithreaded() && !g_freeList.empty())
     {
         ByteTagListData* data = g_freeList.back();
         g_freeList.pop_back();
         NS_ASSERT(data != nullptr);
         if (data->size >= size)
         {
-            data->count = 1;
+            data->count.store(1, std::memory_order_relaxed);
             data->dirty = 0;
             return data;
         }
@@ -371,7 +376,7 @@ ByteTagList::Allocate(uint32_t size)
     }
     auto buffer = new uint8_t[std::max(size, g_maxSize) + sizeof(ByteTagListData) - 4];
     auto data = (ByteTagListData*)buffer;
-    data->count = 1;
+    data->count.store(1, std::memory_order_relaxed);
     data->size = size;
     data->dirty = 0;
     return data;
@@ -385,9 +390,18 @@ ByteTagList::Deallocate(ByteTagListData* data)
     {
         return;
     }
+    uint32_t count = SimpleRefCountMode::Decrement(data->count);
+    if (SimulatorContext::IsMultithreaded())
+    {
+        if (count == 0)
+        {
+            auto buffer = (uint8_t*)data;
+            delete[] buffer;
+        }
+        return;
+    }
     g_maxSize = std::max(g_maxSize, data->size);
-    data->count--;
-    if (data->count == 0)
+    if (count == 0)
     {
         if (g_freeList.size() > FREE_LIST_SIZE || data->size < g_maxSize)
         {
@@ -409,7 +423,7 @@ ByteTagList::Allocate(uint32_t size)
     NS_LOG_FUNCTION(this << size);
     uint8_t* buffer = new uint8_t[size + sizeof(ByteTagListData) - 4];
     ByteTagListData* data = (ByteTagListData*)buffer;
-    data->count = 1;
+    data->count.store(1, std::memory_order_relaxed);
     data->size = size;
     data->dirty = 0;
     return data;
@@ -423,8 +437,7 @@ ByteTagList::Deallocate(ByteTagListData* data)
     {
         return;
     }
-    data->count--;
-    if (data->count == 0)
+    if (SimpleRefCountMode::Decrement(data->count) == 0)
     {
         uint8_t* buffer = (uint8_t*)data;
         delete[] buffer;
@@ -23,6 +23,7 @@
 #include "ns3/config.h"
 #include "ns3/log.h"
 #include "ns3/object-vector.h"
+#include "ns3/simulator-context.h"
 #include "ns3/simulator.h"
 
 namespace ns3
@@ -130,7 +131,9 @@ Ptr<ChannelListPriv>*
 ChannelListPriv::DoGet()
 {
     NS_LOG_FUNCTION_NOARGS();
-    static Ptr<ChannelListPriv> ptr = nullptr;
+    static Ptr<ChannelListPriv> globalPtr = nullptr;
+    static thread_local Ptr<ChannelListPriv> localPtr = nullptr;
+    Ptr<ChannelListPriv>& ptr = SimulatorContext::Select(globalPtr, localPtr);
     if (!ptr)
     {
         ptr = CreateObject<ChannelListPriv>();
@@ -26,6 +26,7 @@
 #include "ns3/config.h"
 #include "ns3/log.h"
 #include "ns3/object-vector.h"
+#include "ns3/simulator-context.h"
 #include "ns3/simulator.h"
 
 namespace ns3
@@ -133,7 +134,9 @@ Ptr<NodeListPriv>*
 NodeListPriv::DoGet()
 {
     NS_LOG_FUNCTION_NOARGS();
-    static Ptr<NodeListPriv> ptr = nullptr;
+    static Ptr<NodeListPriv> globalPtr = nullptr;
+    static thread_local Ptr<NodeListPriv> localPtr = nullptr;
+    Ptr<NodeListPriv>& ptr = SimulatorContext::Select(globalPtr, localPtr);
     if (!ptr)
     {
         ptr = CreateObject<NodeListPriv>();
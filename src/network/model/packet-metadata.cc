@@ -25,6 +25,7 @@
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
+#include "ns3/simulator-context.h"
 
 #include <list>
 #include <utility>
@@ -80,8 +81,7 @@ PacketMetadata::ReserveCopy(uint32_t size)
     PacketMetadata::Data* newData = PacketMetadata::Create(m_used + size);
     memcpy(newData->m_data, m_data->m_data, m_used);
     newData->m_dirtyEnd = m_used;
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (SimpleRefCountMode::Decrement(m_data->m_count) == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
@@ -104,8 +104,10 @@ PacketMetadata::Reserve(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
     NS_ASSERT(m_data != nullptr);
+    // in parallel, the other metadata may add their items at the same time
     if (m_data->m_size >= m_used + size &&
-        (m_head == 0xffff || m_data->m_count == 1 || m_data->m_dirtyEnd == m_used))
+        (m_data->m_count == 1 ||
+         (!SimulatorContext::IsParallel() && (m_head == 0xffff || m_data->m_dirtyEnd == m_used))))
     {
         /* enough room, not dirty. */
     }
@@ -385,7 +387,8 @@ PacketMetadata::AddSmall(const PacketMetadata::SmallItem* item)
     uint32_t sizeSize = GetUleb128Size(item->size);
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2;
     if (m_used + n > m_data->m_size ||
-        (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+        (m_data->m_count != 1 && (SimulatorContext::IsParallel() ||
+                                  (m_head != 0xffff && m_used != m_data->m_dirtyEnd))))
     {
         ReserveCopy(n);
     }
@@ -422,7 +425,8 @@ PacketMetadata::AddBig(uint32_t next,
     uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2 + fragStartSize + fragEndSize + 4;
 
     if (m_used + n > m_data->m_size ||
-        (m_head != 0xffff && m_data->m_count != 1 && m_used != m_data->m_dirtyEnd))
+        (m_data->m_count != 1 && (SimulatorContext::IsParallel() ||
+                                  (m_head != 0xffff && m_used != m_data->m_dirtyEnd))))
     {
         ReserveCopy(n);
     }
@@ -572,14 +576,15 @@ PacketMetadata::Create(uint32_t size)
     {
         m_maxSize = size;
     }
-    while (!m_freeList.empty())
+    // the free list would be shared by the simulation threads
+    while (!SimulatorContext::IsMultithreaded() && !m_freeList.empty())
     {
         PacketMetadata::Data* data = m_freeList.back();
         m_freeList.pop_back();
         if (data->m_size >= size)
         {
             NS_LOG_LOGIC("create found size=" << data->m_size);
-            data->m_count = 1;
+            data->m_count.store(1, std::memory_order_relaxed);
             return data;
         }
         NS_LOG_LOGIC("create dealloc size=" << data->m_size);
@@ -593,7 +598,7 @@ void
 PacketMetadata::Recycle(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    if (!m_enable)
+    if (!m_enable || SimulatorContext::IsMultithreaded())
     {
         PacketMetadata::Deallocate(data);
         return;
@@ -623,7 +628,7 @@ PacketMetadata::Allocate(uint32_t n)
     auto buf = new uint8_t[size];
     auto data = (PacketMetadata::Data*)buf;
     data->m_size = n;
-    data->m_count = 1;
+    data->m_count.store(1, std::memory_order_relaxed);
     data->m_dirtyEnd = 0;
     return data;
 }
@@ -23,8 +23,10 @@
 
 #include "ns3/assert.h"
 #include "ns3/callback.h"
+#include "ns3/simple-ref-count.h"
 #include "ns3/type-id.h"
 
+#include <atomic>
 #include <limits>
 #include <stdint.h>
 #include <vector>
@@ -425,8 +427,8 @@ class PacketMetadata
      */
     struct Data
     {
-        /** number of references to this struct Data instance. */
-        uint32_t m_count;
+        /** number of references to this struct Data instance, updated with SimpleRefCountMode. */
+        std::atomic<uint32_t> m_count;
         /** size (in bytes) of m_data buffer below */
         uint16_t m_size;
         /** max of the m_used field over all objects which reference this struct Data instance */
@@ -729,7 +731,7 @@ PacketMetadata::PacketMetadata(const PacketMetadata& o)
 {
     NS_ASSERT(m_data != nullptr);
     NS_ASSERT(m_data->m_count < std::numeric_limits<uint32_t>::max());
-    m_data->m_count++;
+    SimpleRefCountMode::Increment(m_data->m_count);
 }
 
 PacketMetadata&
@@ -739,14 +741,13 @@ PacketMetadata::operator=(const PacketMetadata& o)
     {
         // not self assignment
         NS_ASSERT(m_data != nullptr);
-        m_data->m_count--;
-        if (m_data->m_count == 0)
+        if (SimpleRefCountMode::Decrement(m_data->m_count) == 0)
         {
             PacketMetadata::Recycle(m_data);
         }
         m_data = o.m_data;
         NS_ASSERT(m_data != nullptr);
-        m_data->m_count++;
+        SimpleRefCountMode::Increment(m_data->m_count);
     }
     m_head = o.m_head;
     m_tail = o.m_tail;
@@ -758,8 +759,7 @@ PacketMetadata::operator=(const PacketMetadata& o)
 PacketMetadata::~PacketMetadata()
 {
     NS_ASSERT(m_data != nullptr);
-    m_data->m_count--;
-    if (m_data->m_count == 0)
+    if (SimpleRefCountMode::Decrement(m_data->m_count) == 0)
     {
         PacketMetadata::Recycle(m_data);
     }
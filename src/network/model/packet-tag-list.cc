@@ -29,6 +29,7 @@
 
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
+#include "ns3/simulator-context.h"
 
 #include <cstring>
 
@@ -119,9 +120,10 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
         return found;
     }
 
-    // At this point cur is a merge, but untested for tid
+    // At this point cur is a merge, but untested for tid.  In parallel, the
+    // other lists may release it meanwhile, so it may be ours only.
     NS_ASSERT(cur != nullptr);
-    NS_ASSERT(cur->count > 1);
+    NS_ASSERT(cur->count > 1 || SimulatorContext::IsParallel());
 
     /*
        Walk the remainder of the list, copying, until we find tid
@@ -142,6 +144,10 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
                                                   pNext   cur
 
        When we reach tid, we link past it, decrement count, and we're done.
+
+       The count of T1 is decremented after the copy is linked, so that T1
+       and its tail stay valid while they are copied: if the other lists
+       released T1 meanwhile, T1 is freed, and T2 is not a merge anymore.
     */
 
     // Should normally check for null cur pointer,
@@ -149,23 +155,24 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
     while (/* cur && */ cur->tid != tid)
     {
         NS_ASSERT(cur != nullptr);
-        NS_ASSERT(cur->count > 1);
-        cur->count--; // unmerge cur
+        NS_ASSERT(cur->count > 1 || SimulatorContext::IsParallel());
         TagData* copy = CreateTagData(cur->size);
         copy->tid = cur->tid;
-        copy->count = 1;
+        copy->count.store(1, std::memory_order_relaxed);
         copy->size = cur->size;
         memcpy(copy->data, cur->data, copy->size);
-        copy->next = cur->next; // merge into tail
-        copy->next->count++;    // mark new merge
-        *prevNext = copy;       // point prior list at copy
-        prevNext = &copy->next; // advance
+        copy->next = cur->next;                          // merge into tail
+        SimpleRefCountMode::Increment(copy->next->count); // mark new merge
+        *prevNext = copy;                                // point prior list at copy
+        prevNext = &copy->next;                          // advance
+        Release(cur);                                    // unmerge cur
         cur = copy->next;
     }
     // Sanity check:
     NS_ASSERT(cur != nullptr);  // cur should be non-zero
     NS_ASSERT(cur->tid == tid); // cur->tid should be tid
-    NS_ASSERT(cur->count > 1);  // cur should be a merge
+    // cur should be a merge
+    NS_ASSERT(cur->count > 1 || SimulatorContext::IsParallel());
 
     // link around tid, removing it from our list
     found = (this->*Writer)(tag, false, cur, prevNext);
@@ -201,13 +208,13 @@ PacketTagList::RemoveWriter(Tag& tag,
     else
     {
         // cur is always a merge at this point
-        // unmerge cur, since we linked around it already
-        cur->count--;
         if (cur->next != nullptr)
         {
             // there's a next, so make it a merge
-            cur->next->count++;
+            SimpleRefCountMode::Increment(cur->next->count);
         }
+        // unmerge cur, since we linked around it already
+        Release(cur);
     }
     return found;
 }
@@ -243,17 +250,17 @@ PacketTagList::ReplaceWriter(Tag& tag,
     {
         // cur is always a merge at this point
         // need to copy, replace, and link past cur
-        cur->count--; // unmerge cur
         TagData* copy = CreateTagData(tag.GetSerializedSize());
         copy->tid = tag.GetInstanceTypeId();
-        copy->count = 1;
+        copy->count.store(1, std::memory_order_relaxed);
         tag.Serialize(TagBuffer(copy->data, copy->data + copy->size));
         copy->next = cur->next; // merge into tail
         if (copy->next != nullptr)
         {
-            copy->next->count++; // mark new merge
+            SimpleRefCountMode::Increment(copy->next->count); // mark new merge
         }
         *prevNext = copy; // point prior list at copy
+        Release(cur);     // unmerge cur
     }
     return found;
 }
@@ -269,7 +276,7 @@ PacketTagList::Add(const Tag& tag) const
                       "Error: cannot add the same kind of tag twice.");
     }
     TagData* head = CreateTagData(tag.GetSerializedSize());
-    head->count = 1;
+    head->count.store(1, std::memory_order_relaxed);
     head->next = nullptr;
     head->tid = tag.GetInstanceTypeId();
     head->next = m_next;
@@ -428,7 +435,7 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
         NS_LOG_INFO("Deserializing tag of type " << tid);
 
         TagData* newTag = CreateTagData(tagSize);
-        newTag->count = 1;
+        newTag->count.store(1, std::memory_order_relaxed);
         newTag->next = nullptr;
         newTag->tid = tid;
 
@@ -24,8 +24,10 @@
 \brief  Defines a linked list of Packet tags, including copy-on-write semantics.
 */
 
+#include "ns3/simple-ref-count.h"
 #include "ns3/type-id.h"
 
+#include <atomic>
 #include <ostream>
 #include <stdint.h>
 
@@ -141,11 +143,11 @@ class PacketTagList
      */
     struct TagData
     {
-        TagData* next;   //!< Pointer to next in list
-        uint32_t count;  //!< Number of incoming links
-        TypeId tid;      //!< Type of the tag serialized into #data
-        uint32_t size;   //!< Size of the \c data buffer
-        uint8_t data[1]; //!< Serialization buffer
+        TagData* next;               //!< Pointer to next in list
+        std::atomic<uint32_t> count; //!< Number of incoming links, see SimpleRefCountMode
+        TypeId tid;                  //!< Type of the tag serialized into #data
+        uint32_t size;               //!< Size of the \c data buffer
+        uint8_t data[1];             //!< Serialization buffer
     };
 
     /**
@@ -252,6 +254,13 @@ class PacketTagList
      * \returns The newly constructed TagData object.
      */
     static TagData* CreateTagData(size_t dataSize);
+    /**
+     * Remove an incoming link of a TagData struct, and free it and the
+     * following ones which are not linked anymore.
+     *
+     * \param [in] head The TagData struct.
+     */
+    static inline void Release(TagData* head);
 
     /**
      * Typedef of method function pointer for copy-on-write operations
@@ -326,7 +335,7 @@ PacketTagList::PacketTagList(const PacketTagList& o)
 {
     if (m_next != nullptr)
     {
-        m_next->count++;
+        SimpleRefCountMode::Increment(m_next->count);
     }
 }
 
@@ -342,7 +351,7 @@ PacketTagList::operator=(const PacketTagList& o)
     m_next = o.m_next;
     if (m_next != nullptr)
     {
-        m_next->count++;
+        SimpleRefCountMode::Increment(m_next->count);
     }
     return *this;
 }
@@ -354,12 +363,18 @@ PacketTagList::~PacketTagList()
 
 void
 PacketTagList::RemoveAll()
+{
+    Release(m_next);
+    m_next = nullptr;
+}
+
+void
+PacketTagList::Release(TagData* head)
 {
     TagData* prev = nullptr;
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    for (TagData* cur = head; cur != nullptr; cur = cur->next)
     {
-        cur->count--;
-        if (cur->count > 0)
+        if (SimpleRefCountMode::Decrement(cur->count) > 0)
         {
             break;
         }
@@ -375,7 +390,6 @@ PacketTagList::RemoveAll()
         prev->~TagData();
         std::free(prev);
     }
-    m_next = nullptr;
 }
 
 } // namespace ns3
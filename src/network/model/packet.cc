@@ -20,6 +20,7 @@
 
 #include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/simulator-context.h"
 #include "ns3/simulator.h"
 
 #include <cstdarg>
@@ -136,20 +137,41 @@ Packet::Copy() const
     return Ptr<Packet>(new Packet(*this), false);
 }
 
+uint64_t
+Packet::AllocateUid()
+{
+    uint32_t partition = SimulatorContext::GetPartition();
+    if (SimulatorContext::IsParallel() && partition != SimulatorContext::NO_PARTITION)
+    {
+        // each partition numbers its own packets, with a counter on its own cache line
+        struct alignas(64) Counter
+        {
+            uint32_t uid{0}; //!< Next uid
+        };
+
+        static Counter partitionUids[SimulatorContext::MAX_PARTITIONS];
+        NS_ASSERT(partition < SimulatorContext::MAX_PARTITIONS);
+        return static_cast<uint64_t>(0x80000000 | partition) << 32 |
+               partitionUids[partition].uid++;
+    }
+    static thread_local uint32_t localUid = 0;
+    /* The upper 32 bits of the packet id in
+     * metadata is for the system id. For non-
+     * distributed simulations, this is simply
+     * zero.  The lower 32 bits are for the
+     * global UID
+     */
+    return static_cast<uint64_t>(Simulator::GetSystemId()) << 32 |
+           SimulatorContext::Select(m_globalUid, localUid)++;
+}
+
 Packet::Packet()
     : m_buffer(),
       m_byteTagList(),
       m_packetTagList(),
-      /* The upper 32 bits of the packet id in
-       * metadata is for the system id. For non-
-       * distributed simulations, this is simply
-       * zero.  The lower 32 bits are for the
-       * global UID
-       */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, 0),
+      m_metadata(AllocateUid(), 0),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const Packet& o)
@@ -186,10 +208,9 @@ Packet::Packet(uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(AllocateUid(), size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
 }
 
 Packet::Packet(const uint8_t* buffer, uint32_t size, bool magic)
@@ -213,10 +234,9 @@ Packet::Packet(const uint8_t* buffer, uint32_t size)
        * zero.  The lower 32 bits are for the
        * global UID
        */
-      m_metadata(static_cast<uint64_t>(Simulator::GetSystemId()) << 32 | m_globalUid, size),
+      m_metadata(AllocateUid(), size),
       m_nixVector(nullptr)
 {
-    m_globalUid++;
     m_buffer.AddAtStart(size);
     Buffer::Iterator i = m_buffer.Begin();
     i.Write(buffer, size);
@@ -795,6 +795,15 @@ class Packet : public SimpleRefCount<Packet>
     /* Please see comments above about nix-vector */
     mutable Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
+    /**
+     * \return A new packet Uid: the system id in the upper 32 bits, and the
+     *         global counter, or the counter of the calling thread in the
+     *         thread-local mode of SimulatorContext, in the lower ones. In the
+     *         parallel mode, the partitions have their own counters, and the
+     *         upper bits hold the partition with the highest bit set.
+     */
+    static uint64_t AllocateUid();
+
     static uint32_t m_globalUid; //!< Global counter of packets Uid
 };
 
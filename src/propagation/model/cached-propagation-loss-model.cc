@@ -0,0 +1,196 @@
+#include "cached-propagation-loss-model.h"
+
+#include "ns3/log.h"
+#include "ns3/mobility-model.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator-context.h"
+
+/**
+ * \file
+ * \ingroup propagation
+ * ns3::CachedPropagationLossModel implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("CachedPropagationLossModel");
+
+NS_OBJECT_ENSURE_REGISTERED(CachedPropagationLossModel);
+
+TypeId
+CachedPropagationLossModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::CachedPropagationLossModel")
+            .SetParent<PropagationLossModel>()
+            .SetGroupName("Propagation")
+            .AddConstructor<CachedPropagationLossModel>()
+            .AddAttribute("Model",
+                          "The deterministic loss model whose received powers are memoized.",
+                          PointerValue(),
+                          MakePointerAccessor(&CachedPropagationLossModel::SetModel,
+                                              &CachedPropagationLossModel::GetModel),
+                          MakePointerChecker<PropagationLossModel>());
+    return tid;
+}
+
+CachedPropagationLossModel::CachedPropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+CachedPropagationLossModel::~CachedPropagationLossModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+CachedPropagationLossModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& [key, epoch] : m_epochs)
+    {
+        epoch.mobility->TraceDisconnectWithoutContext("CourseChange", epoch.courseChange);
+    }
+    m_epochs.clear();
+    m_cache.clear();
+    m_model = nullptr;
+    PropagationLossModel::DoDispose();
+}
+
+void
+CachedPropagationLossModel::SetModel(Ptr<PropagationLossModel> model)
+{
+    NS_LOG_FUNCTION(this << model);
+    m_model = model;
+    Flush();
+}
+
+Ptr<PropagationLossModel>
+CachedPropagationLossModel::GetModel() const
+{
+    return m_model;
+}
+
+void
+CachedPropagationLossModel::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+    if (SimulatorContext::IsParallel())
+    {
+        lock.lock();
+    }
+    m_cache.clear();
+}
+
+std::size_t
+CachedPropagationLossModel::PathHash::operator()(const Path& path) const
+{
+    std::size_t hash = std::hash<const MobilityModel*>{}(path.a);
+    hash = hash * 31 + std::hash<const MobilityModel*>{}(path.b);
+    hash = hash * 31 + std::hash<double>{}(path.txPowerDbm);
+    return hash;
+}
+
+CachedPropagationLossModel::Epoch&
+CachedPropagationLossModel::GetEpoch(Ptr<MobilityModel> mobility) const
+{
+    auto [it, inserted] = m_epochs.emplace(PeekPointer(mobility), Epoch());
+    Epoch& epoch = it->second;
+    if (inserted)
+    {
+        // the course changes are followed by a const method, hence the cast
+        auto self = const_cast<CachedPropagationLossModel*>(this);
+        epoch.mobility = mobility;
+        epoch.courseChange = MakeCallback(&CachedPropagationLossModel::CourseChanged, self);
+        epoch.epoch = 0;
+        Vector velocity = mobility->GetVelocity();
+        epoch.moving = velocity.x != 0 || velocity.y != 0 || velocity.z != 0;
+        mobility->TraceConnectWithoutContext("CourseChange", epoch.courseChange);
+    }
+    return epoch;
+}
+
+void
+CachedPropagationLossModel::CourseChanged(Ptr<const MobilityModel> mobility)
+{
+    NS_LOG_FUNCTION(this << mobility);
+    std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+    if (SimulatorContext::IsParallel())
+    {
+        lock.lock();
+    }
+    Epoch& epoch = m_epochs[PeekPointer(mobility)];
+    epoch.epoch++;
+    Vector velocity = mobility->GetVelocity();
+    epoch.moving = velocity.x != 0 || velocity.y != 0 || velocity.z != 0;
+}
+
+double
+CachedPropagationLossModel::DoCalcRxPower(double txPowerDbm,
+                                          Ptr<MobilityModel> a,
+                                          Ptr<MobilityModel> b) const
+{
+    NS_LOG_FUNCTION(this << txPowerDbm << a << b);
+    if (!m_model)
+    {
+        return txPowerDbm;
+    }
+    if (!a || !b)
+    {
+        return m_model->CalcRxPower(txPowerDbm, a, b);
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+    if (SimulatorContext::IsParallel())
+    {
+        lock.lock();
+    }
+    const Epoch& epochA = GetEpoch(a);
+    const Epoch& epochB = GetEpoch(b);
+    bool moving = epochA.moving || epochB.moving;
+    uint64_t currentA = epochA.epoch;
+    uint64_t currentB = epochB.epoch;
+    Path path{PeekPointer(a), PeekPointer(b), txPowerDbm};
+    if (!moving)
+    {
+        auto it = m_cache.find(path);
+        if (it != m_cache.end() && it->second.epochA == currentA &&
+            it->second.epochB == currentB)
+        {
+            NS_LOG_DEBUG("memoized rx power " << it->second.rxPowerDbm << " dBm");
+            return it->second.rxPowerDbm;
+        }
+    }
+
+    // the memoized model may be slow, and is not run under the lock
+    if (lock.owns_lock())
+    {
+        lock.unlock();
+    }
+    double rxPowerDbm = m_model->CalcRxPower(txPowerDbm, a, b);
+    if (!moving)
+    {
+        if (SimulatorContext::IsParallel())
+        {
+            lock.lock();
+        }
+        m_cache[path] = {rxPowerDbm, currentA, currentB};
+    }
+    return rxPowerDbm;
+}
+
+int64_t
+CachedPropagationLossModel::DoAssignStreams(int64_t stream)
+{
+    NS_LOG_FUNCTION(this << stream);
+    if (!m_model)
+    {
+        return 0;
+    }
+    return m_model->AssignStreams(stream);
+}
+
+} // namespace ns3
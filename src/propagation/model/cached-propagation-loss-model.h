@@ -0,0 +1,157 @@
+#ifndef CACHED_PROPAGATION_LOSS_MODEL_H
+#define CACHED_PROPAGATION_LOSS_MODEL_H
+
+#include "propagation-loss-model.h"
+
+#include "ns3/callback.h"
+
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * \file
+ * \ingroup propagation
+ * ns3::CachedPropagationLossModel declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * \ingroup propagation
+ *
+ * \brief Memoize the received power computed by a deterministic loss model.
+ *
+ * The model given by the Model attribute, with the models chained to it,
+ * computes the received power of a transmission once for each transmitter,
+ * receiver and transmission power, and this model returns the same power
+ * until one of the nodes has a course change. In scenarios where the nodes
+ * do not move, the loss of a transmission becomes a table lookup.
+ *
+ * The memoized models must be deterministic: the stochastic models, such as
+ * NakagamiPropagationLossModel, are chained to this model with SetNext(),
+ * and draw their random numbers at each transmission as usual:
+ *
+ * \code
+ *   Ptr<CachedPropagationLossModel> cached = CreateObject<CachedPropagationLossModel>();
+ *   cached->SetModel(CreateObject<LogDistancePropagationLossModel>());
+ *   cached->SetNext(CreateObject<NakagamiPropagationLossModel>());
+ * \endcode
+ *
+ * The losses between nodes which move, those with a non-zero velocity at
+ * their last course change, are not memoized. A mobility model which moves
+ * without velocity nor course change, such as a
+ * ConstantAccelerationMobilityModel starting at rest, must not be used.
+ *
+ * Each instance has its own cache, so the losses of the channels which use
+ * different instances, for instance at different frequencies, are kept
+ * apart.
+ */
+class CachedPropagationLossModel : public PropagationLossModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    CachedPropagationLossModel();
+    ~CachedPropagationLossModel() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    CachedPropagationLossModel(const CachedPropagationLossModel&) = delete;
+    CachedPropagationLossModel& operator=(const CachedPropagationLossModel&) = delete;
+
+    /**
+     * \param model the deterministic loss model to memoize, with the models
+     *        chained to it
+     */
+    void SetModel(Ptr<PropagationLossModel> model);
+    /**
+     * \return the memoized loss model
+     */
+    Ptr<PropagationLossModel> GetModel() const;
+    /**
+     * Forget the memoized received powers, for instance after a change of
+     * the attributes of the memoized model.
+     */
+    void Flush();
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    double DoCalcRxPower(double txPowerDbm,
+                         Ptr<MobilityModel> a,
+                         Ptr<MobilityModel> b) const override;
+
+    int64_t DoAssignStreams(int64_t stream) override;
+
+    /** The course changes of a mobility model. */
+    struct Epoch
+    {
+        Ptr<MobilityModel> mobility;                           //!< The mobility model
+        Callback<void, Ptr<const MobilityModel>> courseChange; //!< The course change callback
+        uint64_t epoch;                                        //!< Number of course changes
+        bool moving;                                           //!< Whether the model moves
+    };
+
+    /** The path of a transmission. */
+    struct Path
+    {
+        const MobilityModel* a; //!< The transmitter
+        const MobilityModel* b; //!< The receiver
+        double txPowerDbm;      //!< The transmission power
+
+        /**
+         * \param other another path
+         * \return true if the paths are the same
+         */
+        bool operator==(const Path& other) const
+        {
+            return a == other.a && b == other.b && txPowerDbm == other.txPowerDbm;
+        }
+    };
+
+    /** Hash of a path. */
+    struct PathHash
+    {
+        /**
+         * \param path a path
+         * \return the hash of the path
+         */
+        std::size_t operator()(const Path& path) const;
+    };
+
+    /** A memoized received power. */
+    struct Entry
+    {
+        double rxPowerDbm; //!< The received power
+        uint64_t epochA;   //!< Epoch of the transmitter at the computation
+        uint64_t epochB;   //!< Epoch of the receiver at the computation
+    };
+
+    /**
+     * Get the epoch of a mobility model, and follow its course changes from
+     * the first call.
+     * \param mobility the mobility model
+     * \return the epoch
+     */
+    Epoch& GetEpoch(Ptr<MobilityModel> mobility) const;
+    /**
+     * Start a new epoch of a mobility model.
+     * \param mobility the mobility model
+     */
+    void CourseChanged(Ptr<const MobilityModel> mobility);
+
+    Ptr<PropagationLossModel> m_model; //!< The memoized model
+    /// Epochs of the nodes, by mobility model
+    mutable std::unordered_map<const MobilityModel*, Epoch> m_epochs;
+    mutable std::unordered_map<Path, Entry, PathHash> m_cache; //!< Memoized received powers
+    /// Protect the cache against the transmissions of parallel simulations
+    mutable std::mutex m_mutex;
+};
+
+} // namespace ns3
+
+#endif /* CACHED_PROPAGATION_LOSS_MODEL_H */
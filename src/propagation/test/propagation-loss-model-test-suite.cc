@@ -16,8 +16,10 @@
  */
 
 #include "ns3/abort.h"
+#include "ns3/cached-propagation-loss-model.h"
 #include "ns3/config.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/constant-velocity-mobility-model.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/propagation-loss-model.h"
@@ -489,6 +491,113 @@ RangePropagationLossModelTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief CachedPropagationLossModel Test
+ */
+class CachedPropagationLossModelTestCase : public TestCase
+{
+  public:
+    CachedPropagationLossModelTestCase();
+    ~CachedPropagationLossModelTestCase() override;
+
+  private:
+    void DoRun() override;
+};
+
+CachedPropagationLossModelTestCase::CachedPropagationLossModelTestCase()
+    : TestCase("Test CachedPropagationLossModel")
+{
+}
+
+CachedPropagationLossModelTestCase::~CachedPropagationLossModelTestCase()
+{
+}
+
+void
+CachedPropagationLossModelTestCase::DoRun()
+{
+    Ptr<MobilityModel> a = CreateObject<ConstantPositionMobilityModel>();
+    a->SetPosition(Vector(0, 0, 0));
+    Ptr<MobilityModel> b = CreateObject<ConstantPositionMobilityModel>();
+    b->SetPosition(Vector(100, 0, 0));
+    Ptr<ConstantVelocityMobilityModel> c = CreateObject<ConstantVelocityMobilityModel>();
+    c->SetPosition(Vector(0, 50, 0));
+    c->SetVelocity(Vector(10, 0, 0));
+
+    Ptr<LogDistancePropagationLossModel> model = CreateObject<LogDistancePropagationLossModel>();
+    Ptr<LogDistancePropagationLossModel> reference =
+        CreateObject<LogDistancePropagationLossModel>();
+    Ptr<CachedPropagationLossModel> cached = CreateObject<CachedPropagationLossModel>();
+    cached->SetModel(model);
+    // the models chained to the cached model are not memoized
+    cached->SetNext(CreateObject<FixedRssLossModel>());
+    cached->GetNext()->SetAttribute("Rss", DoubleValue(-90));
+
+    double tolerance = 1e-9;
+    NS_TEST_EXPECT_MSG_EQ_TOL(cached->CalcRxPower(20, a, b),
+                              -90,
+                              tolerance,
+                              "The chained model was not applied");
+    cached->SetNext(nullptr);
+    NS_TEST_EXPECT_MSG_EQ_TOL(cached->CalcRxPower(20, a, b),
+                              reference->CalcRxPower(20, a, b),
+                              tolerance,
+                              "Wrong rx power");
+    NS_TEST_EXPECT_MSG_EQ_TOL(cached->CalcRxPower(10, a, b),
+                              reference->CalcRxPower(10, a, b),
+                              tolerance,
+                              "Wrong rx power at another tx power");
+    NS_TEST_EXPECT_MSG_EQ_TOL(cached->CalcRxPower(20, b, a),
+                              reference->CalcRxPower(20, b, a),
+                              tolerance,
+                              "Wrong rx power in the other direction");
+
+    // the memoized rx power is used until a course change or a flush
+    double memoized = cached->CalcRxPower(20, a, b);
+    model->SetAttribute("Exponent", DoubleValue(2));
+    NS_TEST_EXPECT_MSG_EQ_TOL(cached->CalcRxPower(20, a, b),
+                              memoized,
+                              tolerance,
+                              "The rx power was not memoized");
+    cached->Flush();
+    reference->SetAttribute("Exponent", DoubleValue(2));
+    NS_TEST_EXPECT_MSG_EQ_TOL(cached->CalcRxPower(20, a, b),
+                              reference->CalcRxPower(20, a, b),
+                              tolerance,
+                              "The rx power was not flushed");
+    b->SetPosition(Vector(200, 0, 0));
+    NS_TEST_EXPECT_MSG_EQ_TOL(cached->CalcRxPower(20, a, b),
+                              reference->CalcRxPower(20, a, b),
+                              tolerance,
+                              "The rx power was not updated at the course change");
+
+    // the rx power of the nodes which move is not memoized
+    double start = cached->CalcRxPower(20, a, c);
+    NS_TEST_EXPECT_MSG_EQ_TOL(start,
+                              reference->CalcRxPower(20, a, c),
+                              tolerance,
+                              "Wrong rx power of a moving node");
+    Simulator::Stop(Seconds(10));
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ_TOL(cached->CalcRxPower(20, a, c),
+                              reference->CalcRxPower(20, a, c),
+                              tolerance,
+                              "Wrong rx power after a move");
+    NS_TEST_EXPECT_MSG_NE(cached->CalcRxPower(20, a, c), start, "The node did not move");
+
+    // once the node stops, its rx power is memoized at its new position
+    c->SetVelocity(Vector(0, 0, 0));
+    NS_TEST_EXPECT_MSG_EQ_TOL(cached->CalcRxPower(20, c, b),
+                              reference->CalcRxPower(20, c, b),
+                              tolerance,
+                              "Wrong rx power of a stopped node");
+
+    cached->Dispose();
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup propagation-tests
  *
@@ -500,6 +609,7 @@ RangePropagationLossModelTestCase::DoRun()
  *   - LogDistancePropagationLossModel
  *   - MatrixPropagationLossModel
  *   - RangePropagationLossModel
+ *   - CachedPropagationLossModel
  */
 class PropagationLossModelsTestSuite : public TestSuite
 {
@@ -515,6 +625,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite()
     AddTestCase(new LogDistancePropagationLossModelTestCase, TestCase::QUICK);
     AddTestCase(new MatrixPropagationLossModelTestCase, TestCase::QUICK);
     AddTestCase(new RangePropagationLossModelTestCase, TestCase::QUICK);
+    AddTestCase(new CachedPropagationLossModelTestCase, TestCase::QUICK);
 }
 
 /// Static variable for test initialization
@@ -37,6 +37,7 @@
 #include <ns3/propagation-delay-model.h>
 #include <ns3/propagation-loss-model.h>
 #include <ns3/simulator.h>
+#include <ns3/spatial-grid-index.h>
 
 #include <algorithm>
 #include <iostream>
@@ -81,7 +82,13 @@ RxSpectrumModelInfo::RxSpectrumModelInfo(Ptr<const SpectrumModel> rxSpectrumMode
 }
 
 MultiModelSpectrumChannel::MultiModelSpectrumChannel()
-    : m_numDevices{0}
+    : m_numDevices{0},
+      m_maxRange{0}
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MultiModelSpectrumChannel::~MultiModelSpectrumChannel()
 {
     NS_LOG_FUNCTION(this);
 }
@@ -92,18 +99,26 @@ MultiModelSpectrumChannel::DoDispose()
     NS_LOG_FUNCTION(this);
     m_txSpectrumModelInfoMap.clear();
     m_rxSpectrumModelInfoMap.clear();
+    m_index.reset();
     SpectrumChannel::DoDispose();
 }
 
 TypeId
 MultiModelSpectrumChannel::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::MultiModelSpectrumChannel")
-                            .SetParent<SpectrumChannel>()
-                            .SetGroupName("Spectrum")
-                            .AddConstructor<MultiModelSpectrumChannel>()
-
-        ;
+    static TypeId tid =
+        TypeId("ns3::MultiModelSpectrumChannel")
+            .SetParent<SpectrumChannel>()
+            .SetGroupName("Spectrum")
+            .AddConstructor<MultiModelSpectrumChannel>()
+            .AddAttribute("MaxRange",
+                          "The distance in meters beyond which the receivers do not receive "
+                          "the transmissions, or 0 for no limit. The receivers in range are "
+                          "found with a spatial index of their positions, and the propagation "
+                          "loss of the other receivers is not computed.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&MultiModelSpectrumChannel::m_maxRange),
+                          MakeDoubleChecker<double>(0));
     return tid;
 }
 
@@ -127,6 +142,7 @@ MultiModelSpectrumChannel::RemoveRx(Ptr<SpectrumPhy> phy)
         {
             rxInfoIterator->second.m_rxPhys.erase(phyIt);
             --m_numDevices;
+            m_index.reset();
             break; // there should be at most one entry
         }
     }
@@ -148,6 +164,7 @@ MultiModelSpectrumChannel::AddRx(Ptr<SpectrumPhy> phy)
     RemoveRx(phy);
 
     ++m_numDevices;
+    m_index.reset();
 
     auto [rxInfoIterator, inserted] =
         m_rxSpectrumModelInfoMap.emplace(rxSpectrumModelUid, RxSpectrumModelInfo(rxSpectrumModel));
@@ -252,10 +269,22 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
     NS_LOG_LOGIC("converter map first element: "
                  << txInfoIteratorerator->second.m_spectrumConverterMap.begin()->first);
 
+    // with a MaxRange, find the receivers which may be in range with the spatial
+    // index, where the receivers are numbered in the order of this loop
+    bool culling = m_maxRange > 0 && txMobility;
+    std::vector<uint32_t> near;
+    if (culling)
+    {
+        FindReceivers(txMobility->GetPosition(), near);
+    }
+    uint32_t offset = 0;
+
     for (auto rxInfoIterator = m_rxSpectrumModelInfoMap.begin();
          rxInfoIterator != m_rxSpectrumModelInfoMap.end();
          ++rxInfoIterator)
     {
+        uint32_t first = offset;
+        offset += rxInfoIterator->second.m_rxPhys.size();
         SpectrumModelUid_t rxSpectrumModelUid = rxInfoIterator->second.m_rxSpectrumModel->GetUid();
         NS_LOG_LOGIC("rxSpectrumModelUids " << rxSpectrumModelUid);
 
@@ -279,17 +308,21 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
             convertedTxPowerSpectrum = rxConverterIterator->second.Convert(txParams->psd);
         }
 
-        for (auto rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin();
-             rxPhyIterator != rxInfoIterator->second.m_rxPhys.end();
-             ++rxPhyIterator)
+        // the receivers of this model, all of them or those which may be in range
+        const auto& rxPhys = rxInfoIterator->second.m_rxPhys;
+        auto nearBegin = std::lower_bound(near.begin(), near.end(), first);
+        auto nearEnd = std::lower_bound(nearBegin, near.end(), first + rxPhys.size());
+        std::size_t n = culling ? nearEnd - nearBegin : rxPhys.size();
+        for (std::size_t k = 0; k < n; ++k)
         {
-            NS_ASSERT_MSG((*rxPhyIterator)->GetRxSpectrumModel()->GetUid() == rxSpectrumModelUid,
+            const Ptr<SpectrumPhy>& rxPhy = rxPhys[culling ? *(nearBegin + k) - first : k];
+            NS_ASSERT_MSG(rxPhy->GetRxSpectrumModel()->GetUid() == rxSpectrumModelUid,
                           "SpectrumModel change was not notified to MultiModelSpectrumChannel "
                           "(i.e., AddRx should be called again after model is changed)");
 
-            if ((*rxPhyIterator) != txParams->txPhy)
+            if (rxPhy != txParams->txPhy)
             {
-                Ptr<NetDevice> rxNetDevice = (*rxPhyIterator)->GetDevice();
+                Ptr<NetDevice> rxNetDevice = rxPhy->GetDevice();
                 Ptr<NetDevice> txNetDevice = txParams->txPhy->GetDevice();
 
                 if (rxNetDevice && txNetDevice)
@@ -304,8 +337,15 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                     }
                 }
 
-                if (m_filter && m_filter->Filter(txParams, *rxPhyIterator))
+                if (m_filter && m_filter->Filter(txParams, rxPhy))
+                {
+                    continue;
+                }
+
+                if (culling && rxPhy->GetMobility() &&
+                    txMobility->GetDistanceFrom(rxPhy->GetMobility()) > m_maxRange)
                 {
+                    NS_LOG_LOGIC("receiver beyond MaxRange");
                     continue;
                 }
 
@@ -314,7 +354,7 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                 rxParams->psd = Copy<SpectrumValue>(convertedTxPowerSpectrum);
                 Time delay = MicroSeconds(0);
 
-                Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility();
+                Ptr<MobilityModel> receiverMobility = rxPhy->GetMobility();
 
                 if (txMobility && receiverMobility)
                 {
@@ -329,8 +369,7 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                         NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
                         pathLossDb -= txAntennaGain;
                     }
-                    Ptr<AntennaModel> rxAntenna =
-                        DynamicCast<AntennaModel>((*rxPhyIterator)->GetAntenna());
+                    Ptr<AntennaModel> rxAntenna = DynamicCast<AntennaModel>(rxPhy->GetAntenna());
                     if (rxAntenna)
                     {
                         Angles rxAngles(txMobility->GetPosition(), receiverMobility->GetPosition());
@@ -354,7 +393,7 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                                 propagationGainDb,
                                 pathLossDb);
                     // Pathloss trace
-                    m_pathLossTrace(txParams->txPhy, *rxPhyIterator, pathLossDb);
+                    m_pathLossTrace(txParams->txPhy, rxPhy, pathLossDb);
                     if (pathLossDb > m_maxLossDb)
                     {
                         // beyond range
@@ -378,7 +417,7 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                                                    &MultiModelSpectrumChannel::StartRx,
                                                    this,
                                                    rxParams,
-                                                   *rxPhyIterator);
+                                                   rxPhy);
                 }
                 else
                 {
@@ -388,7 +427,7 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                                         &MultiModelSpectrumChannel::StartRx,
                                         this,
                                         rxParams,
-                                        *rxPhyIterator);
+                                        rxPhy);
                 }
             }
         }
@@ -427,6 +466,27 @@ MultiModelSpectrumChannel::StartRx(Ptr<SpectrumSignalParameters> params, Ptr<Spe
     receiver->StartRx(params);
 }
 
+void
+MultiModelSpectrumChannel::FindReceivers(const Vector& position, std::vector<uint32_t>& ids)
+{
+    NS_LOG_FUNCTION(this << position);
+    if (!m_index || m_index->GetCellSize() != m_maxRange)
+    {
+        // number the receivers in the order of StartTx, which iterates over the
+        // receivers of each RX spectrum model in turn
+        m_index = std::make_unique<SpatialGridIndex>(m_maxRange);
+        uint32_t id = 0;
+        for (const auto& [uid, rxInfo] : m_rxSpectrumModelInfoMap)
+        {
+            for (const auto& phy : rxInfo.m_rxPhys)
+            {
+                m_index->Add(id++, phy->GetMobility());
+            }
+        }
+    }
+    m_index->GetNear(position, m_maxRange, ids);
+}
+
 std::size_t
 MultiModelSpectrumChannel::GetNDevices() const
 {
@@ -26,13 +26,17 @@
 #include "spectrum-value.h"
 
 #include <ns3/propagation-delay-model.h>
+#include <ns3/vector.h>
 
 #include <map>
+#include <memory>
 #include <set>
 
 namespace ns3
 {
 
+class SpatialGridIndex;
+
 /**
  * \ingroup spectrum
  * Container: SpectrumModelUid_t, SpectrumConverter
@@ -99,11 +103,16 @@ typedef std::map<SpectrumModelUid_t, RxSpectrumModelInfo> RxSpectrumModelInfoMap
  * for this to work is that, after the SpectrumPhy switched its
  * SpectrumModel,  MultiModelSpectrumChannel::AddRx () is
  * called again passing the pointer to that SpectrumPhy.
+ *
+ * With the MaxRange attribute, the receivers further than this distance
+ * from the transmitter are skipped, and the receivers in range are found
+ * with a SpatialGridIndex of their positions.
  */
 class MultiModelSpectrumChannel : public SpectrumChannel
 {
   public:
     MultiModelSpectrumChannel();
+    ~MultiModelSpectrumChannel() override;
 
     /**
      * \brief Get the type ID.
@@ -145,6 +154,16 @@ class MultiModelSpectrumChannel : public SpectrumChannel
      */
     virtual void StartRx(Ptr<SpectrumSignalParameters> params, Ptr<SpectrumPhy> receiver);
 
+    /**
+     * Find the receivers which may be within MaxRange of a position, and
+     * build the spatial index of the receivers first if needed.
+     *
+     * \param position The position of the transmitter.
+     * \param [out] ids The receivers, numbered in the order of the receivers
+     *        of each RX spectrum model in m_rxSpectrumModelInfoMap, in increasing order.
+     */
+    void FindReceivers(const Vector& position, std::vector<uint32_t>& ids);
+
     /**
      * Data structure holding, for each TX SpectrumModel,  all the
      * converters to any RX SpectrumModel, and all the corresponding
@@ -163,6 +182,17 @@ class MultiModelSpectrumChannel : public SpectrumChannel
      * Number of devices connected to the channel.
      */
     std::size_t m_numDevices;
+
+    /**
+     * Distance beyond which the receivers are skipped, or 0 for no limit.
+     */
+    double m_maxRange;
+
+    /**
+     * Spatial index of the receivers, built at the first transmission with a
+     * MaxRange and after the receivers change.
+     */
+    std::unique_ptr<SpatialGridIndex> m_index;
 };
 
 } // namespace ns3
@@ -0,0 +1,188 @@
+#include "binary-trace-writer.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("BinaryTraceWriter");
+
+NS_OBJECT_ENSURE_REGISTERED(BinaryTraceWriter);
+
+namespace
+{
+
+const char MAGIC[8] = {'N', 'S', '3', 'T', 'R', 'A', 'C', 'E'}; //!< Start of the file
+const uint32_t VERSION = 1;                                      //!< Format version
+const uint32_t COLUMN_DESCRIPTOR_SIZE = 32; //!< Size of a column descriptor, in bytes
+const uint32_t HEADER_ALIGNMENT = 64;       //!< The header size is a multiple of this
+
+/**
+ * \param type a column type
+ * \return the size of a value of this type, in bytes
+ */
+uint32_t
+GetTypeSize(BinaryTraceWriter::ColumnType type)
+{
+    switch (type)
+    {
+    case BinaryTraceWriter::U8:
+        return 1;
+    case BinaryTraceWriter::U32:
+    case BinaryTraceWriter::I32:
+        return 4;
+    case BinaryTraceWriter::U64:
+    case BinaryTraceWriter::I64:
+    case BinaryTraceWriter::DOUBLE:
+        return 8;
+    }
+    NS_ABORT_MSG("Unknown column type " << +type);
+    return 0;
+}
+
+} // namespace
+
+TypeId
+BinaryTraceWriter::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::BinaryTraceWriter")
+            .SetParent<Object>()
+            .SetGroupName("Stats")
+            .AddConstructor<BinaryTraceWriter>()
+            .AddAttribute("BufferSize",
+                          "Size of the buffer holding the records before they are written, in "
+                          "bytes. It always holds at least one record.",
+                          UintegerValue(1 << 20),
+                          MakeUintegerAccessor(&BinaryTraceWriter::m_bufferSize),
+                          MakeUintegerChecker<uint32_t>());
+    return tid;
+}
+
+BinaryTraceWriter::BinaryTraceWriter()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+BinaryTraceWriter::~BinaryTraceWriter()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+void
+BinaryTraceWriter::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+    Object::DoDispose();
+}
+
+void
+BinaryTraceWriter::AddColumn(const std::string& name, ColumnType type)
+{
+    NS_LOG_FUNCTION(this << name << +type);
+    NS_ABORT_MSG_IF(m_file.is_open(), "Columns cannot be added once the file is open");
+    NS_ABORT_MSG_IF(name.size() >= COLUMN_DESCRIPTOR_SIZE - 1,
+                    "Column name too long: " << name);
+
+    m_columns.push_back({name, type});
+    m_recordSize += GetTypeSize(type);
+}
+
+void
+BinaryTraceWriter::Open(const std::string& fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    NS_ABORT_MSG_IF(m_columns.empty(), "No column has been added");
+    NS_ABORT_MSG_IF(m_file.is_open(), "The trace file is already open");
+
+    m_file.open(fileName, std::ios::out | std::ios::binary | std::ios::trunc);
+    NS_ABORT_MSG_UNLESS(m_file.is_open(), "Unable to open " << fileName);
+
+    uint32_t nColumns = m_columns.size();
+    uint32_t headerSize = 8 + 4 * sizeof(uint32_t) + nColumns * COLUMN_DESCRIPTOR_SIZE;
+    headerSize = (headerSize + HEADER_ALIGNMENT - 1) / HEADER_ALIGNMENT * HEADER_ALIGNMENT;
+
+    std::vector<char> header(headerSize, 0);
+    char* p = header.data();
+    std::memcpy(p, MAGIC, sizeof(MAGIC));
+    p += sizeof(MAGIC);
+    for (uint32_t field : {VERSION, nColumns, m_recordSize, headerSize})
+    {
+        std::memcpy(p, &field, sizeof(field));
+        p += sizeof(field);
+    }
+    for (const auto& column : m_columns)
+    {
+        p[0] = column.type;
+        std::memcpy(p + 1, column.name.data(), column.name.size());
+        p += COLUMN_DESCRIPTOR_SIZE;
+    }
+    m_file.write(header.data(), header.size());
+
+    std::size_t recordsPerBuffer = std::max<std::size_t>(m_bufferSize / m_recordSize, 1);
+    m_buffer.resize(recordsPerBuffer * m_recordSize);
+    m_offset = 0;
+    m_column = 0;
+    m_nRecords = 0;
+}
+
+void
+BinaryTraceWriter::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_file.is_open())
+    {
+        return;
+    }
+    // only write whole records, the buffer always starts with a record
+    std::size_t size = m_offset - m_offset % m_recordSize;
+    if (size > 0)
+    {
+        m_file.write(reinterpret_cast<const char*>(m_buffer.data()), size);
+        std::memmove(m_buffer.data(), m_buffer.data() + size, m_offset - size);
+        m_offset -= size;
+    }
+    m_file.flush();
+}
+
+void
+BinaryTraceWriter::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_file.is_open())
+    {
+        return;
+    }
+    if (m_column != 0)
+    {
+        NS_LOG_WARN("Dropping the incomplete last record");
+    }
+    Flush();
+    m_file.close();
+}
+
+bool
+BinaryTraceWriter::IsOpen() const
+{
+    return m_file.is_open();
+}
+
+uint32_t
+BinaryTraceWriter::GetRecordSize() const
+{
+    return m_recordSize;
+}
+
+uint64_t
+BinaryTraceWriter::GetNRecords() const
+{
+    return m_nRecords;
+}
+
+} // namespace ns3
@@ -0,0 +1,218 @@
+#ifndef BINARY_TRACE_WRITER_H
+#define BINARY_TRACE_WRITER_H
+
+#include "ns3/assert.h"
+#include "ns3/object.h"
+
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup stats
+ *
+ * \brief Writes traces to a binary file made of fixed-width records
+ *
+ * The columns of the trace are declared with AddColumn() before the file is
+ * opened. A record is then written by calling the Write method matching the
+ * type of every column, in the order of declaration. Records are gathered in
+ * a buffer of BufferSize bytes, which is written to the file when it is full,
+ * so the file only contains whole records.
+ *
+ * The file starts with a header:
+ *
+ * - the magic string "NS3TRACE" (8 bytes)
+ * - the format version, the number of columns, the size of a record and the
+ *   size of the header (4 bytes each)
+ * - one 32 bytes descriptor per column: the ColumnType (1 byte) followed by
+ *   the name, padded with zeros
+ *
+ * The header is padded with zeros to a multiple of 64 bytes and followed by
+ * the records. The fields of a record are packed in the order of the columns,
+ * in the byte order of the host. The number of records is not stored: it is
+ * given by the size of the file, hence the records can be memory mapped as an
+ * array, e.g. with numpy.memmap (see pylib/trace.py).
+ */
+class BinaryTraceWriter : public Object
+{
+  public:
+    /// The type of a column
+    enum ColumnType : uint8_t
+    {
+        U8 = 0,
+        U32 = 1,
+        U64 = 2,
+        I32 = 3,
+        I64 = 4,
+        DOUBLE = 5
+    };
+
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    BinaryTraceWriter();
+    ~BinaryTraceWriter() override;
+
+    /**
+     * \brief Add a column to the records
+     *
+     * Columns can only be added before the file is opened.
+     *
+     * \param name the name of the column, at most 30 characters
+     * \param type the type of the column
+     */
+    void AddColumn(const std::string& name, ColumnType type);
+
+    /**
+     * \brief Create the file and write the header
+     * \param fileName the name of the file
+     */
+    void Open(const std::string& fileName);
+
+    /**
+     * \brief Write the buffered records to the file
+     */
+    void Flush();
+
+    /**
+     * \brief Write the buffered records and close the file
+     */
+    void Close();
+
+    /**
+     * \return true if the file is open
+     */
+    bool IsOpen() const;
+
+    /**
+     * \return the size of a record, in bytes
+     */
+    uint32_t GetRecordSize() const;
+
+    /**
+     * \return the number of records written so far
+     */
+    uint64_t GetNRecords() const;
+
+    /**
+     * \param value the value of the next column, of type U8
+     */
+    void WriteU8(uint8_t value);
+    /**
+     * \param value the value of the next column, of type U32
+     */
+    void WriteU32(uint32_t value);
+    /**
+     * \param value the value of the next column, of type U64
+     */
+    void WriteU64(uint64_t value);
+    /**
+     * \param value the value of the next column, of type I32
+     */
+    void WriteI32(int32_t value);
+    /**
+     * \param value the value of the next column, of type I64
+     */
+    void WriteI64(int64_t value);
+    /**
+     * \param value the value of the next column, of type DOUBLE
+     */
+    void WriteDouble(double value);
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /**
+     * \brief Write the value of the next column of the current record
+     * \param type the type of the value
+     * \param value the value
+     */
+    template <typename T>
+    void Write(ColumnType type, T value);
+
+    /// A column of the records
+    struct Column
+    {
+        std::string name; //!< Name of the column
+        ColumnType type;  //!< Type of the column
+    };
+
+    std::vector<Column> m_columns; //!< Columns of the records
+    uint32_t m_recordSize{0};      //!< Size of a record, in bytes
+    uint32_t m_bufferSize;         //!< Size of the buffer, in bytes
+    std::vector<uint8_t> m_buffer; //!< Records not written to the file yet
+    std::size_t m_offset{0};       //!< End of the data in the buffer
+    std::size_t m_column{0};       //!< Next column of the current record
+    uint64_t m_nRecords{0};        //!< Number of complete records
+    std::ofstream m_file;          //!< The trace file
+};
+
+template <typename T>
+void
+BinaryTraceWriter::Write(ColumnType type, T value)
+{
+    NS_ASSERT_MSG(m_file.is_open(), "The trace file is not open");
+    NS_ASSERT_MSG(m_columns[m_column].type == type,
+                  "Wrong type for column " << m_columns[m_column].name);
+
+    std::memcpy(m_buffer.data() + m_offset, &value, sizeof(T));
+    m_offset += sizeof(T);
+
+    if (++m_column == m_columns.size())
+    {
+        m_column = 0;
+        m_nRecords++;
+        if (m_buffer.size() - m_offset < m_recordSize)
+        {
+            Flush();
+        }
+    }
+}
+
+inline void
+BinaryTraceWriter::WriteU8(uint8_t value)
+{
+    Write(U8, value);
+}
+
+inline void
+BinaryTraceWriter::WriteU32(uint32_t value)
+{
+    Write(U32, value);
+}
+
+inline void
+BinaryTraceWriter::WriteU64(uint64_t value)
+{
+    Write(U64, value);
+}
+
+inline void
+BinaryTraceWriter::WriteI32(int32_t value)
+{
+    Write(I32, value);
+}
+
+inline void
+BinaryTraceWriter::WriteI64(int64_t value)
+{
+    Write(I64, value);
+}
+
+inline void
+BinaryTraceWriter::WriteDouble(double value)
+{
+    Write(DOUBLE, value);
+}
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_WRITER_H */
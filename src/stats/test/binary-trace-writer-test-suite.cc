@@ -0,0 +1,115 @@
+#include "ns3/binary-trace-writer.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief BinaryTraceWriter Test
+ *
+ * Writes records through a buffer smaller than the trace and checks the
+ * header and the records read back from the file.
+ */
+class BinaryTraceWriterTestCase : public TestCase
+{
+  public:
+    BinaryTraceWriterTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * \brief Read a value from the file contents
+     * \param data the file contents
+     * \param offset the offset of the value
+     * \return the value
+     */
+    template <typename T>
+    T Read(const std::vector<char>& data, std::size_t offset);
+};
+
+BinaryTraceWriterTestCase::BinaryTraceWriterTestCase()
+    : TestCase("BinaryTraceWriter")
+{
+}
+
+template <typename T>
+T
+BinaryTraceWriterTestCase::Read(const std::vector<char>& data, std::size_t offset)
+{
+    T value;
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    return value;
+}
+
+void
+BinaryTraceWriterTestCase::DoRun()
+{
+    std::string fileName = CreateTempDirFilename("binary-trace-writer.bin");
+    const uint32_t nRecords = 10;
+
+    Ptr<BinaryTraceWriter> writer = CreateObject<BinaryTraceWriter>();
+    writer->SetAttribute("BufferSize", UintegerValue(40)); // two records
+    writer->AddColumn("ts", BinaryTraceWriter::DOUBLE);
+    writer->AddColumn("count", BinaryTraceWriter::U32);
+    writer->AddColumn("cwnd", BinaryTraceWriter::I64);
+    NS_TEST_ASSERT_MSG_EQ(writer->GetRecordSize(), 20, "Records should be packed");
+
+    writer->Open(fileName);
+    for (uint32_t i = 0; i < nRecords; i++)
+    {
+        writer->WriteDouble(i * 0.5);
+        writer->WriteU32(i);
+        writer->WriteI64(-static_cast<int64_t>(i));
+    }
+    NS_TEST_ASSERT_MSG_EQ(writer->GetNRecords(), nRecords, "Wrong number of records");
+    writer->Close();
+
+    std::ifstream file(fileName, std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    NS_TEST_ASSERT_MSG_EQ(std::string(data.data(), 8), "NS3TRACE", "Wrong magic string");
+    NS_TEST_ASSERT_MSG_EQ(Read<uint32_t>(data, 8), 1, "Wrong version");
+    NS_TEST_ASSERT_MSG_EQ(Read<uint32_t>(data, 12), 3, "Wrong number of columns");
+    NS_TEST_ASSERT_MSG_EQ(Read<uint32_t>(data, 16), 20, "Wrong record size");
+    auto headerSize = Read<uint32_t>(data, 20);
+    NS_TEST_ASSERT_MSG_EQ(headerSize, 128, "Wrong header size");
+    NS_TEST_ASSERT_MSG_EQ(+Read<uint8_t>(data, 24 + 32), +BinaryTraceWriter::U32, "Wrong type");
+    NS_TEST_ASSERT_MSG_EQ(std::string(data.data() + 24 + 32 + 1), "count", "Wrong name");
+    NS_TEST_ASSERT_MSG_EQ(data.size(), headerSize + nRecords * 20, "Wrong file size");
+
+    for (uint32_t i = 0; i < nRecords; i++)
+    {
+        std::size_t offset = headerSize + i * 20;
+        NS_TEST_EXPECT_MSG_EQ(Read<double>(data, offset), i * 0.5, "Wrong ts");
+        NS_TEST_EXPECT_MSG_EQ(Read<uint32_t>(data, offset + 8), i, "Wrong count");
+        NS_TEST_EXPECT_MSG_EQ(Read<int64_t>(data, offset + 12), -static_cast<int64_t>(i), "Wrong cwnd");
+    }
+}
+
+/**
+ * \ingroup stats-tests
+ *
+ * \brief BinaryTraceWriter TestSuite
+ */
+class BinaryTraceWriterTestSuite : public TestSuite
+{
+  public:
+    BinaryTraceWriterTestSuite();
+};
+
+BinaryTraceWriterTestSuite::BinaryTraceWriterTestSuite()
+    : TestSuite("binary-trace-writer", UNIT)
+{
+    AddTestCase(new BinaryTraceWriterTestCase, TestCase::QUICK);
+}
+
+static BinaryTraceWriterTestSuite
+    g_binaryTraceWriterTestSuite; //!< Static variable for test initialization
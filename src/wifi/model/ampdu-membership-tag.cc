@@ -0,0 +1,84 @@
+#include "ampdu-membership-tag.h"
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(AmpduMembershipTag);
+
+TypeId
+AmpduMembershipTag::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::AmpduMembershipTag")
+                            .SetParent<Tag>()
+                            .SetGroupName("Wifi")
+                            .AddConstructor<AmpduMembershipTag>();
+    return tid;
+}
+
+TypeId
+AmpduMembershipTag::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+AmpduMembershipTag::AmpduMembershipTag()
+    : m_ampduId(0),
+      m_position(0),
+      m_nMpdus(0)
+{
+}
+
+AmpduMembershipTag::AmpduMembershipTag(uint64_t ampduId, uint16_t position, uint16_t nMpdus)
+    : m_ampduId(ampduId),
+      m_position(position),
+      m_nMpdus(nMpdus)
+{
+}
+
+uint64_t
+AmpduMembershipTag::GetAmpduId() const
+{
+    return m_ampduId;
+}
+
+uint16_t
+AmpduMembershipTag::GetPosition() const
+{
+    return m_position;
+}
+
+uint16_t
+AmpduMembershipTag::GetNMpdus() const
+{
+    return m_nMpdus;
+}
+
+uint32_t
+AmpduMembershipTag::GetSerializedSize() const
+{
+    return 12;
+}
+
+void
+AmpduMembershipTag::Serialize(TagBuffer i) const
+{
+    i.WriteU64(m_ampduId);
+    i.WriteU16(m_position);
+    i.WriteU16(m_nMpdus);
+}
+
+void
+AmpduMembershipTag::Deserialize(TagBuffer i)
+{
+    m_ampduId = i.ReadU64();
+    m_position = i.ReadU16();
+    m_nMpdus = i.ReadU16();
+}
+
+void
+AmpduMembershipTag::Print(std::ostream& os) const
+{
+    os << "A-MPDU id=" << m_ampduId << " position=" << m_position << "/" << m_nMpdus;
+}
+
+} // namespace ns3
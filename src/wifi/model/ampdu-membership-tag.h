@@ -0,0 +1,69 @@
+#ifndef AMPDU_MEMBERSHIP_TAG_H
+#define AMPDU_MEMBERSHIP_TAG_H
+
+#include "ns3/tag.h"
+
+namespace ns3
+{
+
+/**
+ * \ingroup wifi
+ *
+ * The aggregate an MPDU was transmitted in. It is added by the MpduAggregator
+ * to the packet of every MPDU of an A-MPDU, and it travels with the packet
+ * up to the receiver, so that upper layers can tell which segments were
+ * received in the same aggregate.
+ */
+class AmpduMembershipTag : public Tag
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+
+    /**
+     * Create an AmpduMembershipTag with the default values
+     */
+    AmpduMembershipTag();
+
+    /**
+     * Create an AmpduMembershipTag
+     *
+     * \param ampduId the identifier of the A-MPDU
+     * \param position the position of the MPDU in the A-MPDU (0 for the first one)
+     * \param nMpdus the number of MPDUs in the A-MPDU
+     */
+    AmpduMembershipTag(uint64_t ampduId, uint16_t position, uint16_t nMpdus);
+
+    /**
+     * The identifier of the A-MPDU is the UID of the packet of its first MPDU.
+     *
+     * \return the identifier of the A-MPDU
+     */
+    uint64_t GetAmpduId() const;
+    /**
+     * \return the position of the MPDU in the A-MPDU (0 for the first one)
+     */
+    uint16_t GetPosition() const;
+    /**
+     * \return the number of MPDUs in the A-MPDU
+     */
+    uint16_t GetNMpdus() const;
+
+    uint32_t GetSerializedSize() const override;
+    void Serialize(TagBuffer i) const override;
+    void Deserialize(TagBuffer i) override;
+    void Print(std::ostream& os) const override;
+
+  private:
+    uint64_t m_ampduId;  //!< Identifier of the A-MPDU
+    uint16_t m_position; //!< Position of the MPDU in the A-MPDU
+    uint16_t m_nMpdus;   //!< Number of MPDUs in the A-MPDU
+};
+
+} // namespace ns3
+
+#endif /* AMPDU_MEMBERSHIP_TAG_H */
@@ -23,11 +23,14 @@
 #include "sta-wifi-mac.h"
 #include "wifi-mac-queue.h"
 #include "wifi-mac-trailer.h"
+#include "wifi-net-device.h"
 #include "wifi-utils.h"
 
 #include "ns3/abort.h"
 #include "ns3/log.h"
 
+#include <algorithm>
+
 #undef NS_LOG_APPEND_CONTEXT
 #define NS_LOG_APPEND_CONTEXT std::clog << "[link=" << +m_linkId << "][mac=" << m_self << "] "
 
@@ -1146,6 +1149,13 @@ FrameExchangeManager::Receive(Ptr<const WifiPsdu> psdu,
         else
         {
             EndReceiveAmpdu(psdu, rxSignalInfo, txVector, perMpduStatus);
+            // the MPDUs have been forwarded up as they were received, let the upper
+            // layers know that this was the last one
+            if (std::find(perMpduStatus.cbegin(), perMpduStatus.cend(), true) !=
+                perMpduStatus.cend())
+            {
+                m_mac->GetDevice()->NotifyRxAggregateEnd();
+            }
         }
     }
     else if (m_promisc)
@@ -181,7 +181,8 @@ InterferenceHelper::NiChange::GetEvent() const
 InterferenceHelper::InterferenceHelper()
     : m_errorRateModel(nullptr),
       m_numRxAntennas(1),
-      m_rxing(false)
+      m_rxing(false),
+      m_version(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -211,6 +212,7 @@ InterferenceHelper::DoDispose()
     }
     m_niChanges.clear();
     m_firstPowers.clear();
+    m_payloadProfile = PayloadProfile();
     m_errorRateModel = nullptr;
 }
 
@@ -263,6 +265,7 @@ InterferenceHelper::AddBand(const WifiSpectrumBandInfo& band)
     // Always have a zero power noise event in the list
     AddNiChangeEvent(Time(0), NiChange(0.0, nullptr), result.first);
     m_firstPowers.insert({band, 0.0});
+    m_version++;
 }
 
 void
@@ -288,6 +291,7 @@ InterferenceHelper::UpdateBands(const std::vector<WifiSpectrumBandInfo>& bands,
             m_firstPowers.erase(it->first);
             it->second.clear();
             it = m_niChanges.erase(it);
+            m_version++;
         }
         else
         {
@@ -308,12 +312,14 @@ void
 InterferenceHelper::SetNoiseFigure(double value)
 {
     m_noiseFigure = value;
+    m_version++;
 }
 
 void
 InterferenceHelper::SetErrorRateModel(const Ptr<ErrorRateModel> rate)
 {
     m_errorRateModel = rate;
+    m_version++;
 }
 
 Ptr<ErrorRateModel>
@@ -326,6 +332,7 @@ void
 InterferenceHelper::SetNumberOfReceiveAntennas(uint8_t rx)
 {
     m_numRxAntennas = rx;
+    m_version++;
 }
 
 Time
@@ -353,6 +360,7 @@ void
 InterferenceHelper::AppendEvent(Ptr<Event> event, bool isStartHePortionRxing)
 {
     NS_LOG_FUNCTION(this << event << isStartHePortionRxing);
+    m_version++;
     for (const auto& [band, power] : event->GetRxPowerWPerBand())
     {
         auto niIt = m_niChanges.find(band);
@@ -390,6 +398,7 @@ InterferenceHelper::UpdateEvent(Ptr<Event> event, const RxPowerWattPerChannelBan
 {
     NS_LOG_FUNCTION(this << event);
     // This is called for UL MU events, in order to scale power as long as UL MU PPDUs arrive
+    m_version++;
     for (const auto& [band, power] : rxPower)
     {
         auto niIt = m_niChanges.find(band);
@@ -438,7 +447,7 @@ InterferenceHelper::CalculateSnr(double signal,
 
 double
 InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
-                                                NiChangesPerBand& nis,
+                                                NiChangesPerBand* nis,
                                                 const WifiSpectrumBandInfo& band) const
 {
     NS_LOG_FUNCTION(this << band);
@@ -467,20 +476,23 @@ InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
             noiseInterferenceW = 0.0;
         }
     }
-    it = niIt->second.find(event->GetStartTime());
-    NS_ABORT_IF(it == niIt->second.end());
-    for (; it != niIt->second.end() && it->second.GetEvent() != event; ++it)
-    {
-        ;
-    }
-    NiChanges ni;
-    ni.emplace(event->GetStartTime(), NiChange(0, event));
-    while (++it != niIt->second.end() && it->second.GetEvent() != event)
+    if (nis)
     {
-        ni.insert(*it);
+        it = niIt->second.find(event->GetStartTime());
+        NS_ABORT_IF(it == niIt->second.end());
+        for (; it != niIt->second.end() && it->second.GetEvent() != event; ++it)
+        {
+            ;
+        }
+        NiChanges ni;
+        ni.emplace(event->GetStartTime(), NiChange(0, event));
+        while (++it != niIt->second.end() && it->second.GetEvent() != event)
+        {
+            ni.insert(*it);
+        }
+        ni.emplace(event->GetEndTime(), NiChange(0, event));
+        nis->insert({band, ni});
     }
-    ni.emplace(event->GetEndTime(), NiChange(0, event));
-    nis.insert({band, ni});
     NS_ASSERT_MSG(noiseInterferenceW >= 0.0,
                   "CalculateNoiseInterferenceW returns negative value " << noiseInterferenceW);
     return noiseInterferenceW;
@@ -648,6 +660,88 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
     return per;
 }
 
+const InterferenceHelper::PayloadProfile&
+InterferenceHelper::GetPayloadProfile(Ptr<const Event> event,
+                                      uint16_t channelWidth,
+                                      const WifiSpectrumBandInfo& band,
+                                      uint16_t staId) const
+{
+    NS_LOG_FUNCTION(this << channelWidth << band << staId);
+    const auto& txVector = event->GetPpdu()->GetTxVector();
+    uint8_t nss = txVector.GetNss(staId);
+    auto firstPowerIt = m_firstPowers.find(band);
+    NS_ABORT_IF(firstPowerIt == m_firstPowers.end());
+    PayloadProfile& profile = m_payloadProfile;
+    if (profile.event == event && profile.band.indices == band.indices &&
+        profile.band.frequencies == band.frequencies && profile.channelWidth == channelWidth &&
+        profile.nss == nss && profile.version == m_version &&
+        profile.firstPowerW == firstPowerIt->second)
+    {
+        // no NI change since the previous MPDU
+        return profile;
+    }
+    profile.event = event;
+    profile.band = band;
+    profile.channelWidth = channelWidth;
+    profile.nss = nss;
+    profile.version = m_version;
+    profile.firstPowerW = firstPowerIt->second;
+    profile.payloadStart = event->GetStartTime();
+    // the event of a DL MU PPDU starts with the MU payload
+    if (event->GetPpdu()->GetType() != WIFI_PPDU_TYPE_DL_MU)
+    {
+        profile.payloadStart += WifiPhy::CalculatePhyPreambleAndHeaderDuration(txVector);
+    }
+    profile.times.clear();
+    profile.snrs.clear();
+
+    // the chunks are delimited by the NI changes between the NI changes of the event
+    auto niIt = m_niChanges.find(band);
+    NS_ABORT_IF(niIt == m_niChanges.end());
+    auto it = niIt->second.find(event->GetStartTime());
+    NS_ABORT_IF(it == niIt->second.end());
+    for (; it != niIt->second.end() && it->second.GetEvent() != event; ++it)
+    {
+        ;
+    }
+    double powerW = event->GetRxPowerW(band);
+    profile.times.push_back(event->GetStartTime());
+    profile.snrs.push_back(CalculateSnr(powerW, profile.firstPowerW, channelWidth, nss));
+    while (++it != niIt->second.end() && it->second.GetEvent() != event)
+    {
+        profile.times.push_back(it->first);
+        profile.snrs.push_back(
+            CalculateSnr(powerW, it->second.GetPower() - powerW, channelWidth, nss));
+    }
+    profile.times.push_back(event->GetEndTime());
+    return profile;
+}
+
+double
+InterferenceHelper::CalculatePayloadPer(const PayloadProfile& profile,
+                                        const WifiTxVector& txVector,
+                                        uint16_t staId,
+                                        std::pair<Time, Time> window) const
+{
+    NS_LOG_FUNCTION(this << staId << window.first << window.second);
+    double psr = 1.0; /* Packet Success Rate */
+    Time windowStart = profile.payloadStart + window.first;
+    Time windowEnd = profile.payloadStart + window.second;
+    const auto& times = profile.times;
+    // first chunk which ends in the window
+    std::size_t chunk =
+        std::lower_bound(times.begin() + 1, times.end(), windowStart) - times.begin() - 1;
+    for (; chunk + 1 < times.size() && times[chunk] <= windowEnd; chunk++)
+    {
+        Time duration = Min(windowEnd, times[chunk + 1]) - Max(windowStart, times[chunk]);
+        psr *= CalculatePayloadChunkSuccessRate(profile.snrs[chunk], duration, txVector, staId);
+        NS_LOG_DEBUG("Chunk [" << times[chunk] << ", " << times[chunk + 1]
+                               << "] in the windowed payload for " << duration.As(Time::NS)
+                               << ": psr=" << psr);
+    }
+    return 1 - psr;
+}
+
 double
 InterferenceHelper::CalculatePhyHeaderSectionPsr(
     Ptr<const Event> event,
@@ -751,8 +845,9 @@ InterferenceHelper::CalculatePayloadSnrPer(Ptr<Event> event,
 {
     NS_LOG_FUNCTION(this << channelWidth << band << staId << relativeMpduStartStop.first
                          << relativeMpduStartStop.second);
+    bool ulMu = (event->GetPpdu()->GetType() == WIFI_PPDU_TYPE_UL_MU);
     NiChangesPerBand ni;
-    double noiseInterferenceW = CalculateNoiseInterferenceW(event, ni, band);
+    double noiseInterferenceW = CalculateNoiseInterferenceW(event, ulMu ? &ni : nullptr, band);
     double snr = CalculateSnr(event->GetRxPowerW(band),
                               noiseInterferenceW,
                               channelWidth,
@@ -761,7 +856,19 @@ InterferenceHelper::CalculatePayloadSnrPer(Ptr<Event> event,
     /* calculate the SNIR at the start of the MPDU (located through windowing) and accumulate
      * all SNIR changes in the SNIR vector.
      */
-    double per = CalculatePayloadPer(event, channelWidth, &ni, band, staId, relativeMpduStartStop);
+    double per;
+    if (ulMu)
+    {
+        per = CalculatePayloadPer(event, channelWidth, &ni, band, staId, relativeMpduStartStop);
+    }
+    else
+    {
+        // the SNR of the chunks is shared by the MPDUs of an A-MPDU
+        per = CalculatePayloadPer(GetPayloadProfile(event, channelWidth, band, staId),
+                                  event->GetPpdu()->GetTxVector(),
+                                  staId,
+                                  relativeMpduStartStop);
+    }
 
     return PhyEntity::SnrPer(snr, per);
 }
@@ -772,8 +879,7 @@ InterferenceHelper::CalculateSnr(Ptr<Event> event,
                                  uint8_t nss,
                                  const WifiSpectrumBandInfo& band) const
 {
-    NiChangesPerBand ni;
-    double noiseInterferenceW = CalculateNoiseInterferenceW(event, ni, band);
+    double noiseInterferenceW = CalculateNoiseInterferenceW(event, nullptr, band);
     double snr = CalculateSnr(event->GetRxPowerW(band), noiseInterferenceW, channelWidth, nss);
     return snr;
 }
@@ -786,7 +892,7 @@ InterferenceHelper::CalculatePhyHeaderSnrPer(Ptr<Event> event,
 {
     NS_LOG_FUNCTION(this << band << header);
     NiChangesPerBand ni;
-    double noiseInterferenceW = CalculateNoiseInterferenceW(event, ni, band);
+    double noiseInterferenceW = CalculateNoiseInterferenceW(event, &ni, band);
     double snr = CalculateSnr(event->GetRxPowerW(band), noiseInterferenceW, channelWidth, 1);
 
     /* calculate the SNIR at the start of the PHY header and accumulate
@@ -831,6 +937,8 @@ InterferenceHelper::NotifyRxEnd(Time endTime, const FrequencyRange& freqRange)
 {
     NS_LOG_FUNCTION(this << endTime << freqRange);
     m_rxing = false;
+    m_version++;
+    m_payloadProfile.event = nullptr;
     // Update m_firstPowers for frame capture
     for (auto niIt = m_niChanges.begin(); niIt != m_niChanges.end(); ++niIt)
     {
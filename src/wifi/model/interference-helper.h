@@ -432,13 +432,13 @@ class InterferenceHelper : public Object
      * Calculate noise and interference power in W.
      *
      * \param event the event
-     * \param nis the NiChanges
+     * \param nis the NiChanges to fill with the NI changes of the event, or nullptr
      * \param band the band
      *
      * \return noise and interference power
      */
     double CalculateNoiseInterferenceW(Ptr<Event> event,
-                                       NiChangesPerBand& nis,
+                                       NiChangesPerBand* nis,
                                        const WifiSpectrumBandInfo& band) const;
 
     /**
@@ -473,6 +473,56 @@ class InterferenceHelper : public Object
                                const WifiSpectrumBandInfo& band,
                                uint16_t staId,
                                std::pair<Time, Time> window) const;
+
+    /**
+     * The SNR of the chunks of a PPDU, between its NI changes, in a flat form.
+     * It is computed once for all the MPDUs of an A-MPDU, until the NI
+     * changes are updated.
+     */
+    struct PayloadProfile
+    {
+        Ptr<const Event> event;    //!< the event
+        WifiSpectrumBandInfo band; //!< the band used by the PSDU
+        uint16_t channelWidth;     //!< the channel width (in MHz)
+        uint8_t nss;               //!< the number of spatial streams
+        uint64_t version;          //!< the version of the NI changes
+        double firstPowerW;        //!< the power at the start of the event in watts
+        Time payloadStart;         //!< the start of the PHY payload
+        std::vector<Time> times;   //!< the start of each chunk, and the end of the event
+        std::vector<double> snrs;  //!< the SNR of each chunk in linear scale
+    };
+
+    /**
+     * Get the SNR of the chunks of the payload of an event, computed for the
+     * previous MPDU if the NI changes did not change since.
+     *
+     * \param event the event
+     * \param channelWidth the channel width used to transmit the PSDU (in MHz)
+     * \param band identify the band used by the PSDU
+     * \param staId the station ID of the PSDU (only used for MU)
+     *
+     * \return the SNR of the chunks
+     */
+    const PayloadProfile& GetPayloadProfile(Ptr<const Event> event,
+                                            uint16_t channelWidth,
+                                            const WifiSpectrumBandInfo& band,
+                                            uint16_t staId) const;
+    /**
+     * Calculate the error rate of the given PHY payload only in the provided time
+     * window, from the SNR of its chunks. The PPDU must not be an UL MU PPDU,
+     * whose SNR depends on the other PPDUs of the same MU-MIMO transmission.
+     *
+     * \param profile the SNR of the chunks of the payload
+     * \param txVector the TXVECTOR of the PPDU
+     * \param staId the station ID of the PSDU (only used for MU)
+     * \param window time window (pair of start and end times) of PHY payload to focus on
+     *
+     * \return the error rate of the payload
+     */
+    double CalculatePayloadPer(const PayloadProfile& profile,
+                               const WifiTxVector& txVector,
+                               uint16_t staId,
+                               std::pair<Time, Time> window) const;
     /**
      * Calculate the error rate of the PHY header. The PHY header
      * can be divided into multiple chunks (e.g. due to interference from other transmissions).
@@ -513,6 +563,9 @@ class InterferenceHelper : public Object
     NiChangesPerBand m_niChanges;    //!< NI Changes for each band
     FirstPowerPerBand m_firstPowers; //!< first power of each band in watts
     bool m_rxing;                    //!< flag whether it is in receiving state
+    uint64_t m_version;              //!< incremented when the NI changes or the receiver change
+    /// SNR of the chunks of the last PSDU, kept for its next MPDUs
+    mutable PayloadProfile m_payloadProfile;
 
     /**
      * Returns an iterator to the first NiChange that is later than moment
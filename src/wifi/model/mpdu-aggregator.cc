@@ -20,6 +20,7 @@
 
 #include "mpdu-aggregator.h"
 
+#include "ampdu-membership-tag.h"
 #include "ampdu-subframe-header.h"
 #include "ctrl-headers.h"
 #include "msdu-aggregator.h"
@@ -46,7 +47,6 @@ namespace ns3
 {
 
 NS_OBJECT_ENSURE_REGISTERED(MpduAggregator);
-std::map<uint64_t, uint64_t> ___aggregations = {};
 
 TypeId
 MpduAggregator::GetTypeId()
@@ -88,8 +88,6 @@ MpduAggregator::SetLinkId(uint8_t linkId)
 void
 MpduAggregator::Aggregate(Ptr<const WifiMpdu> mpdu, Ptr<Packet> ampdu, bool isSingle)
 {
-    ___aggregations[ampdu->GetUid()] = mpdu->GetPacket()->GetUid();
-    ___aggregations[mpdu->GetPacket()->GetUid()] = mpdu->GetPacket()->GetUid();
     NS_LOG_FUNCTION(mpdu << ampdu << isSingle);
     NS_ASSERT(ampdu);
     // if isSingle is true, then ampdu must be empty
@@ -266,15 +264,20 @@ MpduAggregator::GetNextAmpdu(Ptr<WifiMpdu> mpdu,
         }
     }
 
-    for (auto p : mpduList) 
+    // tag the MPDUs with the A-MPDU they belong to. The tag is replaced rather than
+    // added because an MPDU may be retransmitted in a different A-MPDU or alone
+    if (mpduList.empty())
     {
-        ___aggregations[mpdu->GetOriginal()->GetPacket()->GetUid()] = mpdu->GetOriginal()->GetPacket()->GetUid();
-        ___aggregations[p->GetPacket()->GetUid()] = mpdu->GetOriginal()->GetPacket()->GetUid();
-        // std::cout << mpduList.size() << ' ' << p->GetPacket()->GetUid() << ' ' << p->GetOriginal()->GetPacket()->GetUid() << std::endl;
-        // std::cout << p->GetPacket()->GetUid() << ' ';
+        AmpduMembershipTag tag;
+        ConstCast<Packet>(mpdu->GetPacket())->RemovePacketTag(tag);
+    }
+    for (std::size_t i = 0; i < mpduList.size(); i++)
+    {
+        AmpduMembershipTag tag(mpduList.front()->GetOriginal()->GetPacket()->GetUid(),
+                               static_cast<uint16_t>(i),
+                               static_cast<uint16_t>(mpduList.size()));
+        ConstCast<Packet>(mpduList[i]->GetPacket())->ReplacePacketTag(tag);
     }
-    // std::cout << '\n';
-
 
     return mpduList;
 }
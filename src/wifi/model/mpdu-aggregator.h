@@ -31,8 +31,6 @@
 namespace ns3
 {
 
-extern std::map<uint64_t, uint64_t> ___aggregations;
-
 class AmpduSubframeHeader;
 class WifiTxVector;
 class QosTxop;
@@ -32,6 +32,7 @@
 #include "ns3/node.h"
 #include "ns3/object-vector.h"
 #include "ns3/pointer.h"
+#include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 #include "ns3/vht-configuration.h"
 
@@ -115,7 +116,13 @@ WifiNetDevice::GetTypeId()
                           "The EhtConfiguration object.",
                           PointerValue(),
                           MakePointerAccessor(&WifiNetDevice::GetEhtConfiguration),
-                          MakePointerChecker<EhtConfiguration>());
+                          MakePointerChecker<EhtConfiguration>())
+            .AddTraceSource("RxAggregateEnd",
+                            "All the MPDUs of a received A-MPDU have been forwarded up. "
+                            "Upper layers may use it as a hint that no more packets of "
+                            "the same burst follow.",
+                            MakeTraceSourceAccessor(&WifiNetDevice::m_rxAggregateEnd),
+                            "ns3::TracedValueCallback::Void");
     return tid;
 }
 
@@ -608,6 +615,13 @@ WifiNetDevice::SupportsSendFrom() const
     return m_mac->SupportsSendFrom();
 }
 
+void
+WifiNetDevice::NotifyRxAggregateEnd()
+{
+    NS_LOG_FUNCTION(this);
+    m_rxAggregateEnd();
+}
+
 void
 WifiNetDevice::SetHtConfiguration(Ptr<HtConfiguration> htConfiguration)
 {
@@ -210,6 +210,12 @@ class WifiNetDevice : public NetDevice
     void SetPromiscReceiveCallback(PromiscReceiveCallback cb) override;
     bool SupportsSendFrom() const override;
 
+    /**
+     * Notify that the last MPDU of a received A-MPDU has been forwarded up.
+     * Fires the RxAggregateEnd trace source.
+     */
+    void NotifyRxAggregateEnd();
+
   protected:
     void DoDispose() override;
     void DoInitialize() override;
@@ -252,6 +258,7 @@ class WifiNetDevice : public NetDevice
 
     TracedCallback<Ptr<const Packet>, Mac48Address> m_rxLogger; //!< receive trace callback
     TracedCallback<Ptr<const Packet>, Mac48Address> m_txLogger; //!< transmit trace callback
+    TracedCallback<> m_rxAggregateEnd; //!< end of received A-MPDU trace callback
 
     WifiStandard m_standard;        //!< Wifi standard
     uint32_t m_ifIndex;             //!< IF index
@@ -25,6 +25,7 @@
 #include "wifi-utils.h"
 #include "yans-wifi-phy.h"
 
+#include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
@@ -32,6 +33,7 @@
 #include "ns3/propagation-delay-model.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
+#include "ns3/spatial-grid-index.h"
 
 namespace ns3
 {
@@ -57,11 +59,27 @@ YansWifiChannel::GetTypeId()
                           "A pointer to the propagation delay model attached to this channel.",
                           PointerValue(),
                           MakePointerAccessor(&YansWifiChannel::m_delay),
-                          MakePointerChecker<PropagationDelayModel>());
+                          MakePointerChecker<PropagationDelayModel>())
+            .AddAttribute("MaxRange",
+                          "The distance in meters beyond which the PHYs do not receive the "
+                          "transmissions, or 0 for no limit. The PHYs in range are found with a "
+                          "spatial index of their positions, and the propagation loss of the "
+                          "other PHYs is not computed.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&YansWifiChannel::m_maxRange),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("MaxLossDb",
+                          "The propagation loss in dB beyond which the PHYs do not receive "
+                          "the transmissions.",
+                          DoubleValue(1.0e9),
+                          MakeDoubleAccessor(&YansWifiChannel::m_maxLossDb),
+                          MakeDoubleChecker<double>());
     return tid;
 }
 
 YansWifiChannel::YansWifiChannel()
+    : m_maxRange(0),
+      m_maxLossDb(1.0e9)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -72,6 +90,14 @@ YansWifiChannel::~YansWifiChannel()
     m_phyList.clear();
 }
 
+void
+YansWifiChannel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_index.reset();
+    Channel::DoDispose();
+}
+
 void
 YansWifiChannel::SetPropagationLossModel(const Ptr<PropagationLossModel> loss)
 {
@@ -92,24 +118,42 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double
     NS_LOG_FUNCTION(this << sender << ppdu << txPowerDbm);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
-    for (auto i = m_phyList.begin(); i != m_phyList.end(); i++)
+    std::vector<uint32_t> near;
+    if (m_maxRange > 0)
+    {
+        FindReceivers(senderMobility->GetPosition(), near);
+    }
+    std::size_t n = m_maxRange > 0 ? near.size() : m_phyList.size();
+    for (std::size_t k = 0; k < n; k++)
     {
-        if (sender != (*i))
+        const Ptr<YansWifiPhy>& receiver = m_phyList[m_maxRange > 0 ? near[k] : k];
+        if (sender != receiver)
         {
             // For now don't account for inter channel interference nor channel bonding
-            if ((*i)->GetChannelNumber() != sender->GetChannelNumber())
+            if (receiver->GetChannelNumber() != sender->GetChannelNumber())
             {
                 continue;
             }
 
-            Ptr<MobilityModel> receiverMobility = (*i)->GetMobility()->GetObject<MobilityModel>();
+            Ptr<MobilityModel> receiverMobility =
+                receiver->GetMobility()->GetObject<MobilityModel>();
+            if (m_maxRange > 0 && senderMobility->GetDistanceFrom(receiverMobility) > m_maxRange)
+            {
+                NS_LOG_DEBUG("receiver beyond MaxRange");
+                continue;
+            }
             Time delay = m_delay->GetDelay(senderMobility, receiverMobility);
             double rxPowerDbm = m_loss->CalcRxPower(txPowerDbm, senderMobility, receiverMobility);
             NS_LOG_DEBUG("propagation: txPower="
                          << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, "
                          << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
                          << "m, delay=" << delay);
-            Ptr<NetDevice> dstNetDevice = (*i)->GetDevice();
+            if (txPowerDbm - rxPowerDbm > m_maxLossDb)
+            {
+                NS_LOG_DEBUG("loss beyond MaxLossDb");
+                continue;
+            }
+            Ptr<NetDevice> dstNetDevice = receiver->GetDevice();
             uint32_t dstNode;
             if (!dstNetDevice)
             {
@@ -123,7 +167,7 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double
             Simulator::ScheduleWithContext(dstNode,
                                            delay,
                                            &YansWifiChannel::Receive,
-                                           (*i),
+                                           receiver,
                                            ppdu,
                                            rxPowerDbm);
         }
@@ -149,6 +193,47 @@ YansWifiChannel::Receive(Ptr<YansWifiPhy> phy, Ptr<const WifiPpdu> ppdu, double
     phy->StartReceivePreamble(ppdu, rxPowerW, ppdu->GetTxDuration());
 }
 
+void
+YansWifiChannel::FindReceivers(const Vector& position, std::vector<uint32_t>& ids) const
+{
+    NS_LOG_FUNCTION(this << position);
+    std::lock_guard<std::mutex> lock(m_indexMutex);
+    if (!m_index || m_index->GetCellSize() != m_maxRange)
+    {
+        m_index = std::make_unique<SpatialGridIndex>(m_maxRange);
+    }
+    // index the PHYs added since the last transmission: the mobility model of
+    // the nodes may be installed after the PHYs are added to the channel
+    for (auto id = static_cast<uint32_t>(m_index->GetN()); id < m_phyList.size(); id++)
+    {
+        m_index->Add(id, m_phyList[id]->GetMobility());
+    }
+    m_index->GetNear(position, m_maxRange, ids);
+}
+
+Time
+YansWifiChannel::GetMinimumDelay() const
+{
+    NS_LOG_FUNCTION(this);
+    Time minDelay = Simulator::GetMaximumSimulationTime();
+    for (auto i = m_phyList.begin(); i != m_phyList.end(); i++)
+    {
+        for (auto j = m_phyList.begin(); j != m_phyList.end(); j++)
+        {
+            Ptr<NetDevice> senderDevice = (*i)->GetDevice();
+            Ptr<NetDevice> receiverDevice = (*j)->GetDevice();
+            if (i == j || (senderDevice && receiverDevice &&
+                           senderDevice->GetNode() == receiverDevice->GetNode()))
+            {
+                continue;
+            }
+            minDelay =
+                std::min(minDelay, m_delay->GetDelay((*i)->GetMobility(), (*j)->GetMobility()));
+        }
+    }
+    return minDelay;
+}
+
 std::size_t
 YansWifiChannel::GetNDevices() const
 {
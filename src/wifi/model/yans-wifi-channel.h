@@ -21,6 +21,10 @@
 #define YANS_WIFI_CHANNEL_H
 
 #include "ns3/channel.h"
+#include "ns3/vector.h"
+
+#include <memory>
+#include <mutex>
 
 namespace ns3
 {
@@ -32,6 +36,7 @@ class YansWifiPhy;
 class Packet;
 class Time;
 class WifiPpdu;
+class SpatialGridIndex;
 
 /**
  * \brief a channel to interconnect ns3::YansWifiPhy objects.
@@ -41,6 +46,11 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * The MaxRange and MaxLossDb attributes skip the receivers which can not
+ * sense the transmissions: no propagation event is scheduled for them. With
+ * a MaxRange, the receivers in range are found with a SpatialGridIndex of
+ * their positions, without computing the propagation loss to every PHY.
  */
 class YansWifiChannel : public Channel
 {
@@ -85,6 +95,17 @@ class YansWifiChannel : public Channel
      */
     void Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double txPowerDbm) const;
 
+    /**
+     * Get the shortest propagation delay between two PHYs of different
+     * nodes, given their current positions. A PPDU sent by a node reaches
+     * the other nodes at least this delay later, so it can be used as the
+     * lookahead of MultithreadedSimulatorImpl when the nodes do not move.
+     *
+     * \return the shortest delay, or Simulator::GetMaximumSimulationTime()
+     *         if there are less than two nodes
+     */
+    Time GetMinimumDelay() const;
+
     /**
      * Assign a fixed random variable stream number to the random variables
      * used by this model.  Return the number of streams (possibly zero) that
@@ -96,12 +117,24 @@ class YansWifiChannel : public Channel
      */
     int64_t AssignStreams(int64_t stream);
 
+  protected:
+    void DoDispose() override;
+
   private:
     /**
      * A vector of pointers to YansWifiPhy.
      */
     typedef std::vector<Ptr<YansWifiPhy>> PhyList;
 
+    /**
+     * Find the PHYs which may be within MaxRange of a position, and update
+     * the spatial index of the PHYs first if needed.
+     *
+     * \param position the position of the sender
+     * \param [out] ids the indexes of the PHYs in m_phyList, in increasing order
+     */
+    void FindReceivers(const Vector& position, std::vector<uint32_t>& ids) const;
+
     /**
      * This method is scheduled by Send for each associated YansWifiPhy.
      * The method then calls the corresponding YansWifiPhy that the first
@@ -116,6 +149,13 @@ class YansWifiChannel : public Channel
     PhyList m_phyList;                  //!< List of YansWifiPhys connected to this YansWifiChannel
     Ptr<PropagationLossModel> m_loss;   //!< Propagation loss model
     Ptr<PropagationDelayModel> m_delay; //!< Propagation delay model
+    double m_maxRange;                  //!< Distance beyond which the PHYs are skipped, or 0
+    double m_maxLossDb;                 //!< Loss beyond which the PHYs are skipped, in dB
+
+    /// Spatial index of the PHYs, built at the first transmission with a MaxRange
+    mutable std::unique_ptr<SpatialGridIndex> m_index;
+    /// Protect the spatial index against the transmissions of parallel simulations
+    mutable std::mutex m_indexMutex;
 };
 
 } // namespace ns3
@@ -0,0 +1,181 @@
+#include "ns3/core-module.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace ns3;
+
+/** Log to std::cout */
+#define LOG(x) std::cout << x << std::endl
+
+/** Clock used to measure the latency of the events. */
+using BenchClock = std::chrono::steady_clock;
+
+/**
+ * Benchmark of the events scheduled from other threads.
+ *
+ * Several producer threads call Simulator::ScheduleWithContext(), as fast
+ * as they can or at a fixed rate, while the simulator runs a periodic event. Each event
+ * carries the wall clock time at which it was scheduled, to measure the
+ * latency until the simulator runs it.
+ */
+class ContextEventsBench
+{
+  public:
+    /**
+     * Constructor.
+     * \param [in] threads The number of producer threads.
+     * \param [in] events The number of events scheduled by each thread.
+     * \param [in] rate The rate of the events of each thread, per second,
+     *             or 0 to schedule them as fast as possible.
+     */
+    ContextEventsBench(uint32_t threads, uint64_t events, double rate)
+        : m_threads(threads),
+          m_events(events),
+          m_rate(rate)
+    {
+    }
+
+    /** Run the benchmark once and log the results. */
+    void Run();
+
+  private:
+    /** Start the producer threads, from the simulation. */
+    void Start();
+    /** Periodic event, which keeps the simulation running. */
+    void Tick();
+    /**
+     * Body of a producer thread.
+     * \param [in] context The context of the events of the thread.
+     */
+    void Produce(uint32_t context);
+    /**
+     * Event scheduled by the producers.
+     * \param [in] sent The wall clock time when the event was scheduled, in ns.
+     */
+    void Receive(int64_t sent);
+
+    uint32_t m_threads;                 //!< Number of producer threads
+    uint64_t m_events;                  //!< Number of events per thread
+    double m_rate;                      //!< Rate of the events of each thread, 0 for no limit
+    std::vector<std::thread> m_workers; //!< Producer threads
+    std::atomic<bool> m_go{false};      //!< Whether the producers can start
+    std::vector<int64_t> m_latencies;   //!< Latency of every event, in ns
+    BenchClock::time_point m_start;     //!< Time when the producers started
+    BenchClock::time_point m_end;       //!< Time when the last event ran
+};
+
+void
+ContextEventsBench::Run()
+{
+    m_latencies.clear();
+    m_latencies.reserve(m_threads * m_events);
+    m_go = false;
+
+    Simulator::Schedule(Seconds(0), &ContextEventsBench::Start, this);
+    Simulator::Schedule(NanoSeconds(1), &ContextEventsBench::Tick, this);
+    Simulator::Run();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+    m_workers.clear();
+    Simulator::Destroy();
+
+    double seconds = std::chrono::duration<double>(m_end - m_start).count();
+    std::sort(m_latencies.begin(), m_latencies.end());
+    auto percentile = [this](double p) {
+        return m_latencies[std::min<std::size_t>(m_latencies.size() * p, m_latencies.size() - 1)] /
+               1000.0;
+    };
+    LOG(std::left << std::setw(10) << m_threads << std::setw(14) << m_latencies.size()
+                  << std::setw(14) << m_latencies.size() / seconds << std::setw(14)
+                  << percentile(0.5) << std::setw(14) << percentile(0.99) << percentile(1.0));
+}
+
+void
+ContextEventsBench::Start()
+{
+    for (uint32_t i = 0; i < m_threads; i++)
+    {
+        m_workers.emplace_back(&ContextEventsBench::Produce, this, i + 1);
+    }
+    m_start = BenchClock::now();
+    m_go = true;
+}
+
+void
+ContextEventsBench::Tick()
+{
+    Simulator::Schedule(NanoSeconds(1), &ContextEventsBench::Tick, this);
+}
+
+void
+ContextEventsBench::Produce(uint32_t context)
+{
+    while (!m_go)
+    {
+        std::this_thread::yield();
+    }
+    auto start = BenchClock::now();
+    for (uint64_t i = 0; i < m_events; i++)
+    {
+        if (m_rate > 0)
+        {
+            std::this_thread::sleep_until(start + std::chrono::duration<double>(i / m_rate));
+        }
+        int64_t sent = BenchClock::now().time_since_epoch().count();
+        Simulator::ScheduleWithContext(context, Seconds(0), &ContextEventsBench::Receive, this, sent);
+    }
+}
+
+void
+ContextEventsBench::Receive(int64_t sent)
+{
+    auto now = BenchClock::now();
+    m_latencies.push_back(now.time_since_epoch().count() - sent);
+    if (m_latencies.size() == m_threads * m_events)
+    {
+        m_end = now;
+        Simulator::Stop();
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t threads = 4;
+    uint64_t events = 100000;
+    uint32_t runs = 1;
+    double rate = 0;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the events scheduled with Simulator::ScheduleWithContext()\n"
+              "from other threads than the simulator thread.\n"
+              "\n"
+              "The rate is the number of events per second of wall clock time,\n"
+              "the latencies go from the call in the producer thread to the\n"
+              "execution of the event by the simulator. Without a rate limit,\n"
+              "the producers usually outpace the simulator, and the latencies\n"
+              "measure the backlog.");
+    cmd.AddValue("threads", "number of producer threads", threads);
+    cmd.AddValue("events", "number of events scheduled by each thread", events);
+    cmd.AddValue("rate", "events per second of each thread, 0 for no limit", rate);
+    cmd.AddValue("runs", "number of runs", runs);
+    cmd.Parse(argc, argv);
+
+    LOG(std::left << std::setw(10) << "Threads" << std::setw(14) << "Events" << std::setw(14)
+                  << "Rate (ev/s)" << std::setw(14) << "p50 (us)" << std::setw(14) << "p99 (us)"
+                  << "Max (us)");
+    ContextEventsBench bench(threads, events, rate);
+    for (uint32_t i = 0; i < runs; i++)
+    {
+        bench.Run();
+    }
+    return 0;
+}
@@ -0,0 +1,240 @@
+// This program benchmarks the computation of the reception status of the
+// MPDUs of A-MPDUs by the InterferenceHelper, with some interference.
+// Sample usage:  ./ns3 run 'bench-interference --mpdus=64 --interferers=4'
+
+#include "ns3/command-line.h"
+#include "ns3/ht-phy.h"
+#include "ns3/ht-ppdu.h"
+#include "ns3/interference-helper.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/table-based-error-rate-model.h"
+#include "ns3/wifi-mpdu.h"
+#include "ns3/wifi-phy-operating-channel.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/wifi-spectrum-value-helper.h"
+#include "ns3/wifi-utils.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+
+/** Log to std::cout */
+#define LOG(x) std::cout << x << std::endl
+
+/**
+ * Benchmark of the reception of A-MPDUs.
+ *
+ * The A-MPDUs are received one after the other, each with some shorter
+ * signals from other transmitters which start during its payload. As a
+ * PHY does, the PER of each MPDU is computed at its end, and the SNR of
+ * the PPDU at the end of the PPDU.
+ */
+class InterferenceBench
+{
+  public:
+    /**
+     * Constructor.
+     * \param [in] mpdus The number of MPDUs in each A-MPDU.
+     * \param [in] interferers The number of interfering signals during each A-MPDU.
+     * \param [in] errorRateModel The error rate model.
+     */
+    InterferenceBench(uint32_t mpdus, uint32_t interferers, Ptr<ErrorRateModel> errorRateModel);
+
+    /**
+     * Receive A-MPDUs and log the results.
+     * \param [in] ppdus The number of A-MPDUs.
+     */
+    void Run(uint32_t ppdus);
+
+  private:
+    /** Start the reception of an A-MPDU. */
+    void StartRx();
+    /** Start an interfering signal. */
+    void StartInterference();
+    /**
+     * End of an MPDU of the A-MPDU.
+     * \param [in] window The start and end of the MPDU, relative to the start of the payload.
+     */
+    void EndOfMpdu(std::pair<Time, Time> window);
+    /** End of the reception of the A-MPDU. */
+    void EndRx();
+
+    Ptr<InterferenceHelper> m_interference;       //!< The interference helper
+    WifiSpectrumBandInfo m_band;                  //!< The band of the signals
+    WifiPhyOperatingChannel m_channel;            //!< The operating channel
+    WifiTxVector m_txVector;                      //!< The TXVECTOR of the A-MPDUs
+    Ptr<WifiPsdu> m_psdu;                         //!< The A-MPDU
+    Time m_duration;                              //!< The duration of the PPDUs
+    std::vector<std::pair<Time, Time>> m_windows; //!< The MPDUs of the A-MPDU
+    uint32_t m_interferers;                       //!< Interfering signals during each A-MPDU
+    uint32_t m_ppdus{0};                          //!< The A-MPDUs left to receive
+    Ptr<Event> m_event;                           //!< The event of the A-MPDU being received
+    uint64_t m_received{0};                       //!< Number of MPDUs received
+};
+
+InterferenceBench::InterferenceBench(uint32_t mpdus,
+                                     uint32_t interferers,
+                                     Ptr<ErrorRateModel> errorRateModel)
+    : m_band({{0, 0}, {0, 0}}),
+      m_interferers(interferers)
+{
+    m_interference = CreateObject<InterferenceHelper>();
+    m_interference->SetNoiseFigure(DbToRatio(7));
+    m_interference->SetErrorRateModel(errorRateModel);
+    m_interference->AddBand(m_band);
+
+    m_channel.SetDefault(20, WIFI_STANDARD_80211n, WIFI_PHY_BAND_5GHZ);
+    m_txVector.SetMode(HtPhy::GetHtMcs7());
+    m_txVector.SetPreambleType(WIFI_PREAMBLE_HT_MF);
+    m_txVector.SetChannelWidth(20);
+    m_txVector.SetNss(1);
+    m_txVector.SetAggregation(true);
+
+    WifiMacHeader hdr;
+    hdr.SetType(WIFI_MAC_QOSDATA);
+    hdr.SetQosTid(0);
+    std::vector<Ptr<WifiMpdu>> mpduList;
+    // short MPDUs, for an A-MPDU of 64 MPDUs to fit in the longest HT PPDU
+    for (uint32_t i = 0; i < mpdus; i++)
+    {
+        mpduList.push_back(Create<WifiMpdu>(Create<Packet>(400), hdr));
+    }
+    m_psdu = Create<WifiPsdu>(mpduList);
+    m_duration = WifiPhy::CalculateTxDuration(m_psdu->GetSize(), m_txVector, WIFI_PHY_BAND_5GHZ);
+
+    // the same MPDU durations as PhyEntity::ScheduleEndOfMpdus
+    uint32_t totalAmpduSize = 0;
+    double totalAmpduNumSymbols = 0.0;
+    Time start;
+    for (uint32_t i = 0; i < mpdus; i++)
+    {
+        MpduType type = (i == 0)           ? FIRST_MPDU_IN_AGGREGATE
+                        : (i == mpdus - 1) ? LAST_MPDU_IN_AGGREGATE
+                                           : MIDDLE_MPDU_IN_AGGREGATE;
+        Time duration = WifiPhy::GetPayloadDuration(m_psdu->GetAmpduSubframeSize(i),
+                                                    m_txVector,
+                                                    WIFI_PHY_BAND_5GHZ,
+                                                    type,
+                                                    true,
+                                                    totalAmpduSize,
+                                                    totalAmpduNumSymbols,
+                                                    SU_STA_ID);
+        m_windows.emplace_back(start, start + duration);
+        start += duration;
+    }
+}
+
+void
+InterferenceBench::Run(uint32_t ppdus)
+{
+    m_ppdus = ppdus;
+    m_received = 0;
+    Simulator::Schedule(MicroSeconds(1), &InterferenceBench::StartRx, this);
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+    LOG(std::left << std::setw(10) << m_windows.size() << std::setw(14) << m_interferers
+                  << std::setw(14) << ppdus << std::setw(14) << seconds.count() * 1e6 / ppdus
+                  << static_cast<double>(m_received) / ppdus);
+}
+
+void
+InterferenceBench::StartRx()
+{
+    RxPowerWattPerChannelBand rxPower{{m_band, DbmToW(-60)}};
+    auto ppdu = Create<HtPpdu>(m_psdu, m_txVector, m_channel, m_duration, m_ppdus);
+    m_event = m_interference->Add(ppdu, m_duration, rxPower);
+    m_interference->NotifyRxStart();
+
+    Time payloadStart = WifiPhy::CalculatePhyPreambleAndHeaderDuration(m_txVector);
+    for (const auto& window : m_windows)
+    {
+        Simulator::Schedule(payloadStart + window.second,
+                            &InterferenceBench::EndOfMpdu,
+                            this,
+                            window);
+    }
+    // the interfering signals start at regular intervals during the payload
+    Time interval = (m_duration - payloadStart) / static_cast<int64_t>(m_interferers + 1);
+    for (uint32_t i = 1; i <= m_interferers; i++)
+    {
+        Simulator::Schedule(payloadStart + interval * static_cast<int64_t>(i),
+                            &InterferenceBench::StartInterference,
+                            this);
+    }
+    Simulator::Schedule(m_duration, &InterferenceBench::EndRx, this);
+}
+
+void
+InterferenceBench::StartInterference()
+{
+    RxPowerWattPerChannelBand rxPower{{m_band, DbmToW(-80)}};
+    m_interference->AddForeignSignal(MicroSeconds(100), rxPower);
+}
+
+void
+InterferenceBench::EndOfMpdu(std::pair<Time, Time> window)
+{
+    auto snrPer = m_interference->CalculatePayloadSnrPer(m_event, 20, m_band, SU_STA_ID, window);
+    if (snrPer.per < 0.5)
+    {
+        m_received++;
+    }
+}
+
+void
+InterferenceBench::EndRx()
+{
+    m_interference->CalculateSnr(m_event, 20, 1, m_band);
+    m_interference->NotifyRxEnd(Simulator::Now(), WHOLE_WIFI_SPECTRUM);
+    m_event = nullptr;
+    if (--m_ppdus > 0)
+    {
+        // leave the medium idle until the end of the interfering signals
+        Simulator::Schedule(MicroSeconds(200), &InterferenceBench::StartRx, this);
+    }
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t mpdus = 64;
+    uint32_t interferers = 4;
+    uint32_t ppdus = 2000;
+    std::string errorRateModel = "nist";
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the computation of the PER of the MPDUs of A-MPDUs\n"
+              "by the InterferenceHelper, with some interfering signals.\n"
+              "\n"
+              "The cost is the wall clock time per A-MPDU, the last column\n"
+              "the average number of MPDUs received in each A-MPDU.");
+    cmd.AddValue("mpdus", "number of MPDUs in each A-MPDU", mpdus);
+    cmd.AddValue("interferers", "number of interfering signals during each A-MPDU", interferers);
+    cmd.AddValue("ppdus", "number of A-MPDUs", ppdus);
+    cmd.AddValue("errorRateModel", "error rate model: nist or table", errorRateModel);
+    cmd.Parse(argc, argv);
+
+    Ptr<ErrorRateModel> model;
+    if (errorRateModel == "table")
+    {
+        model = CreateObject<TableBasedErrorRateModel>();
+    }
+    else
+    {
+        model = CreateObject<NistErrorRateModel>();
+    }
+
+    LOG(std::left << std::setw(10) << "MPDUs" << std::setw(14) << "Interferers" << std::setw(14)
+                  << "A-MPDUs" << std::setw(14) << "Cost (us)"
+                  << "MPDUs received");
+    InterferenceBench bench(mpdus, interferers, model);
+    bench.Run(ppdus);
+    Simulator::Destroy();
+    return 0;
+}
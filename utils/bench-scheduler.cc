@@ -20,9 +20,11 @@
 #include "ns3/core-module.h"
 
 #include <cmath> // sqrt
+#include <cstdlib>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <new>
 #include <string.h>
 #include <vector>
 
@@ -47,6 +49,46 @@ std::string g_me;
 /** Output field width for numeric data. */
 int g_fwidth = 6;
 
+/** Number of calls to the global operator new, to count the allocations per event. */
+uint64_t g_allocations = 0;
+
+/**
+ * Count the allocations, forwarding to malloc().
+ * \param [in] size The number of bytes to allocate.
+ * \returns The allocated memory.
+ */
+void*
+operator new(std::size_t size)
+{
+    ++g_allocations;
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+/**
+ * Release memory allocated by operator new().
+ * \param [in] p The memory to release.
+ */
+void
+operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+/**
+ * Release memory allocated by operator new().
+ * \param [in] p The memory to release.
+ */
+void
+operator delete(void* p, std::size_t /* size */) noexcept
+{
+    std::free(p);
+}
+
 /**
  *  Benchmark instance which can do a single run.
  *
@@ -70,6 +112,16 @@ class Bench
     {
     }
 
+    /**
+     * Set the scheduler used by every run.
+     *
+     * \param [in] factory Factory pre-configured to create the desired Scheduler.
+     */
+    void SetScheduler(const ObjectFactory& factory)
+    {
+        m_factory = factory;
+    }
+
     /**
      * Set the event delay interval random stream.
      *
@@ -103,10 +155,12 @@ class Bench
     /** The output. */
     struct Result
     {
-        double init;     /**< Time (s) for initialization. */
-        double simu;     /**< Time (s) for simulation. */
-        uint64_t pop;    /**< Event population. */
-        uint64_t events; /**< Number of events executed. */
+        double init;         /**< Time (s) for initialization. */
+        double simu;         /**< Time (s) for simulation. */
+        uint64_t pop;        /**< Event population. */
+        uint64_t events;     /**< Number of events executed. */
+        uint64_t initAllocs; /**< Number of allocations during initialization. */
+        uint64_t simuAllocs; /**< Number of allocations during simulation. */
     };
 
     /**
@@ -123,6 +177,7 @@ class Bench
      */
     void Cb();
 
+    ObjectFactory m_factory;          /**< Factory of the scheduler. */
     Ptr<RandomVariableStream> m_rand; /**< Stream for event delays. */
     uint64_t m_population;            /**< Event population size. */
     uint64_t m_total;                 /**< Total number of events to execute. */
@@ -136,10 +191,15 @@ Bench::Run()
     SystemWallClockMs timer;
     double init;
     double simu;
+    uint64_t initAllocs;
+    uint64_t simuAllocs;
 
     DEB("initializing");
     m_count = 0;
+    // the scheduler is reset by Simulator::Destroy() after each run
+    Simulator::SetScheduler(m_factory);
 
+    initAllocs = g_allocations;
     timer.Start();
     for (uint64_t i = 0; i < m_population; ++i)
     {
@@ -147,17 +207,20 @@ Bench::Run()
         Simulator::Schedule(at, &Bench::Cb, this);
     }
     init = timer.End() / 1000.0;
+    initAllocs = g_allocations - initAllocs;
     DEB("initialization took " << init << "s");
 
     DEB("running");
+    simuAllocs = g_allocations;
     timer.Start();
     Simulator::Run();
     simu = timer.End() / 1000.0;
+    simuAllocs = g_allocations - simuAllocs;
     DEB("run took " << simu << "s");
 
     Simulator::Destroy();
 
-    return Result{init, simu, m_population, m_count};
+    return Result{init, simu, m_population, m_count, initAllocs, simuAllocs};
 }
 
 void
@@ -214,6 +277,7 @@ class BenchSuite
         double time;   /**< Phase run time time (s). */
         double rate;   /**< Phase event rate (events/s). */
         double period; /**< Phase period (s/event). */
+        double allocs; /**< Phase allocations per event. */
     };
 
     /** Results from initialization and execution of a single run. */
@@ -248,8 +312,11 @@ class BenchSuite
 BenchSuite::Result
 BenchSuite::Result::Bench(Bench::Result r)
 {
-    return Result{{r.init, r.pop / r.init, r.init / r.pop},
-                  {r.simu, r.events / r.simu, r.simu / r.events}};
+    return Result{{r.init, r.pop / r.init, r.init / r.pop, double(r.initAllocs) / r.pop},
+                  {r.simu,
+                   r.events / r.simu,
+                   r.simu / r.events,
+                   double(r.simuAllocs) / r.events}};
 }
 
 template <typename T>
@@ -260,8 +327,9 @@ BenchSuite::Result::Log(T label) const
 
     LOG(std::left << std::setw(g_fwidth) << label << std::setw(g_fwidth) << init.time
                   << std::setw(g_fwidth) << init.rate << std::setw(g_fwidth) << init.period
-                  << std::setw(g_fwidth) << run.time << std::setw(g_fwidth) << run.rate
-                  << std::setw(g_fwidth) << run.period);
+                  << std::setw(g_fwidth) << init.allocs << std::setw(g_fwidth) << run.time
+                  << std::setw(g_fwidth) << run.rate << std::setw(g_fwidth) << run.period
+                  << std::setw(g_fwidth) << run.allocs);
 }
 
 BenchSuite::BenchSuite(ObjectFactory& factory,
@@ -271,8 +339,6 @@ BenchSuite::BenchSuite(ObjectFactory& factory,
                        Ptr<RandomVariableStream> eventStream,
                        bool calRev)
 {
-    Simulator::SetScheduler(factory);
-
     m_scheduler = factory.GetTypeId().GetName();
     if (m_scheduler == "ns3::CalendarScheduler")
     {
@@ -284,6 +350,7 @@ BenchSuite::BenchSuite(ObjectFactory& factory,
     }
 
     Bench bench(pop, total);
+    bench.SetScheduler(factory);
     bench.SetRandomStream(eventStream);
     bench.SetPopulation(pop);
     bench.SetTotal(total);
@@ -314,18 +381,21 @@ BenchSuite::Header() const
     // table header
     LOG("");
     LOG(m_scheduler);
-    LOG(std::left << std::setw(g_fwidth) << "Run #" << std::left << std::setw(3 * g_fwidth)
+    LOG(std::left << std::setw(g_fwidth) << "Run #" << std::left << std::setw(4 * g_fwidth)
                   << "Initialization:" << std::left << "Simulation:");
     LOG(std::left << std::setw(g_fwidth) << "" << std::left << std::setw(g_fwidth) << "Time (s)"
                   << std::left << std::setw(g_fwidth) << "Rate (ev/s)" << std::left
                   << std::setw(g_fwidth) << "Per (s/ev)" << std::left << std::setw(g_fwidth)
-                  << "Time (s)" << std::left << std::setw(g_fwidth) << "Rate (ev/s)" << std::left
-                  << "Per (s/ev)");
+                  << "Allocs/ev" << std::left << std::setw(g_fwidth) << "Time (s)" << std::left
+                  << std::setw(g_fwidth) << "Rate (ev/s)" << std::left << std::setw(g_fwidth)
+                  << "Per (s/ev)" << std::left << "Allocs/ev");
     LOG(std::setfill('-') << std::right << std::setw(g_fwidth) << " " << std::right
                           << std::setw(g_fwidth) << " " << std::right << std::setw(g_fwidth) << " "
                           << std::right << std::setw(g_fwidth) << " " << std::right
                           << std::setw(g_fwidth) << " " << std::right << std::setw(g_fwidth) << " "
-                          << std::right << std::setw(g_fwidth) << " " << std::setfill(' '));
+                          << std::right << std::setw(g_fwidth) << " " << std::right
+                          << std::setw(g_fwidth) << " " << std::right << std::setw(g_fwidth) << " "
+                          << std::setfill(' '));
 }
 
 void
@@ -345,8 +415,8 @@ BenchSuite::Log() const
 
     uint64_t n{0};                // number of samples
     Result average{m_results[0]}; // average
-    Result moment2{{0, 0, 0},     // 2nd moment, to calculate stdev
-                   {0, 0, 0}};
+    Result moment2{{0, 0, 0, 0},  // 2nd moment, to calculate stdev
+                   {0, 0, 0, 0}};
 
     for (; n < m_results.size(); ++n)
     {
@@ -364,9 +434,11 @@ BenchSuite::Log() const
         ACCUMULATE(init, time);
         ACCUMULATE(init, rate);
         ACCUMULATE(init, period);
+        ACCUMULATE(init, allocs);
         ACCUMULATE(run, time);
         ACCUMULATE(run, rate);
         ACCUMULATE(run, period);
+        ACCUMULATE(run, allocs);
 
 #undef ACCUMULATE
     }
@@ -374,10 +446,12 @@ BenchSuite::Log() const
     auto stdev = Result{
         {std::sqrt(moment2.init.time / n),
          std::sqrt(moment2.init.rate / n),
-         std::sqrt(moment2.init.period / n)},
+         std::sqrt(moment2.init.period / n),
+         std::sqrt(moment2.init.allocs / n)},
         {std::sqrt(moment2.run.time / n),
          std::sqrt(moment2.run.rate / n),
-         std::sqrt(moment2.run.period / n)},
+         std::sqrt(moment2.run.period / n),
+         std::sqrt(moment2.run.allocs / n)},
     };
 
     average.Log("average");
@@ -460,6 +534,7 @@ main(int argc, char* argv[])
     bool schedList = false;
     bool schedMap = false; // default scheduler
     bool schedPQ = false;
+    bool schedQuad = false;
 
     uint64_t pop = 100000;
     uint64_t total = 1000000;
@@ -477,6 +552,9 @@ main(int argc, char* argv[])
               "In the case of either --file form, the input is expected\n"
               "to be ascii, giving the relative event times in ns.\n"
               "\n"
+              "The allocations per event count the calls to the global\n"
+              "operator new during each phase.\n"
+              "\n"
               "If no scheduler is specified the MapScheduler will be run.");
     cmd.AddValue("all", "use all schedulers", allSched);
     cmd.AddValue("cal", "use CalendarSheduler", schedCal);
@@ -485,6 +563,7 @@ main(int argc, char* argv[])
     cmd.AddValue("list", "use ListSheduler", schedList);
     cmd.AddValue("map", "use MapScheduler (default)", schedMap);
     cmd.AddValue("pri", "use PriorityQueue", schedPQ);
+    cmd.AddValue("quad", "use QuadHeapScheduler", schedQuad);
     cmd.AddValue("debug", "enable debugging output", g_debug);
     cmd.AddValue("pop", "event population size", pop);
     cmd.AddValue("total", "total number of events to run", total);
@@ -505,10 +584,10 @@ main(int argc, char* argv[])
 
     if (allSched)
     {
-        schedCal = schedHeap = schedList = schedMap = schedPQ = true;
+        schedCal = schedHeap = schedList = schedMap = schedPQ = schedQuad = true;
     }
     // Set the default case if nothing else is set
-    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ))
+    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ || schedQuad))
     {
         schedMap = true;
     }
@@ -553,6 +632,11 @@ main(int argc, char* argv[])
         factory.SetTypeId("ns3::PriorityQueueScheduler");
         BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
     }
+    if (schedQuad)
+    {
+        factory.SetTypeId("ns3::QuadHeapScheduler");
+        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+    }
 
     return 0;
 }
@@ -0,0 +1,179 @@
+// This program benchmarks the scoreboard of the TcpTxBuffer during the loss
+// recovery of large windows, with SACK.
+// Sample usage:  ./ns3 run 'bench-tcp-tx-buffer --window=10000 --lossInterval=100'
+
+#include "ns3/command-line.h"
+#include "ns3/packet.h"
+#include "ns3/tcp-option-sack.h"
+#include "ns3/tcp-tx-buffer.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+
+/** Log to std::cout */
+#define LOG(x) std::cout << x << std::endl
+
+/**
+ * Benchmark of the TcpTxBuffer scoreboard.
+ *
+ * At each round, a window of segments is sent, and every lossInterval-th
+ * segment is lost. The receiver acknowledges each segment it receives with
+ * the SACK blocks of the last three runs of segments it received, as a
+ * receiver does. At each ACK the scoreboard is updated, and the lost
+ * segment returned by NextSeg, if any, is retransmitted, as TcpSocketBase
+ * does during the recovery. At the end of the round, the whole window is
+ * acknowledged.
+ */
+class TcpTxBufferBench
+{
+  public:
+    /**
+     * Constructor.
+     * \param [in] window The number of segments sent in each round.
+     * \param [in] lossInterval The interval between two lost segments.
+     */
+    TcpTxBufferBench(uint32_t window, uint32_t lossInterval);
+
+    /**
+     * Run the rounds and log the results.
+     * \param [in] rounds The number of rounds.
+     */
+    void Run(uint32_t rounds);
+
+  private:
+    /** Send a window, receive the ACKs and acknowledge the window. */
+    void Round();
+
+    /**
+     * Receive a SACK and retransmit a segment, if any.
+     * \param [in] list The SACK blocks.
+     */
+    void ReceiveSack(const TcpOptionSack::SackList& list);
+
+    static constexpr uint32_t SEGMENT_SIZE = 1448; //!< The segment size
+
+    Ptr<TcpTxBuffer> m_buffer; //!< The buffer
+    uint32_t m_window;         //!< The number of segments in a window
+    uint32_t m_lossInterval;   //!< The interval between two lost segments
+    uint64_t m_acks{0};        //!< The number of ACKs received
+    uint64_t m_retransmits{0}; //!< The number of segments retransmitted
+};
+
+TcpTxBufferBench::TcpTxBufferBench(uint32_t window, uint32_t lossInterval)
+    : m_window(window),
+      m_lossInterval(lossInterval)
+{
+    m_buffer = CreateObject<TcpTxBuffer>(1);
+    m_buffer->SetMaxBufferSize(window * SEGMENT_SIZE);
+    m_buffer->SetSegmentSize(SEGMENT_SIZE);
+    m_buffer->SetDupAckThresh(3);
+    m_buffer->SetSackEnabled(true);
+    uint32_t rWnd = window * SEGMENT_SIZE;
+    m_buffer->SetRWndCallback(Callback<uint32_t>([rWnd]() { return rWnd; }));
+}
+
+void
+TcpTxBufferBench::Run(uint32_t rounds)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < rounds; i++)
+    {
+        Round();
+    }
+    std::chrono::duration<double> seconds = std::chrono::steady_clock::now() - start;
+    LOG(std::left << std::setw(10) << m_window << std::setw(14) << m_lossInterval << std::setw(14)
+                  << m_acks << std::setw(14) << seconds.count() * 1e9 / m_acks << m_retransmits);
+}
+
+void
+TcpTxBufferBench::Round()
+{
+    SequenceNumber32 head = m_buffer->HeadSequence();
+    m_buffer->Add(Create<Packet>(m_window * SEGMENT_SIZE));
+    for (uint32_t i = 0; i < m_window; i++)
+    {
+        m_buffer->CopyFromSequence(SEGMENT_SIZE, head + i * SEGMENT_SIZE);
+    }
+
+    // the runs of segments received between the losses, most recent first
+    TcpOptionSack::SackList runs;
+    bool hole = false;
+    for (uint32_t i = 0; i < m_window; i++)
+    {
+        SequenceNumber32 seq = head + i * SEGMENT_SIZE;
+        if (m_lossInterval > 0 && i % m_lossInterval == m_lossInterval / 2)
+        {
+            hole = true;
+            runs.emplace_front(seq + SEGMENT_SIZE, seq + SEGMENT_SIZE);
+            continue;
+        }
+        if (!hole)
+        {
+            // received in order, the cumulative ACK advances
+            m_buffer->DiscardUpTo(seq + SEGMENT_SIZE);
+            m_acks++;
+            continue;
+        }
+        runs.front().second = seq + SEGMENT_SIZE;
+        TcpOptionSack::SackList list;
+        for (const auto& run : runs)
+        {
+            if (run.first == run.second)
+            {
+                continue;
+            }
+            list.push_back(run);
+            if (list.size() == 3)
+            {
+                break;
+            }
+        }
+        ReceiveSack(list);
+    }
+    m_buffer->DiscardUpTo(head + m_window * SEGMENT_SIZE);
+    m_acks++;
+}
+
+void
+TcpTxBufferBench::ReceiveSack(const TcpOptionSack::SackList& list)
+{
+    m_acks++;
+    m_buffer->Update(list);
+    SequenceNumber32 seq;
+    SequenceNumber32 seqHigh;
+    // all the data was sent: NextSeg returns a lost segment, if any
+    if (m_buffer->NextSeg(&seq, &seqHigh, false))
+    {
+        m_buffer->CopyFromSequence(SEGMENT_SIZE, seq);
+        m_retransmits++;
+    }
+    m_buffer->BytesInFlight();
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t window = 10000;
+    uint32_t lossInterval = 100;
+    uint32_t rounds = 5;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the scoreboard of the TcpTxBuffer during the loss recovery\n"
+              "of large windows, with SACK.\n"
+              "\n"
+              "The cost is the wall clock time per ACK, in nanoseconds.");
+    cmd.AddValue("window", "number of segments in a window", window);
+    cmd.AddValue("lossInterval", "interval between two lost segments, 0 for no loss", lossInterval);
+    cmd.AddValue("rounds", "number of windows sent", rounds);
+    cmd.Parse(argc, argv);
+
+    LOG(std::left << std::setw(10) << "Window" << std::setw(14) << "LossInterval" << std::setw(14)
+                  << "ACKs" << std::setw(14) << "Cost (ns)"
+                  << "Retransmits");
+    TcpTxBufferBench bench(window, lossInterval);
+    bench.Run(rounds);
+    return 0;
+}